@@ -36,6 +36,7 @@ static Exec::RunTask<int> ClientTask(
         .executor = executor,
         .remoteHost = host,
         .remotePort = port,
+        .pooledReceive = true,
     }};
     client.Open(acceptor);
 
@@ -55,7 +56,7 @@ static Exec::RunTask<int> ClientTask(
         Log::Warn("server disconnected before sending a reply");
         co_return 1;
     }
-    std::string_view reply{reinterpret_cast<const char*>(payload->data()), payload->size()}; //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    std::string_view reply{reinterpret_cast<const char*>(payload->Data()), payload->Size()}; //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
     Log::Info("received message: '{}'", reply);
 
     // //TODO: await sent happened
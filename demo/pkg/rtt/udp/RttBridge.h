@@ -2,6 +2,7 @@
 #include "Rtt/Acceptor.h"
 #include "Rtt/Handler.h"
 #include "Rtt/Link.h"
+#include "Rtt/Packet.h"
 
 #include <exec/create.hpp>
 #include <cstddef>
@@ -10,7 +11,6 @@
 #include <optional>
 #include <queue>
 #include <stdexec/execution.hpp>
-#include <vector>
 
 namespace Demo
 {
@@ -25,7 +25,9 @@ namespace Demo
     {
         std::function<void(std::shared_ptr<Rtt::ILink>)> onLink;
 
-        using Msg = std::optional<std::vector<std::byte>>;
+        /// A received packet (kept without a copy under pooled receive), or
+        /// nullopt on disconnect.
+        using Msg = std::optional<Rtt::Packet>;
         std::function<void(Msg)> onMessage;
         std::queue<Msg> pending;
 
@@ -34,12 +36,12 @@ namespace Demo
         [[nodiscard]] Rtt::LinkHandler MakeHandler()
         {
             return {
-                .onReceived = [this](std::span<const std::byte> data) {
-                    Deliver(std::vector<std::byte>{data.begin(), data.end()});
-                },
                 .onDisconnected = [this]() {
                     Deliver(std::nullopt);
                 },
+                .onPacket = [this](const Rtt::Packet& packet) {
+                    Deliver(packet);
+                },
             };
         }
 
@@ -32,7 +32,8 @@ static Exec::RunTask<int> ServerTask(
     auto acceptor = std::make_shared<Demo::BridgeAcceptor>(bridge);
     Rtt::Udp::UdpServer server{{
         .executor = executor,
-        .localPort = port
+        .localPort = port,
+        .pooledReceive = true,
     }};
     server.Open(acceptor);
 
@@ -59,7 +60,7 @@ static Exec::RunTask<int> ServerTask(
             bridge->onLink = nullptr;
             continue;
         }
-        std::string_view msg{reinterpret_cast<const char*>(payload->data()), payload->size()}; //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        std::string_view msg{reinterpret_cast<const char*>(payload->Data()), payload->Size()}; //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
         Log::Info("received message: '{}'", msg);
 
         // //TODO: await sent happened
@@ -0,0 +1,28 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <limits>
+
+namespace Exec
+{
+    /// Per-call limit for a budgeted DrainQueue().
+    ///
+    /// The drain stops once it has run maxTasks operations or maxTime has
+    /// elapsed, whichever comes first; the rest stays queued for the next
+    /// frame. At least one operation runs per drain, so queued work always
+    /// progresses. The default budget is unlimited (a greedy drain).
+    ///
+    ///   ctx.DrainQueue({.maxTasks = 256, .maxTime = 2ms});
+    struct DrainBudget
+    {
+        using Duration = std::chrono::steady_clock::duration;
+
+        std::size_t maxTasks = std::numeric_limits<std::size_t>::max();
+        Duration maxTime = Duration::max(); // max(): no deadline
+
+        [[nodiscard]] constexpr bool IsUnlimited() const noexcept
+        {
+            return maxTasks == std::numeric_limits<std::size_t>::max() && maxTime == Duration::max();
+        }
+    };
+}
@@ -1,4 +1,6 @@
 #pragma once
+#include "DrainBudget.h"
+
 #include <stdexec/execution.hpp>
 
 #include <cstddef>
@@ -8,13 +10,16 @@ namespace Exec
     /// Concept for frame-oriented, single-threaded execution contexts.
     ///
     /// A LoopContext provides a P2300-compatible scheduler that enqueues work into
-    /// an internal queue, plus a manual drain operation to flush all pending work.
+    /// an internal queue, plus a manual drain operation to flush all pending work
+    /// (or, with a DrainBudget, as much of it as the budget allows).
     ///
     /// Satisfied by PureLoopContext and TimedLoopContext.
     template <class T>
-    concept LoopContext = requires(T& ctx) {
+    concept LoopContext = requires(T& ctx, const DrainBudget& budget) {
         { ctx.GetScheduler() } -> stdexec::scheduler;
         { ctx.DrainQueue() } -> std::convertible_to<std::size_t>;
+        { ctx.DrainQueue(budget) } -> std::convertible_to<std::size_t>;
+        { ctx.PendingCount() } -> std::convertible_to<std::size_t>;
     };
 
 }
@@ -0,0 +1,92 @@
+#include "PoolContext.h"
+
+#include <algorithm>
+
+namespace Exec
+{
+    namespace
+    {
+        // Worker the current thread runs, if any: lets it push to its own queue
+        thread_local const PoolContext* currentPool = nullptr;
+        thread_local std::size_t currentWorker = 0;
+    }
+
+    PoolContext::PoolContext(Options options, ITimerBackend* backend)
+        : _backend(backend)
+    {
+        auto threads = options.threads;
+        if (threads == 0) {
+            threads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+        }
+
+        // All queues exist before any worker starts stealing from them
+        _workers.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            _workers.push_back(std::make_unique<Worker>());
+        }
+        for (std::size_t i = 0; i < threads; ++i) {
+            _workers[i]->thread = std::jthread([this, i] { Run(i); });
+        }
+    }
+
+    PoolContext::~PoolContext()
+    {
+        _stopping.store(true, std::memory_order_relaxed);
+        _signal.fetch_add(1, std::memory_order_release);
+        _signal.notify_all();
+        for (auto& worker : _workers) {
+            worker->thread.join();
+        }
+    }
+
+    void PoolContext::Enqueue(OperationBase* task) noexcept
+    {
+        const auto index = currentPool == this
+            ? currentWorker
+            : _next.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+        _workers[index]->queue.enqueue(task);
+
+        _signal.fetch_add(1, std::memory_order_release);
+        _signal.notify_one();
+    }
+
+    void PoolContext::Run(std::size_t index)
+    {
+        currentPool = this;
+        currentWorker = index;
+
+        for (;;) {
+            if (auto* task = Take(index)) {
+                task->execute(task);
+                continue;
+            }
+
+            // Snapshot before looking again: a push after the snapshot changes
+            // _signal, so the wait below cannot miss it
+            const auto seen = _signal.load(std::memory_order_acquire);
+            if (auto* task = Take(index)) {
+                task->execute(task);
+                continue;
+            }
+            // Stop only once the queues are drained
+            if (_stopping.load(std::memory_order_relaxed)) {
+                break;
+            }
+            _signal.wait(seen, std::memory_order_acquire);
+        }
+
+        currentPool = nullptr;
+    }
+
+    OperationBase* PoolContext::Take(std::size_t index) noexcept
+    {
+        OperationBase* task{};
+        const auto count = _workers.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            if (_workers[(index + i) % count]->queue.try_dequeue(task)) {
+                return task;
+            }
+        }
+        return nullptr;
+    }
+}
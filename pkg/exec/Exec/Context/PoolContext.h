@@ -0,0 +1,220 @@
+#pragma once
+#include "OperationBase.h"
+#include "TimedOperation.h"
+#include "Exec/Delay/ITimerBackend.h"
+#include "concurrentqueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <exec/timed_scheduler.hpp>
+#include <stdexec/execution.hpp>
+
+namespace Exec
+{
+    /// Work-stealing thread pool: the multi-threaded companion of PureLoopContext.
+    ///
+    /// CPU-heavy steps (snapshot compression, pathfinding, ...) run on the pool
+    /// instead of blocking a frame, and the frame loop picks the result up again:
+    ///
+    ///     RunTask<int> MainTask(PoolContext::Scheduler pool)
+    ///     {
+    ///         // RunTask is sticky: it resumes on the loop once the pool is done
+    ///         auto path = co_await stdexec::starts_on(pool, stdexec::just(request) | stdexec::then(FindPath));
+    ///         ...
+    ///     }
+    ///
+    /// or, in a sender pipeline, `stdexec::continues_on(pool)` there and
+    /// `stdexec::continues_on(loopScheduler)` back.
+    ///
+    /// Each worker owns a lock-free queue. Work scheduled from a worker goes to
+    /// its own queue; work from other threads (the loop, timer callbacks) is
+    /// spread round-robin. An idle worker steals from the others before it
+    /// sleeps. Like PureLoopContext, operations are OperationBase nodes embedded
+    /// in their op state: scheduling allocates nothing.
+    ///
+    /// Timed scheduling (exec::schedule_after / schedule_at) arms nodes on a
+    /// separate, thread-safe ITimerBackend such as ThreadTimerBackend, held
+    /// through a non-owning pointer: the backend must outlive pending timed
+    /// operations. Workers call ScheduleNode() concurrently, so the loop's
+    /// single-threaded LoopTimerBackend cannot be used. When the deadline
+    /// passes, the completion runs on a worker.
+    ///
+    /// Destruction drains: queued operations still run (observing their stop
+    /// tokens), then the workers are joined.
+    class PoolContext
+    {
+        // forward-declared for Scheduler
+        struct Sender;
+        struct TimedSender;
+
+    public:
+        struct Options
+        {
+            /// Worker threads. 0: one per hardware thread, less one for the frame loop.
+            std::size_t threads = 0;
+        };
+
+        /// Lightweight scheduler handle satisfying both stdexec::scheduler and exec::timed_scheduler.
+        ///
+        ///   schedule()        — run on a worker as soon as one is free
+        ///   schedule_after()  — run on a worker after a given duration
+        ///   schedule_at()     — run on a worker at a specific steady_clock time point
+        ///   now()             — returns steady_clock::now()
+        struct Scheduler
+        {
+            using scheduler_concept = stdexec::scheduler_t;
+
+            PoolContext* ctx;
+
+            [[nodiscard]] auto now() const noexcept -> std::chrono::steady_clock::time_point
+            {
+                return std::chrono::steady_clock::now();
+            }
+
+            [[nodiscard]] auto schedule() const noexcept -> Sender;
+
+            [[nodiscard]] auto schedule_at(std::chrono::steady_clock::time_point tp) const noexcept
+                -> TimedSender;
+
+            [[nodiscard]] auto schedule_after(std::chrono::steady_clock::duration dur) const noexcept
+                -> TimedSender
+            {
+                return schedule_at(now() + dur);
+            }
+
+            auto operator==(const Scheduler&) const noexcept -> bool = default;
+        };
+
+        PoolContext(Options options, ITimerBackend* backend);
+        ~PoolContext();
+
+        PoolContext(const PoolContext&) = delete;
+        PoolContext& operator=(const PoolContext&) = delete;
+        PoolContext(PoolContext&&) = delete;
+        PoolContext& operator=(PoolContext&&) = delete;
+
+        [[nodiscard]] auto GetScheduler() noexcept -> Scheduler { return {this}; }
+
+        [[nodiscard]] std::size_t ThreadCount() const noexcept { return _workers.size(); }
+
+        /// Enqueue a task node from any thread (e.g. from a timer callback).
+        void Enqueue(OperationBase* task) noexcept;
+
+    private:
+        /// Operation state produced by Sender::connect(). Stop-token aware like
+        /// PureLoopContext's: set_stopped() if stop was requested by the time a
+        /// worker runs it.
+        template <class Receiver>
+        struct Operation : OperationBase
+        {
+            PoolContext* pool;
+            Receiver receiver;
+
+            Operation(PoolContext* p, Receiver rcvr)
+                : OperationBase{&Execute}
+                , pool(p)
+                , receiver(static_cast<Receiver&&>(rcvr))
+            {}
+
+            static void Execute(OperationBase* base) noexcept
+            {
+                auto& receiver = static_cast<Operation*>(base)->receiver;
+                const auto stopToken = stdexec::get_stop_token(stdexec::get_env(receiver));
+                if (stopToken.stop_requested()) {
+                    stdexec::set_stopped(static_cast<Receiver&&>(receiver));
+                } else {
+                    stdexec::set_value(static_cast<Receiver&&>(receiver));
+                }
+            }
+
+            void start() & noexcept { pool->Enqueue(this); }
+        };
+
+        /// Reports this pool's Scheduler as the completion scheduler, so that
+        /// continues_on / exec::task chaining can find it.
+        struct BaseSender
+        {
+            using sender_concept = stdexec::sender_t;
+            using completion_signatures = stdexec::completion_signatures<
+                stdexec::set_value_t(),
+                stdexec::set_stopped_t()
+            >;
+
+            PoolContext* ctx;
+
+            struct Env
+            {
+                PoolContext* ctx;
+
+                template <class CPO>
+                [[nodiscard]] auto query(stdexec::get_completion_scheduler_t<CPO> _) const noexcept
+                    -> Scheduler
+                {
+                    return {ctx};
+                }
+            };
+
+            [[nodiscard]] auto get_env() const noexcept -> Env { return {ctx}; }
+        };
+
+        /// Sender returned by Scheduler::schedule().
+        struct Sender : BaseSender
+        {
+            template <class Receiver>
+            auto connect(Receiver rcvr) const -> Operation<Receiver>
+            {
+                return {ctx, static_cast<Receiver&&>(rcvr)};
+            }
+        };
+
+        /// Sender returned by Scheduler::schedule_at(): a TimedOperation completing on the pool.
+        struct TimedSender : BaseSender
+        {
+            ITimerBackend::TimePoint deadline;
+
+            template <class Receiver>
+            auto connect(Receiver rcvr) const -> TimedOperation<Receiver, PoolContext>
+            {
+                return {ctx, ctx->_backend, deadline, static_cast<Receiver&&>(rcvr)};
+            }
+        };
+
+        struct Worker
+        {
+            moodycamel::ConcurrentQueue<OperationBase*> queue;
+            std::jthread thread;
+        };
+
+        void Run(std::size_t index);
+
+        /// Next task for worker `index`: its own queue first, then the others'.
+        [[nodiscard]] OperationBase* Take(std::size_t index) noexcept;
+
+        std::vector<std::unique_ptr<Worker>> _workers;
+        ITimerBackend* _backend; // non-owning; thread-safe, not the loop's
+
+        std::atomic<std::uint32_t> _signal{0}; // bumped on every push; idle workers wait on it
+        std::atomic<std::size_t> _next{0};     // round-robin target for pushes from outside
+        std::atomic<bool> _stopping{false};
+    };
+
+    // Out-of-line definitions: now that sender types are complete
+    inline auto PoolContext::Scheduler::schedule() const noexcept -> Sender
+    {
+        return {{ctx}};
+    }
+
+    inline auto PoolContext::Scheduler::schedule_at(std::chrono::steady_clock::time_point tp) const noexcept
+        -> TimedSender
+    {
+        return {{ctx}, tp};
+    }
+
+    static_assert(stdexec::scheduler<PoolContext::Scheduler>);
+    static_assert(exec::timed_scheduler<PoolContext::Scheduler>);
+}
@@ -147,6 +147,38 @@ namespace Exec
             return count;
         }
 
+        /// Drain within a budget: stop after budget.maxTasks tasks or once
+        /// budget.maxTime has elapsed, leaving the rest for the next call.
+        ///
+        /// Bounds frame time under bursts, and keeps work that re-enqueues
+        /// itself from spinning the frame. Returns the number of tasks executed.
+        std::size_t DrainQueue(const DrainBudget& budget)
+        {
+            if (budget.IsUnlimited()) {
+                return DrainQueue();
+            }
+
+            const bool timed = budget.maxTime != DrainBudget::Duration::max();
+            const auto deadline = timed
+                ? std::chrono::steady_clock::now() + budget.maxTime
+                : std::chrono::steady_clock::time_point::max();
+
+            std::size_t count = 0;
+            OperationBase* task{};
+            while (_queue.try_dequeue(task)) {
+                task->execute(task);
+                ++count;
+                if (count >= budget.maxTasks || (timed && std::chrono::steady_clock::now() >= deadline)) {
+                    break;
+                }
+            }
+            return count;
+        }
+
+        /// Approximate number of queued tasks: what a budgeted drain left
+        /// behind, plus anything enqueued since (possibly from other threads).
+        [[nodiscard]] std::size_t PendingCount() const noexcept { return _queue.size_approx(); }
+
         /// Enqueue a task node from outside the scheduler (e.g., from a timer callback).
         ///
         /// Prefer this over Push() for code in other translation units that hold a
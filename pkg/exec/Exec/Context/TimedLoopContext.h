@@ -153,6 +153,17 @@ namespace Exec
             return _loopContext.DrainQueue();
         }
 
+        /// Budgeted drain (see PureLoopContext::DrainQueue(const DrainBudget&)).
+        /// The backend still ticks once; operations its timers enqueue count
+        /// against the budget like any other.
+        std::size_t DrainQueue(const DrainBudget& budget)
+        {
+            _backend->Tick();
+            return _loopContext.DrainQueue(budget);
+        }
+
+        [[nodiscard]] std::size_t PendingCount() const noexcept { return _loopContext.PendingCount(); }
+
     private:
         PureLoopContext _loopContext;
         ITimerBackend* _backend; // non-owning; lifetime managed by caller (Domain)
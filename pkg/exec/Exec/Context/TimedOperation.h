@@ -10,8 +10,10 @@ namespace Exec
     /// Operation state for a timed delay.
     ///
     /// Inherits OperationBase so it can be enqueued directly into PureLoopContext's
-    /// lock-free queue. Contains the receiver, synchronisation flag, and ownership
-    /// of both the stop callback and timer registration — no heap allocation needed.
+    /// lock-free queue, and TimerNode so it registers with the backend itself
+    /// (ITimerBackend::ScheduleNode). Contains the receiver, synchronisation flag,
+    /// and ownership of both the stop callback and timer registration — no heap
+    /// allocation needed.
     ///
     /// Lifetime is guaranteed by P2300: the op state must remain alive until a
     /// completion signal (set_value / set_stopped) is delivered. Combined with
@@ -19,14 +21,20 @@ namespace Exec
     /// this means it is safe to destroy TimedOperation immediately after
     /// the completion signal returns.
     ///
-    /// Once start() is called, the stop callback and timer lambda both capture `this`.
+    /// Once start() is called, the stop callback and the backend both point at `this`.
     /// TimedOperation must NOT be moved after start() — it is immovable by design.
     ///
-    /// The `state` atomic is the single synchronisation point between the timer
-    /// and the stop side: whichever side raises it first prevents the other from
-    /// enqueuing this node a second time.
-    template <class Receiver>
-    struct TimedOperation : OperationBase
+    /// The `state` atomic is the single synchronisation point between start(),
+    /// the timer and the stop side: whichever of the timer and stop raises it
+    /// first prevents the other from enqueuing this node a second time. Until
+    /// start() has published Armed, neither of them enqueues: start() still
+    /// touches `this` and the backend may still be linking the node, so start()
+    /// itself cancels the node and enqueues the winner.
+    ///
+    /// `Context` is where the completion runs: any type with a noexcept
+    /// Enqueue(OperationBase*) (PureLoopContext, PoolContext).
+    template <class Receiver, class Context = PureLoopContext>
+    struct TimedOperation : OperationBase, TimerNode
     {
         using operation_state_concept = stdexec::operation_state_t;
 
@@ -45,21 +53,25 @@ namespace Exec
         };
         using StopRegistration = stdexec::stop_callback_for_t<StopToken, StopCallback>;
 
-        enum class State : std::uint8_t { Pending, TimerWon, StopWon };
+        enum class State : std::uint8_t
+        {
+            Starting, // start() has not finished scheduling the node
+            Armed,    // scheduled; the timer and stop race to complete
+            TimerWon,
+            StopWon,
+        };
 
-        PureLoopContext* scheduler;
+        Context* scheduler;
         ITimerBackend* backend;
-        ITimerBackend::TimePoint deadline;
         Receiver receiver;
-        std::atomic<State> state{State::Pending};
-        ITimerBackend::TimerId timerId{};
+        std::atomic<State> state{State::Starting};
         std::optional<StopRegistration> stopRegistration{};
 
-        TimedOperation(PureLoopContext* sched, ITimerBackend* be, ITimerBackend::TimePoint dl, Receiver rcvr)
+        TimedOperation(Context* sched, ITimerBackend* be, ITimerBackend::TimePoint dl, Receiver rcvr)
             : OperationBase{&Execute}
+            , TimerNode{.deadline = dl, .fire = &Fire}
             , scheduler(sched)
             , backend(be)
-            , deadline(dl)
             , receiver(std::move(rcvr))
         {}
 
@@ -68,14 +80,12 @@ namespace Exec
             // Deregister stop callback first — prevents a spurious CAS win from
             // racing with the Cancel call below.
             stopRegistration.reset();
-            // Cancel blocks until any in-flight timer callback has returned,
-            // so `this` is safe to destroy the moment Cancel() returns.
-            if (timerId) {
-                backend->Cancel(timerId);
-            }
+            // No timer cancel here: every completion path has already taken the
+            // node out of the backend (Fire() is the backend's last use of it,
+            // and the stop side or start() cancels it before enqueuing).
         }
 
-        // Immovable: lambdas registered in start() capture `this` by raw pointer.
+        // Immovable: the stop callback and the backend hold `this` by raw pointer.
         // Guaranteed copy elision (C++17) ensures connect() constructs the op state
         // directly in the caller's storage — no move is ever needed.
         TimedOperation(const TimedOperation&) = delete;
@@ -100,6 +110,22 @@ namespace Exec
             }
         }
 
+        static void Fire(TimerNode& node) noexcept
+        {
+            auto& self = static_cast<TimedOperation&>(node);
+            // Fired while start() is still scheduling: start() enqueues instead
+            State expected = State::Starting;
+            if (self.state.compare_exchange_strong(expected, State::TimerWon,
+                    std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return;
+            }
+            if (expected == State::Armed
+                && self.state.compare_exchange_strong(expected, State::TimerWon,
+                    std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                self.scheduler->Enqueue(&self); // last access to `self`
+            }
+        }
+
         void start() & noexcept
         {
             //TODO: `if constexpr (unstoppable_token<stop_token_of_t<env_of_t<Receiver>>>)` to avoid registering a stop callback at all in that case
@@ -107,36 +133,47 @@ namespace Exec
 
             // Register stop callback. If stop is already requested at this point,
             // stop_callback_for_t fires StopCallback synchronously during construction,
-            // winning the CAS and setting stopWon — no need to schedule the timer.
+            // which raises StopWon — no need to schedule the timer.
             stopRegistration.emplace(stopToken, StopCallback{this});
-            if (state.load(std::memory_order_relaxed) != State::Pending) {
+            if (state.load(std::memory_order_acquire) != State::Starting) {
+                scheduler->Enqueue(this);
                 return;
             }
 
-            // Schedule the timer. The lambda captures `this` by raw pointer — safe
-            // because ITimerBackend::Cancel() blocks until the callback completes,
+            // Schedule the timer node embedded in `this` — safe because
+            // ITimerBackend::CancelNode() blocks until Fire() completes,
             // guaranteeing `this` is alive for the callback's entire execution.
-            timerId = backend->ScheduleAt(deadline, [this]() {
-                timerId = ITimerBackend::InvalidTimerId; // prevent unnecessary cancel in destructor as already fired
-                TryEnqueue(State::TimerWon);
-            });
-        }
+            backend->ScheduleNode(*this);
 
-        void TryEnqueueStop()
-        {
-            // Cancel the timer eagerly when stop wins — 
-            //  avoids leaving a now-pointless entry in the backend
-            if (timerId) {
-                backend->Cancel(std::exchange(timerId, ITimerBackend::InvalidTimerId));
+            // Publish Armed; from here on the timer or stop side completes and
+            // `this` may be gone, so it must not be touched again
+            State expected = State::Starting;
+            if (state.compare_exchange_strong(expected, State::Armed,
+                    std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return;
             }
-            TryEnqueue(State::StopWon);
+
+            // Stop was requested or the timer fired meanwhile. Either way the
+            // node must be out of the backend (or done firing) before completion.
+            backend->CancelNode(*this);
+            scheduler->Enqueue(this);
         }
 
-        void TryEnqueue(State desired)
+        void TryEnqueueStop()
         {
-            State expected = State::Pending;
-            if (state.compare_exchange_strong(expected, desired,
+            // Stop during start(): start() cancels the timer and enqueues
+            State expected = State::Starting;
+            if (state.compare_exchange_strong(expected, State::StopWon,
+                    std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return;
+            }
+            if (expected == State::Armed
+                && state.compare_exchange_strong(expected, State::StopWon,
                     std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                // Cancel the timer eagerly when stop wins — avoids leaving a
+                // now-pointless entry in the backend, and waits out a Fire()
+                // in flight, which still refers to `this`
+                backend->CancelNode(*this);
                 scheduler->Enqueue(this);
             }
         }
@@ -2,9 +2,35 @@
 #include <chrono>
 #include <cstdint>
 #include <functional>
+#include <utility>
 
 namespace Exec
 {
+    /// Timer registration embedded in the object it times: the allocation-free
+    /// alternative to a ScheduleAt() callback (see ITimerBackend::ScheduleNode).
+    ///
+    /// The owner sets `deadline` and `fire`; the remaining fields belong to the
+    /// backend from ScheduleNode() until the node has fired or CancelNode() has
+    /// returned. The node must not move or be destroyed in between.
+    ///
+    /// Backends fill in the bookkeeping before the node can fire, and never
+    /// touch the node once fire() has been called. CancelNode() must be ordered
+    /// after ScheduleNode() has returned and not run concurrently with another
+    /// CancelNode() of the same node (TimedOperation hands it over through its
+    /// state word).
+    struct TimerNode
+    {
+        using Fire = void (*)(TimerNode& node) noexcept;
+
+        std::chrono::steady_clock::time_point deadline{};
+        Fire fire = nullptr;
+
+        // Backend bookkeeping
+        TimerNode* prev = nullptr;
+        TimerNode* next = nullptr;
+        std::uint64_t link = 0; // e.g. slot or heap position; 0 while not scheduled
+    };
+
     /// Abstract timer backend for the Delay sender.
     ///
     /// Implementations must fire the registered callback at or after the given
@@ -48,6 +74,30 @@ namespace Exec
         /// that the callback may access, immediately after Cancel() returns.
         virtual bool Cancel(TimerId id) noexcept = 0;
 
+        /// Schedule `node` to fire (node.fire(node)) at or after node.deadline.
+        ///
+        /// Same contract as ScheduleAt() with a callback, but the registration
+        /// lives in the node, so backends implementing it natively touch no
+        /// allocator. A node is scheduled at most once at a time.
+        ///
+        /// The default goes through ScheduleAt() with a pointer-sized lambda,
+        /// which std::function stores inline, and keeps the TimerId in node.link.
+        /// It stores the id after ScheduleAt() has returned, so it only suits
+        /// backends that fire on the scheduling thread (LoopTimerBackend);
+        /// thread-based backends override it.
+        virtual void ScheduleNode(TimerNode& node)
+        {
+            node.link = ScheduleAt(node.deadline, [&node] { node.fire(node); });
+        }
+
+        /// Cancel a node passed to ScheduleNode(). Same contract as Cancel():
+        /// returns true if removed before firing, and blocks while it is firing.
+        virtual bool CancelNode(TimerNode& node) noexcept
+        {
+            const TimerId id = std::exchange(node.link, InvalidTimerId);
+            return id != InvalidTimerId && Cancel(id);
+        }
+
         /// Called from the main/update thread each frame (before DrainQueue).
         ///
         /// Loop-integrated backends (LoopTimerBackend) override this to fire
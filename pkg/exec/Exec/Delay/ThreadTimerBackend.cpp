@@ -1,38 +1,111 @@
 #include "ThreadTimerBackend.h"
 
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
 namespace Exec
 {
+    namespace
+    {
+        constexpr std::uint64_t GenerationMask = 0xFFFF'FFFFu;
+    }
+
     ThreadTimerBackend::ThreadTimerBackend()
         : _thread([this] { RunTimerThread(); })
     {}
 
     ThreadTimerBackend::~ThreadTimerBackend()
     {
-        _stopping.store(true, std::memory_order_relaxed);
+        {
+            std::lock_guard lock{_mutex};
+            _stopping.store(true, std::memory_order_relaxed);
+        }
         _cv.notify_all();
-        // jthread destructor joins automatically.
+        // Join before the chunks go: the timer thread still refers to entries.
+        _thread.join();
+        for (auto& chunk : _chunks) {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
     }
 
     auto ThreadTimerBackend::ScheduleAt(TimePoint deadline, Callback callback) -> TimerId
     {
-        const TimerId id = _nextId.fetch_add(1, std::memory_order_relaxed);
+        return Arm(deadline, std::move(callback), nullptr);
+    }
+
+    void ThreadTimerBackend::ScheduleNode(TimerNode& node)
+    {
+        // Arm() records the id in node.link: once it returns the node may
+        // already have fired and be gone
+        Arm(node.deadline, {}, &node);
+    }
+
+    bool ThreadTimerBackend::CancelNode(TimerNode& node) noexcept
+    {
+        // The timer thread never touches node.link, and the caller orders
+        // CancelNode() after ScheduleNode() (see TimerNode)
+        return Cancel(std::exchange(node.link, InvalidTimerId));
+    }
+
+    auto ThreadTimerBackend::Arm(TimePoint deadline, Callback callback, TimerNode* node) -> TimerId
+    {
+        TimerId id = InvalidTimerId;
+        bool wake = false;
         {
             std::lock_guard lock{_mutex};
-            _active.insert(id);
-            _queue.push({deadline, id, std::move(callback)});
+            Compact();
+
+            auto& entry = Allocate();
+            entry.callback = std::move(callback);
+            entry.node = node;
+            const auto generation = entry.state.load(std::memory_order_relaxed) >> PhaseBits;
+            entry.state.store((generation << PhaseBits) | Armed, std::memory_order_relaxed);
+            id = (TimerId{generation} << 32) | (TimerId{entry.index} + 1);
+            if (node) {
+                node->link = id; // before the timer thread can see the entry
+            }
+
+            // The timer thread sleeps until the earliest deadline: only an
+            // earlier one needs to wake it
+            wake = _queue.empty() || deadline < _queue.front().deadline;
+            _queue.push_back({deadline, &entry});
+            std::push_heap(_queue.begin(), _queue.end(), std::greater<>{});
+        }
+        if (wake) {
+            _cv.notify_one();
         }
-        _cv.notify_one();
         return id;
     }
 
     bool ThreadTimerBackend::Cancel(TimerId id) noexcept
     {
-        std::unique_lock lock{_mutex};
-        // Block until any in-flight execution of this callback has finished.
-        // Invariant: once the callback exits, RunTimerThread clears _inflightId
-        // and notifies _doneCv — so this wait always terminates.
-        _doneCv.wait(lock, [this, id] { return _inflightId != id; });
-        return _active.erase(id) > 0;
+        auto* entry = Find(id);
+        if (!entry) {
+            return false;
+        }
+
+        // Fast path: disarm with one CAS. The timer thread recycles the entry.
+        // Count it first: once Cancelled is published, the timer thread may
+        // pop the entry and decrement before this thread would increment.
+        const auto generation = (id >> 32) << PhaseBits;
+        auto expected = generation | Armed;
+        _cancelled.fetch_add(1, std::memory_order_relaxed);
+        if (entry->state.compare_exchange_strong(expected, generation | Cancelled,
+                std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return true;
+        }
+        _cancelled.fetch_sub(1, std::memory_order_relaxed);
+
+        // Fired, cancelled or stale — unless the callback is running right now:
+        // then block until it has finished and the entry moved on.
+        const auto firing = generation | Firing;
+        while (expected == firing) {
+            entry->state.wait(firing, std::memory_order_acquire);
+            expected = entry->state.load(std::memory_order_acquire);
+        }
+        return false;
     }
 
     void ThreadTimerBackend::RunTimerThread()
@@ -46,36 +119,104 @@ namespace Exec
                 continue;
             }
 
-            const auto& top = _queue.top();
-            const auto deadline = top.deadline;
+            const auto deadline = _queue.front().deadline;
 
-            // Wait until the top deadline or until something changes (new entry, cancel, stop).
+            // Wait until the top deadline or until something changes (new earlier entry, stop).
             if (_cv.wait_until(lock, deadline) == std::cv_status::timeout
                 || std::chrono::steady_clock::now() >= deadline)
             {
-                // Pop entries that are due and still active.
-                while (!_queue.empty() && std::chrono::steady_clock::now() >= _queue.top().deadline) {
-                    auto entry = _queue.top(); // copy
-                    _queue.pop();
+                // Pop entries that are due; fire those still armed.
+                while (!_queue.empty() && std::chrono::steady_clock::now() >= _queue.front().deadline) {
+                    std::pop_heap(_queue.begin(), _queue.end(), std::greater<>{});
+                    auto& entry = *_queue.back().entry;
+                    _queue.pop_back();
 
-                    if (_active.erase(entry.id) == 0) {
-                        // Already cancelled — skip.
+                    // Claim the entry; a Cancel() that got there first wins.
+                    auto state = entry.state.load(std::memory_order_acquire);
+                    const auto generation = state & ~PhaseMask;
+                    if ((state & PhaseMask) != Armed
+                        || !entry.state.compare_exchange_strong(state, generation | Firing,
+                               std::memory_order_acq_rel, std::memory_order_acquire)) {
+                        _cancelled.fetch_sub(1, std::memory_order_relaxed);
+                        Recycle(entry);
                         continue;
                     }
 
-                    // Mark as in-flight so Cancel() can block until we finish.
-                    _inflightId = entry.id;
-
                     // Invoke callback with the lock released so the callback can
                     // safely call back into ScheduleAt/Cancel without deadlocking.
                     lock.unlock();
-                    entry.callback();
+                    if (entry.node) {
+                        entry.node->fire(*entry.node);
+                    } else {
+                        entry.callback();
+                    }
                     lock.lock();
 
-                    _inflightId = InvalidTimerId;
-                    _doneCv.notify_all();
+                    Recycle(entry);
+                    entry.state.notify_all(); // a Cancel() may be waiting out the call
                 }
             }
+            Compact();
+        }
+    }
+
+    auto ThreadTimerBackend::Find(TimerId id) const noexcept -> Entry*
+    {
+        if (id == InvalidTimerId) {
+            return nullptr;
+        }
+        const auto index = static_cast<std::size_t>((id & GenerationMask) - 1);
+        if ((index >> ChunkBits) >= MaxChunks) {
+            return nullptr;
+        }
+        auto* chunk = _chunks[index >> ChunkBits].load(std::memory_order_acquire);
+        return chunk ? &chunk[index & (ChunkSize - 1)] : nullptr;
+    }
+
+    auto ThreadTimerBackend::Allocate() -> Entry&
+    {
+        if (!_free) {
+            if (_chunkCount == MaxChunks) {
+                throw std::length_error("ThreadTimerBackend: too many pending timers");
+            }
+            auto* chunk = new Entry[ChunkSize];
+            for (std::size_t i = 0; i < ChunkSize; ++i) {
+                chunk[i].index = static_cast<std::uint32_t>(_chunkCount * ChunkSize + i);
+                chunk[i].nextFree = i + 1 < ChunkSize ? &chunk[i + 1] : nullptr;
+            }
+            _chunks[_chunkCount++].store(chunk, std::memory_order_release);
+            _free = chunk;
+        }
+        return *std::exchange(_free, _free->nextFree);
+    }
+
+    void ThreadTimerBackend::Recycle(Entry& entry) noexcept
+    {
+        entry.callback = nullptr;
+        entry.node = nullptr;
+        // A new generation makes outstanding TimerIds of this entry stale
+        const auto generation = ((entry.state.load(std::memory_order_relaxed) >> PhaseBits) + 1) & GenerationMask;
+        entry.state.store((generation << PhaseBits) | Free, std::memory_order_release);
+        entry.nextFree = _free;
+        _free = &entry;
+    }
+
+    void ThreadTimerBackend::Compact() noexcept
+    {
+        // Cancelled entries wait for their deadline in the heap; sweep them
+        // once they are the majority, so cancel-heavy loads stay bounded
+        const auto cancelled = _cancelled.load(std::memory_order_relaxed);
+        if (cancelled < 1024 || cancelled * 2 < _queue.size()) {
+            return;
+        }
+        const auto swept = std::partition(_queue.begin(), _queue.end(), [](const HeapItem& item) {
+            return (item.entry->state.load(std::memory_order_acquire) & PhaseMask) != Cancelled;
+        });
+        for (auto it = swept; it != _queue.end(); ++it) {
+            Recycle(*it->entry);
         }
+        _cancelled.fetch_sub(static_cast<std::size_t>(_queue.end() - swept), std::memory_order_relaxed);
+        _queue.erase(swept, _queue.end());
+        std::make_heap(_queue.begin(), _queue.end(), std::greater<>{});
     }
 }
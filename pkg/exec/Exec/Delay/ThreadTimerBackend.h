@@ -1,11 +1,12 @@
 #pragma once
 #include "ITimerBackend.h"
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
-#include <unordered_set>
 #include <vector>
 
 
@@ -19,10 +20,17 @@ namespace Exec
     /// (the CAS in DelaySharedState guarantees this is safe: it only enqueues
     /// an OperationBase pointer into the lock-free ConcurrentQueue).
     ///
-    /// Cancel() removes the entry from the active set before invocation. If the
-    /// timer thread is already executing the callback, Cancel() BLOCKS until the
-    /// callback finishes before returning false. This lets callers destroy the
-    /// data the callback accesses immediately after Cancel() returns.
+    /// Every timer (callback or TimerNode) occupies a pooled entry whose atomic
+    /// state word holds its generation and phase; a TimerId names the entry and
+    /// generation. Cancel() is a single CAS on that word, without the mutex:
+    /// the cancelled entry stays in the heap until the timer thread pops it (or
+    /// a compaction sweeps it) and recycles it. Cancelling a timer that already
+    /// fired only reads the word.
+    ///
+    /// If the timer thread is executing the callback, Cancel() BLOCKS (waiting
+    /// on the state word) until the callback finishes before returning false.
+    /// This lets callers destroy the data the callback accesses immediately
+    /// after Cancel() returns.
     class ThreadTimerBackend : public ITimerBackend
     {
     public:
@@ -36,29 +44,73 @@ namespace Exec
 
         TimerId ScheduleAt(TimePoint deadline, Callback callback) override;
         bool Cancel(TimerId id) noexcept override;
+
+        /// Nodes take a pooled entry like callbacks; node.link holds its TimerId,
+        /// written under the mutex before the timer thread can fire the node.
+        void ScheduleNode(TimerNode& node) override;
+        bool CancelNode(TimerNode& node) noexcept override;
         // Tick() intentionally left as no-op: callbacks fire from the timer thread.
 
     private:
+        // Phase in the low bits of Entry::state, generation above
+        enum Phase : std::uint64_t
+        {
+            Armed = 0,     // in the heap, waiting to fire
+            Firing = 1,    // callback running on the timer thread
+            Cancelled = 2, // in the heap, to be recycled
+            Free = 3,      // in the free list
+        };
+        static constexpr std::uint64_t PhaseBits = 2;
+        static constexpr std::uint64_t PhaseMask = (std::uint64_t{1} << PhaseBits) - 1;
+
         struct Entry
+        {
+            std::atomic<std::uint64_t> state{(std::uint64_t{1} << PhaseBits) | Free};
+            Callback callback;           // ScheduleAt()
+            TimerNode* node = nullptr;   // ScheduleNode()
+            std::uint32_t index = 0;
+            Entry* nextFree = nullptr;
+        };
+
+        struct HeapItem
         {
             TimePoint deadline;
-            TimerId   id;
-            Callback  callback;
+            Entry* entry;
 
             // Min-heap ordering: smallest deadline at the top.
-            bool operator>(const Entry& rhs) const noexcept { return deadline > rhs.deadline; }
+            bool operator>(const HeapItem& rhs) const noexcept { return deadline > rhs.deadline; }
         };
 
+        // Entries live in chunks that are never moved or freed before the
+        // backend, so Cancel() can reach them by index without the mutex
+        static constexpr std::size_t ChunkBits = 10;
+        static constexpr std::size_t ChunkSize = std::size_t{1} << ChunkBits;
+        static constexpr std::size_t MaxChunks = std::size_t{1} << 12;
+
         void RunTimerThread();
 
+        /// Queue an entry for `callback` or `node`, setting node->link to its id.
+        TimerId Arm(TimePoint deadline, Callback callback, TimerNode* node);
+
+        /// The entry a TimerId names, or nullptr if it names none.
+        [[nodiscard]] Entry* Find(TimerId id) const noexcept;
+        [[nodiscard]] Entry& Allocate();
+        void Recycle(Entry& entry) noexcept;
+
+        /// Drop cancelled entries from the heap once they make up most of it.
+        void Compact() noexcept;
+
         std::mutex _mutex;
         std::condition_variable _cv;
-        std::condition_variable _doneCv; // notified when _inflightId clears
-        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> _queue;
-        std::unordered_set<TimerId> _active; // ids waiting to fire (not yet fired / cancelled)
-        TimerId _inflightId{InvalidTimerId}; // id of the callback currently executing (at most one)
+
+        // Guarded by _mutex
+        std::vector<HeapItem> _queue; // heap of armed and cancelled entries
+        Entry* _free = nullptr;
+        std::size_t _chunkCount = 0;
+
+        std::array<std::atomic<Entry*>, MaxChunks> _chunks{};
+        std::atomic<std::size_t> _cancelled{0}; // cancelled entries still in _queue
         std::atomic<bool> _stopping{false};
-        std::atomic<TimerId> _nextId{1};
         std::jthread _thread;
     };
 }
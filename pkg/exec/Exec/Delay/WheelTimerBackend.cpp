@@ -0,0 +1,313 @@
+#include "WheelTimerBackend.h"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace Exec
+{
+    // Placement: an entry due at tick d (>= _current = n) goes to the lowest
+    // level whose current rotation still contains d. A higher-level slot is
+    // cascaded when the wheel reaches its first tick, and its entries are
+    // placed again relative to that tick, ending in level 0.
+
+    WheelTimerBackend::WheelTimerBackend()
+        : WheelTimerBackend(Options{})
+    {}
+
+    WheelTimerBackend::WheelTimerBackend(Options options)
+        : _tick(std::max(options.tick, Duration{1}))
+        , _epoch(std::chrono::steady_clock::now())
+    {
+        for (std::size_t i = 0; i < options.reserve; ++i) {
+            Release(Allocate());
+        }
+        _thread = std::jthread([this] { RunTimerThread(); });
+    }
+
+    WheelTimerBackend::~WheelTimerBackend()
+    {
+        {
+            std::lock_guard lock{_mutex};
+            _stopping.store(true, std::memory_order_relaxed);
+        }
+        _cv.notify_all();
+        _thread.join();
+    }
+
+    // -----------------------------------------------------------------------
+    // ITimerBackend
+    // -----------------------------------------------------------------------
+
+    auto WheelTimerBackend::ScheduleAt(TimePoint deadline, Callback callback) -> TimerId
+    {
+        TimerId id = InvalidTimerId;
+        bool wake = false;
+        {
+            std::lock_guard lock{_mutex};
+            auto& entry = Allocate();
+            entry.deadline = deadline;
+            entry.fire = &FireEntry;
+            entry.callback = std::move(callback);
+            // Ticks up to _current are processed: past deadlines fire on the next one
+            Place(entry, _current + 1);
+            id = IdOf(entry);
+
+            // The thread only needs waking when this timer is due before its alarm
+            wake = std::max(DueTick(deadline), _current + 1) < _wakeTick;
+        }
+        if (wake) {
+            _cv.notify_one();
+        }
+        return id;
+    }
+
+    bool WheelTimerBackend::Cancel(TimerId id) noexcept
+    {
+        const auto index = static_cast<Index>((id & 0xFFFF'FFFFu) - 1);
+        const auto generation = static_cast<std::uint32_t>(id >> 32);
+
+        std::unique_lock lock{_mutex};
+        if (id == InvalidTimerId || index >= _entries.size()) {
+            return false; // never issued
+        }
+        auto& entry = _entries[index];
+        // Block until any in-flight execution of this callback has finished.
+        _doneCv.wait(lock, [this, &entry] { return _inflight != &entry; });
+        if (entry.generation != generation || !CancelLocked(entry, lock)) {
+            return false; // fired or cancelled
+        }
+        Release(entry);
+        return true;
+    }
+
+    void WheelTimerBackend::ScheduleNode(TimerNode& node)
+    {
+        bool wake = false;
+        {
+            std::lock_guard lock{_mutex};
+            Place(node, _current + 1);
+            wake = std::max(DueTick(node.deadline), _current + 1) < _wakeTick;
+        }
+        if (wake) {
+            _cv.notify_one();
+        }
+    }
+
+    bool WheelTimerBackend::CancelNode(TimerNode& node) noexcept
+    {
+        std::unique_lock lock{_mutex};
+        return CancelLocked(node, lock);
+    }
+
+    bool WheelTimerBackend::CancelLocked(TimerNode& node, std::unique_lock<std::mutex>& lock) noexcept
+    {
+        // Block until any in-flight fire of this node has finished.
+        _doneCv.wait(lock, [this, &node] { return _inflight != &node; });
+        if (node.link == 0) {
+            return false;
+        }
+        Unlink(node);
+        return true;
+    }
+
+    // -----------------------------------------------------------------------
+    // Timer thread
+    // -----------------------------------------------------------------------
+
+    void WheelTimerBackend::FireEntry(TimerNode& node) noexcept
+    {
+        static_cast<Entry&>(node).callback();
+    }
+
+    void WheelTimerBackend::RunTimerThread()
+    {
+        std::unique_lock lock{_mutex};
+        while (!_stopping.load(std::memory_order_relaxed)) {
+            Advance(ElapsedTicks(std::chrono::steady_clock::now()), lock);
+            if (_stopping.load(std::memory_order_relaxed)) {
+                break; // set while a callback ran with the lock released
+            }
+
+            _wakeTick = NextTick();
+            if (_wakeTick == Never) {
+                _cv.wait(lock);
+            } else {
+                _cv.wait_until(lock, TickTime(_wakeTick));
+            }
+            _wakeTick = _current; // awake: schedulers need not notify
+        }
+    }
+
+    void WheelTimerBackend::Advance(std::uint64_t target, std::unique_lock<std::mutex>& lock)
+    {
+        // Ticks without level-0 nodes or a cascade are skipped
+        for (auto tick = NextTick(); tick <= target && !_stopping.load(std::memory_order_relaxed); tick = NextTick()) {
+            _current = tick;
+            if ((tick & (Slots - 1)) == 0) {
+                Cascade();
+            }
+
+            auto& head = _slots[tick & (Slots - 1)];
+            while (head) {
+                auto& node = *head;
+                Unlink(node);
+                // Pool entries are ours to recycle. A caller's node may be gone
+                // as soon as it has fired, so decide before firing
+                const bool pooled = node.fire == &FireEntry;
+
+                // Fire with the lock released so the callback can call back
+                // into the backend; cancelling this node waits for it meanwhile
+                _inflight = &node;
+                lock.unlock();
+                node.fire(node);
+                lock.lock();
+                _inflight = nullptr;
+                _doneCv.notify_all();
+
+                if (pooled) {
+                    Release(static_cast<Entry&>(node));
+                }
+            }
+        }
+        _current = std::max(_current, target);
+    }
+
+    void WheelTimerBackend::Cascade()
+    {
+        for (std::size_t level = 1; level < Levels; ++level) {
+            const auto index = (_current >> (level * SlotBits)) & (Slots - 1);
+            auto* node = std::exchange(_slots[level * Slots + index], nullptr);
+            while (node) {
+                auto* next = node->next;
+                --_pending;
+                node->link = 0;
+                Place(*node, _current);
+                node = next;
+            }
+            if (index != 0) {
+                break; // higher levels only turn when this one wraps
+            }
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    // Wheel
+    // -----------------------------------------------------------------------
+
+    std::uint64_t WheelTimerBackend::DueTick(TimePoint deadline) const noexcept
+    {
+        if (deadline <= _epoch) {
+            return 0;
+        }
+        // Rounded up: never fire early
+        const auto ticks = (deadline - _epoch + _tick - Duration{1}) / _tick;
+        return static_cast<std::uint64_t>(ticks);
+    }
+
+    std::uint64_t WheelTimerBackend::ElapsedTicks(TimePoint now) const noexcept
+    {
+        // Rounded down: a tick is processed once its time has been reached
+        return now <= _epoch ? 0 : static_cast<std::uint64_t>((now - _epoch) / _tick);
+    }
+
+    auto WheelTimerBackend::TickTime(std::uint64_t tick) const noexcept -> TimePoint
+    {
+        return _epoch + _tick * static_cast<Duration::rep>(tick);
+    }
+
+    std::uint64_t WheelTimerBackend::NextTick() const noexcept
+    {
+        if (_pending == 0) {
+            return Never;
+        }
+        const auto rotation = _current & ~std::uint64_t{Slots - 1};
+        for (auto from = (_current & (Slots - 1)) + 1; from < Slots; from = (from | 63) + 1) {
+            const auto bits = _occupied[from / 64] >> (from % 64);
+            if (bits != 0) {
+                return rotation + from + static_cast<std::uint64_t>(std::countr_zero(bits));
+            }
+        }
+        return rotation + Slots;
+    }
+
+    void WheelTimerBackend::Place(TimerNode& node, std::uint64_t earliest) noexcept
+    {
+        // Earliest is _current only while cascading, right before that tick's slot runs
+        const auto now = _current;
+        const auto due = std::max(DueTick(node.deadline), earliest);
+        for (std::size_t level = 0; level + 1 < Levels; ++level) {
+            const auto shift = (level + 1) * SlotBits;
+            if ((due >> shift) == (now >> shift)) {
+                Link(node, level * Slots + ((due >> (level * SlotBits)) & (Slots - 1)));
+                return;
+            }
+        }
+
+        // The top level does not wrap into a rotation of its own: it takes
+        // anything up to 255 of its slots ahead. Later deadlines are parked in
+        // the farthest slot and placed again when it cascades
+        constexpr auto top = (Levels - 1) * SlotBits;
+        const auto ahead = std::min<std::uint64_t>((due >> top) - (now >> top), Slots - 1);
+        Link(node, (Levels - 1) * Slots + (((now >> top) + ahead) & (Slots - 1)));
+    }
+
+    void WheelTimerBackend::Link(TimerNode& node, std::size_t slot) noexcept
+    {
+        auto& head = _slots[slot];
+        node.link = slot + 1;
+        node.prev = nullptr;
+        node.next = head;
+        if (head) {
+            head->prev = &node;
+        }
+        head = &node;
+        if (slot < Slots) {
+            _occupied[slot / 64] |= std::uint64_t{1} << (slot % 64);
+        }
+        ++_pending;
+    }
+
+    void WheelTimerBackend::Unlink(TimerNode& node) noexcept
+    {
+        const auto slot = node.link - 1;
+        if (node.prev) {
+            node.prev->next = node.next;
+        } else {
+            _slots[slot] = node.next;
+        }
+        if (node.next) {
+            node.next->prev = node.prev;
+        }
+        if (slot < Slots && !_slots[slot]) {
+            _occupied[slot / 64] &= ~(std::uint64_t{1} << (slot % 64));
+        }
+        node.link = 0;
+        node.prev = nullptr;
+        node.next = nullptr;
+        --_pending;
+    }
+
+    auto WheelTimerBackend::IdOf(const Entry& entry) noexcept -> TimerId
+    {
+        return (TimerId{entry.generation} << 32) | (TimerId{entry.index} + 1);
+    }
+
+    auto WheelTimerBackend::Allocate() -> Entry&
+    {
+        if (_free) {
+            return *std::exchange(_free, _free->nextFree);
+        }
+        auto& entry = _entries.emplace_back();
+        entry.index = static_cast<Index>(_entries.size() - 1);
+        return entry;
+    }
+
+    void WheelTimerBackend::Release(Entry& entry) noexcept
+    {
+        entry.callback = nullptr;
+        ++entry.generation;
+        entry.nextFree = _free;
+        _free = &entry;
+    }
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include "ITimerBackend.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+
+namespace Exec
+{
+    /// Thread-based timer backend on a hierarchical timing wheel.
+    ///
+    /// A drop-in alternative to ThreadTimerBackend for workloads that arm and
+    /// cancel many short timeouts (e.g. one TimedOperation per request): select
+    /// it through Domain's backend parameter.
+    ///
+    ///     auto domain = std::make_shared<Domain>(MainTask(), std::make_unique<WheelTimerBackend>());
+    ///
+    /// Deadlines are rounded up to the wheel's tick (Options::tick), so timers
+    /// fire up to one tick late, never early. Four levels of 256 slots cover
+    /// 2^32 ticks; later deadlines are parked in the last level and re-placed.
+    ///
+    /// Scheduling and cancelling are O(1). ScheduleNode() links the caller's
+    /// TimerNode into its slot directly. ScheduleAt() takes a node from a
+    /// recycled pool of entries, and its TimerId carries the entry's index and
+    /// generation instead of going through a hash set. Cancelled timers are
+    /// unlinked at once rather than left for the timer thread. Neither path
+    /// allocates once the pool is warm (callbacks small enough for
+    /// std::function's inline storage aside).
+    ///
+    /// Callbacks run on the backend's thread, one at a time. Like
+    /// ThreadTimerBackend, Cancel() of a callback that is executing blocks
+    /// until it returns.
+    class WheelTimerBackend : public ITimerBackend
+    {
+    public:
+        struct Options
+        {
+            /// Wheel resolution. Coarser ticks mean fewer wakeups of the timer thread.
+            Duration tick = std::chrono::milliseconds{1};
+
+            /// Entries allocated up front; the pool grows on demand.
+            std::size_t reserve = 1024;
+        };
+
+        WheelTimerBackend();
+        explicit WheelTimerBackend(Options options);
+        ~WheelTimerBackend() override;
+
+        WheelTimerBackend(const WheelTimerBackend&) = delete;
+        WheelTimerBackend& operator=(const WheelTimerBackend&) = delete;
+        WheelTimerBackend(WheelTimerBackend&&) = delete;
+        WheelTimerBackend& operator=(WheelTimerBackend&&) = delete;
+
+        TimerId ScheduleAt(TimePoint deadline, Callback callback) override;
+        bool Cancel(TimerId id) noexcept override;
+        void ScheduleNode(TimerNode& node) override;
+        bool CancelNode(TimerNode& node) noexcept override;
+        // Tick() intentionally left as no-op: callbacks fire from the timer thread.
+
+    private:
+        static constexpr std::size_t SlotBits = 8;
+        static constexpr std::size_t Slots = std::size_t{1} << SlotBits;
+        static constexpr std::size_t Levels = 4;
+
+        using Index = std::uint32_t;
+        static constexpr std::uint64_t Never = std::numeric_limits<std::uint64_t>::max();
+
+        /// Pool entry behind a ScheduleAt() callback.
+        struct Entry : TimerNode
+        {
+            Callback      callback;
+            Index         index = 0;
+            std::uint32_t generation = 1; // bumped on release: stale TimerIds miss
+            Entry*        nextFree = nullptr;
+        };
+
+        static void FireEntry(TimerNode& node) noexcept;
+
+        void RunTimerThread();
+
+        [[nodiscard]] std::uint64_t DueTick(TimePoint deadline) const noexcept;
+        [[nodiscard]] std::uint64_t ElapsedTicks(TimePoint now) const noexcept;
+        [[nodiscard]] TimePoint TickTime(std::uint64_t tick) const noexcept;
+
+        /// Next tick with work: a non-empty level-0 slot of the current
+        /// rotation, or the next rotation (which cascades). Never if empty.
+        [[nodiscard]] std::uint64_t NextTick() const noexcept;
+
+        /// Process ticks up to `target`, firing due nodes with `lock` released.
+        void Advance(std::uint64_t target, std::unique_lock<std::mutex>& lock);
+
+        /// Move the nodes of every higher-level slot that starts at _current down the wheel.
+        void Cascade();
+
+        /// Link `node` into the slot for its deadline, but no earlier than tick `earliest`.
+        void Place(TimerNode& node, std::uint64_t earliest) noexcept;
+        void Link(TimerNode& node, std::size_t slot) noexcept;
+        void Unlink(TimerNode& node) noexcept;
+
+        /// Unlink a scheduled node after any in-flight fire of it has finished.
+        bool CancelLocked(TimerNode& node, std::unique_lock<std::mutex>& lock) noexcept;
+
+        [[nodiscard]] static TimerId IdOf(const Entry& entry) noexcept;
+        [[nodiscard]] Entry& Allocate();
+        void Release(Entry& entry) noexcept;
+
+        const Duration _tick;
+        const TimePoint _epoch;
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::condition_variable _doneCv; // notified when _inflight clears
+
+        // Guarded by _mutex
+        std::deque<Entry> _entries; // stable addresses: entries are linked by pointer
+        Entry* _free = nullptr;
+        std::array<TimerNode*, Levels * Slots> _slots{};   // node.link is slot + 1
+        std::array<std::uint64_t, Slots / 64> _occupied{}; // level-0 slots holding nodes
+        std::uint64_t _current = 0;                        // last processed tick
+        std::uint64_t _wakeTick = Never;                   // tick the timer thread sleeps until
+        std::size_t _pending = 0;                          // nodes linked into the wheel
+        const TimerNode* _inflight = nullptr;              // node currently firing
+
+        std::atomic<bool> _stopping{false};
+        std::jthread _thread;
+    };
+}
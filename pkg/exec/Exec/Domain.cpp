@@ -33,12 +33,17 @@ namespace Exec
         if (const auto count = _scheduler.DrainQueue(); count > 0) {
             Log::Trace("drained {} task(s)", count);
         }
+        _carryOver = 0;
         _opState.reset();
     }
 
     void Domain::Update(const RunLoop::UpdateCtx& ctx)
     {
-        if (const auto count = _scheduler.DrainQueue(); count > 0) {
+        const auto count = _scheduler.DrainQueue(_drainBudget);
+        _carryOver = _drainBudget.IsUnlimited() ? 0 : _scheduler.PendingCount();
+        if (_carryOver > 0) {
+            Log::Trace("drained {} task(s) on frame={}, {} carried over", count, ctx.frame.index, _carryOver);
+        } else if (count > 0) {
             Log::Trace("drained {} task(s) on frame={}", count, ctx.frame.index);
         }
     }
@@ -33,6 +33,20 @@ namespace Exec
         /// exec::schedule_at).
         Scheduler GetScheduler() noexcept { return _scheduler.GetScheduler(); }
 
+        /// Limit the work Update() drains per frame; the rest carries over to
+        /// the next frame. Unlimited by default (every queued task runs).
+        /// Stop() always drains fully, so pending tasks can observe the stop.
+        ///
+        /// Example:
+        ///   domain->SetDrainBudget({.maxTasks = 256, .maxTime = 2ms});
+        void SetDrainBudget(DrainBudget budget) noexcept { _drainBudget = budget; }
+        [[nodiscard]] DrainBudget GetDrainBudget() const noexcept { return _drainBudget; }
+
+        /// Approximate number of tasks the last Update() left queued for the
+        /// next frame (it may include work other threads enqueued meanwhile).
+        /// Always 0 with an unlimited budget.
+        [[nodiscard]] std::size_t CarryOver() const noexcept { return _carryOver; }
+
         /// Construct with a sender directly.
         ///
         /// Wraps the sender with starts_on(GetScheduler(), sender) so that its
@@ -129,6 +143,9 @@ namespace Exec
         // Stop() calls request_stop() before destroying _opState so that
         // stop-token-aware senders can observe the signal and unwind cleanly.
         stdexec::inplace_stop_source _stopSource;
+
+        DrainBudget _drainBudget;
+        std::size_t _carryOver = 0; // left queued by the last Update()
     };
 
     // ---------------------------------------------------------------
@@ -0,0 +1,132 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Rtt
+{
+    /// Default inline storage of a Delegate: six pointers, so the whole
+    /// delegate (storage + two function pointers) is one 64-byte cache line.
+    inline constexpr std::size_t DelegateCapacity = 6 * sizeof(void*);
+
+    template <typename Signature, std::size_t Capacity = DelegateCapacity>
+    class Delegate;
+
+    /// Move-only, non-allocating replacement for std::function.
+    ///
+    /// The callable is stored inline; one that does not fit `Capacity` (or
+    /// needs stricter alignment, or may throw on move) is rejected at compile
+    /// time instead of being boxed on the heap. Dispatch is a single indirect
+    /// call through a per-type invoker, with no RTTI. Trivially copyable
+    /// callables (`[this]`, `[&]`, function pointers) are moved with memcpy
+    /// and need no destructor call.
+    ///
+    /// Like std::function, operator() is const and an empty delegate tests
+    /// false; calling an empty delegate is undefined behaviour.
+    template <typename R, typename... Args, std::size_t Capacity>
+    class Delegate<R(Args...), Capacity>
+    {
+    public:
+        Delegate() noexcept = default;
+        Delegate(std::nullptr_t) noexcept {} // NOLINT(*-explicit-*)
+
+        template <typename F>
+            requires(!std::is_same_v<std::remove_cvref_t<F>, Delegate> &&
+                     std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+        Delegate(F&& f) // NOLINT(*-explicit-*, *-forwarding-reference-overload)
+        {
+            using Fn = std::decay_t<F>;
+            static_assert(sizeof(Fn) <= Capacity, "callable too large for Delegate inline storage");
+            static_assert(alignof(Fn) <= alignof(std::max_align_t), "callable over-aligned for Delegate");
+            static_assert(std::is_nothrow_move_constructible_v<Fn>, "Delegate callable must be nothrow-movable");
+
+            ::new (static_cast<void*>(_storage)) Fn(std::forward<F>(f));
+            _invoke = &Invoke<Fn>;
+            if constexpr (!IsTrivial<Fn>) {
+                _manage = &Manage<Fn>;
+            }
+        }
+
+        Delegate(Delegate&& other) noexcept { MoveFrom(other); }
+
+        Delegate& operator=(Delegate&& other) noexcept
+        {
+            if (this != &other) {
+                Reset();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+
+        Delegate& operator=(std::nullptr_t) noexcept
+        {
+            Reset();
+            return *this;
+        }
+
+        Delegate(const Delegate&) = delete;
+        Delegate& operator=(const Delegate&) = delete;
+
+        ~Delegate() { Reset(); }
+
+        explicit operator bool() const noexcept { return _invoke != nullptr; }
+
+        R operator()(Args... args) const { return _invoke(_storage, std::forward<Args>(args)...); }
+
+    private:
+        enum class Op
+        {
+            MoveTo,
+            Destroy,
+        };
+
+        using InvokeFn = R (*)(void*, Args...);
+        using ManageFn = void (*)(Op, void* self, void* dst) noexcept;
+
+        template <typename Fn>
+        static constexpr bool IsTrivial = std::is_trivially_copyable_v<Fn> && std::is_trivially_destructible_v<Fn>;
+
+        template <typename Fn>
+        static R Invoke(void* storage, Args... args)
+        {
+            return std::invoke_r<R>(*std::launder(static_cast<Fn*>(storage)), std::forward<Args>(args)...);
+        }
+
+        template <typename Fn>
+        static void Manage(Op op, void* self, void* dst) noexcept
+        {
+            auto* fn = std::launder(static_cast<Fn*>(self));
+            if (op == Op::MoveTo) {
+                ::new (dst) Fn(std::move(*fn));
+            }
+            fn->~Fn();
+        }
+
+        void MoveFrom(Delegate& other) noexcept
+        {
+            if (other._manage) {
+                other._manage(Op::MoveTo, other._storage, _storage);
+            } else if (other._invoke) {
+                std::memcpy(_storage, other._storage, Capacity);
+            }
+            _invoke = std::exchange(other._invoke, nullptr);
+            _manage = std::exchange(other._manage, nullptr);
+        }
+
+        void Reset() noexcept
+        {
+            if (_manage) {
+                _manage(Op::Destroy, _storage, nullptr);
+            }
+            _invoke = nullptr;
+            _manage = nullptr;
+        }
+
+        alignas(std::max_align_t) mutable std::byte _storage[Capacity];
+        InvokeFn _invoke = nullptr;
+        ManageFn _manage = nullptr;
+    };
+}
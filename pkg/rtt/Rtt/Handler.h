@@ -1,7 +1,10 @@
 #pragma once
+#include "Delegate.h"
+#include "Packet.h"
+
 #include <cstddef>
-#include <functional>
 #include <span>
+#include <vector>
 
 namespace Rtt
 {
@@ -13,9 +16,72 @@ namespace Rtt
     struct LinkHandler
     {
         /// Called when data arrives on the link.
-        std::function<void(std::span<const std::byte>)> onReceived;
+        Delegate<void(std::span<const std::byte>)> onReceived;
 
         /// Called when the link is disconnected (gracefully or otherwise).
-        std::function<void()> onDisconnected;
+        Delegate<void()> onDisconnected;
+
+        /// Optional. Called when a link that stopped being Writable() has drained
+        /// below its low watermark and accepts sends again (see ILink::Writable).
+        Delegate<void()> onWritable;
+
+        /// Optional. When set, replaces onReceived: data arrives as a Packet the
+        /// handler may copy and keep past the callback. Transports that own the
+        /// received bytes (pooled UDP receive, WebRTC DataChannels) pass them
+        /// on without a copy; the others hand over a copy (see Deliver()).
+        Delegate<void(const Packet&)> onPacket;
+    };
+
+    /// Hand received bytes that live only for the call to `handler`: to
+    /// onPacket as a standalone copy when set, to onReceived otherwise.
+    inline void Deliver(const LinkHandler& handler, std::span<const std::byte> data)
+    {
+        if (handler.onPacket) {
+            handler.onPacket(Packet::Copy(data));
+        } else if (handler.onReceived) {
+            handler.onReceived(data);
+        }
+    }
+
+    /// Hand received bytes the caller owns to `handler`: moved into the packet
+    /// for onPacket, lent as a span to onReceived.
+    inline void Deliver(const LinkHandler& handler, std::vector<std::byte>&& data)
+    {
+        if (handler.onPacket) {
+            handler.onPacket(Packet::Adopt(std::move(data)));
+        } else if (handler.onReceived) {
+            handler.onReceived(data);
+        }
+    }
+
+    /// Contract for handler objects with named member callbacks, attached to
+    /// a link through Bind().
+    ///
+    /// There is no compile-time dispatch path: transports are type-erased
+    /// (ITransport) and call the handler through LinkHandler's Delegates, one
+    /// indirect call per callback whatever the handler type.
+    template <typename H>
+    concept LinkHandlerLike = requires(H& h, std::span<const std::byte> data) {
+        { h.OnReceived(data) };
+        { h.OnDisconnected() };
     };
+
+    /// Adapt a LinkHandlerLike object to a LinkHandler. The object is
+    /// referenced, not copied, and must outlive the link. OnWritable() and
+    /// OnPacket(const Packet&) members, if present, become onWritable and onPacket.
+    template <LinkHandlerLike H>
+    [[nodiscard]] LinkHandler Bind(H& handler) noexcept
+    {
+        LinkHandler bound{
+            .onReceived = [&handler](std::span<const std::byte> data) { handler.OnReceived(data); },
+            .onDisconnected = [&handler] { handler.OnDisconnected(); },
+        };
+        if constexpr (requires { handler.OnWritable(); }) {
+            bound.onWritable = [&handler] { handler.OnWritable(); };
+        }
+        if constexpr (requires(const Packet& packet) { handler.OnPacket(packet); }) {
+            bound.onPacket = [&handler](const Packet& packet) { handler.OnPacket(packet); };
+        }
+        return bound;
+    }
 }
@@ -1,11 +1,15 @@
 #pragma once
+#include "Delegate.h"
+#include "LinkStats.h"
 #include "PeerId.h"
 
 #include <concepts>
 #include <cstddef>
-#include <functional>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <span>
+#include <utility>
 
 namespace Rtt
 {
@@ -13,7 +17,52 @@ namespace Rtt
     /// writable buffer; the user writes payload data and returns the number
     /// of bytes actually written. This allows implementations to hand out
     /// ring-buffer or packet-buffer slices for true zero-copy sends.
-    using WriteCallback = std::function<std::size_t(std::span<std::byte>)>;
+    /// Move-only and stored inline (see Delegate): captures must fit its storage.
+    using WriteCallback = Delegate<std::size_t(std::span<std::byte>)>;
+
+    /// Scatter-gather payload for SendV(): the pieces of one message, in order.
+    using ConstBufferSequence = std::span<const std::span<const std::byte>>;
+
+    /// Total size of a buffer sequence in bytes.
+    inline std::size_t BufferSize(ConstBufferSequence buffers) noexcept
+    {
+        std::size_t total = 0;
+        for (const auto& b : buffers) {
+            total += b.size();
+        }
+        return total;
+    }
+
+    /// Copy a buffer sequence into `out` back to back. Returns the number of
+    /// bytes written, or 0 (nothing to send) if the sequence does not fit.
+    inline std::size_t GatherInto(ConstBufferSequence buffers, std::span<std::byte> out) noexcept
+    {
+        const auto total = BufferSize(buffers);
+        if (total > out.size()) {
+            return 0;
+        }
+        auto* dst = out.data();
+        for (const auto& b : buffers) {
+            if (!b.empty()) {
+                std::memcpy(dst, b.data(), b.size());
+                dst += b.size();
+            }
+        }
+        return total;
+    }
+
+    /// Channel of a link (see ILink::ChannelCount()). Channel 0 always exists.
+    using ChannelId = std::uint8_t;
+
+    /// Outcome of ILink::TrySend().
+    enum class SendStatus : std::uint8_t
+    {
+        /// Handed to the link (which may still lose it: links are unreliable).
+        Sent,
+
+        /// The link is over its outstanding-bytes limit; the writer was not called.
+        WouldBlock,
+    };
 
     /// Compile-time contract for link-like types.
     template <typename T>
@@ -29,6 +78,19 @@ namespace Rtt
     /// Represents one established connection between two peers. Shared
     /// ownership via shared_ptr because both the user and the transport
     /// hold references to the link.
+    ///
+    /// Link decorators (Rel::RelLink, Pace::PacedLink, Bundle::BundleLink) wrap
+    /// an inner link and share one threading contract:
+    ///   - Their state is guarded by a mutex, and they may call the inner link
+    ///     and run writers under it: writers must not re-enter the link.
+    ///   - Sends they start on their own (retransmits, paced queue drains,
+    ///     flushes) run from an Exec::LoopTimerBackend or a flush ticked by the
+    ///     frame loop that drives the inner transport, so they reach the inner
+    ///     link on its own thread. The decorated link is used from that thread too.
+    ///   - The user's handler is bound before the inner link can deliver
+    ///     anything, and is called without the decorator's lock.
+    ///   - Timer backends and other objects passed in their options must
+    ///     outlive the transport and its links.
     class ILink : public std::enable_shared_from_this<ILink>
     {
     public:
@@ -40,13 +102,80 @@ namespace Rtt
         /// Identity of the remote endpoint on this link.
         [[nodiscard]] virtual const PeerId& RemoteId() const = 0;
 
-        /// Enqueue a send operation. The transport will invoke `writer` with a
-        /// writable buffer when ready; `writer` returns the number of bytes
-        /// written. Fire-and-forget: no completion notification.
+        /// Send one message. The link invokes `writer` with a writable buffer
+        /// before Send() returns, or not at all if it drops the send; `writer`
+        /// returns the number of bytes written. Writers may therefore capture
+        /// locals by reference. Fire-and-forget: no completion notification. A
+        /// link with an outstanding-bytes limit drops sends while it is not
+        /// Writable().
         virtual void Send(WriteCallback writer) = 0;
 
+        /// Send one message gathered from several buffers (e.g. a header and a
+        /// body) without joining them first. The buffers are only read during
+        /// the call. A message larger than the transport's maximum is dropped.
+        ///
+        /// The default gathers the pieces into the buffer handed out by Send();
+        /// transports that can pass a buffer sequence to the OS override it.
+        virtual void SendV(ConstBufferSequence buffers)
+        {
+            Send([buffers](std::span<std::byte> out) { return GatherInto(buffers, out); });
+        }
+
         /// Initiate a graceful disconnect.
         virtual void Disconnect() = 0;
+
+        // --- Channels ---
+        //
+        // Links may carry several channels with their own delivery guarantees
+        // (e.g. a reliable one for events and an unreliable, unordered one for
+        // state where the freshest update wins). Send(writer) uses channel 0;
+        // received messages of all channels reach the same LinkHandler.
+
+        /// Number of channels; valid ids are below it.
+        [[nodiscard]] virtual std::size_t ChannelCount() const { return 1; }
+
+        /// Send on `channel`, like Send(writer) otherwise. Links without
+        /// channels send every message the same way; links with channels drop
+        /// sends to an invalid id.
+        virtual void Send(ChannelId channel, WriteCallback writer)
+        {
+            (void)channel;
+            Send(std::move(writer));
+        }
+
+        // --- Backpressure ---
+        //
+        // Links with a limit on outstanding bytes (accepted but not yet handed to
+        // the OS or the WebRTC stack) stop being Writable() at the limit and fire
+        // LinkHandler::onWritable once they drain to half of it. Links without a
+        // limit are always writable.
+
+        /// Whether a send now would be accepted.
+        [[nodiscard]] virtual bool Writable() const { return true; }
+
+        /// Bytes accepted by the link and still queued below it.
+        [[nodiscard]] virtual std::size_t OutstandingBytes() const { return 0; }
+
+        /// Send now if Writable(), otherwise keep `writer` and call it, in order,
+        /// once the link drains. Deferred writers run on the thread that drains
+        /// the link and are discarded on disconnect.
+        virtual void SendWhenWritable(WriteCallback writer) { Send(std::move(writer)); }
+
+        /// Send only if Writable(); the writer is not called otherwise, so the
+        /// caller can shed or coalesce the message instead.
+        SendStatus TrySend(WriteCallback writer)
+        {
+            if (!Writable()) {
+                return SendStatus::WouldBlock;
+            }
+            Send(std::move(writer));
+            return SendStatus::Sent;
+        }
+
+        /// Traffic counters and RTT estimate. Callable from any thread.
+        /// Links that keep no statistics return zeros; decorators forward to
+        /// the link they wrap.
+        [[nodiscard]] virtual LinkStats GetStats() const { return {}; }
     };
 
     static_assert(LinkLike<ILink>);
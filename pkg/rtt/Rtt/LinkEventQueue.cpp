@@ -0,0 +1,165 @@
+#include "LinkEventQueue.h"
+
+#include <utility>
+
+namespace Rtt
+{
+    // -----------------------------------------------------------------------
+    // Acceptor
+    // -----------------------------------------------------------------------
+
+    class LinkEventQueue::Acceptor : public ILinkAcceptor
+    {
+    public:
+        Acceptor(std::weak_ptr<LinkEventQueue> queue, std::shared_ptr<ILinkAcceptor> user)
+            : _queue(std::move(queue))
+            , _user(std::move(user))
+        {}
+
+        LinkHandler OnLink(LinkResult result) override
+        {
+            auto queue = _queue.lock();
+            if (!queue) {
+                return {};
+            }
+
+            // The user's handler is only known once the event is delivered;
+            // until then the link's events queue up behind it
+            auto target = std::make_shared<Target>();
+            auto event = std::make_unique<Event>();
+            event->kind = Kind::Link;
+            event->target = target;
+            event->acceptor = _user;
+            event->link = std::move(result);
+            queue->Push(std::move(event));
+            return queue->Forward(std::move(target));
+        }
+
+    private:
+        std::weak_ptr<LinkEventQueue> _queue;
+        std::shared_ptr<ILinkAcceptor> _user;
+    };
+
+    // -----------------------------------------------------------------------
+    // LinkEventQueue
+    // -----------------------------------------------------------------------
+
+    LinkEventQueue::LinkEventQueue(Wake wake)
+        : _wake(std::move(wake))
+    {}
+
+    LinkEventQueue::~LinkEventQueue()
+    {
+        auto* event = _head.exchange(nullptr, std::memory_order_acquire);
+        while (event) {
+            std::unique_ptr<Event> owned{event};
+            event = event->next;
+        }
+    }
+
+    std::shared_ptr<ILinkAcceptor> LinkEventQueue::Wrap(std::shared_ptr<ILinkAcceptor> acceptor)
+    {
+        return std::make_shared<Acceptor>(weak_from_this(), std::move(acceptor));
+    }
+
+    LinkHandler LinkEventQueue::Forward(std::shared_ptr<Target> target)
+    {
+        const std::weak_ptr<LinkEventQueue> weak = weak_from_this();
+
+        // onPacket, not onReceived: links that own their receive buffers hand
+        // them over instead of having them copied here
+        return {
+            .onDisconnected = [weak, target] { Post(weak, target, Kind::Disconnected); },
+            .onWritable = [weak, target] { Post(weak, target, Kind::Writable); },
+            .onPacket = [weak, target](const Packet& packet) { Post(weak, target, Kind::Received, &packet); },
+        };
+    }
+
+    void LinkEventQueue::Post(const std::weak_ptr<LinkEventQueue>& queue,
+                              const std::shared_ptr<Target>& target,
+                              Kind kind,
+                              const Packet* packet)
+    {
+        auto self = queue.lock();
+        if (!self) {
+            return;
+        }
+        auto event = std::make_unique<Event>();
+        event->kind = kind;
+        event->target = target;
+        if (packet) {
+            event->packet = *packet;
+        }
+        self->Push(std::move(event));
+    }
+
+    void LinkEventQueue::Push(std::unique_ptr<Event> event) noexcept
+    {
+        auto* node = event.release();
+        auto* head = _head.load(std::memory_order_relaxed);
+        do {
+            node->next = head;
+        } while (!_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+        // Only the event that finds the queue empty wakes the consumer: the
+        // rest are picked up by the same Drain()
+        if (!head && _wake) {
+            _wake(*this);
+        }
+    }
+
+    std::size_t LinkEventQueue::Drain()
+    {
+        // Take the batch and restore arrival order
+        auto* batch = _head.exchange(nullptr, std::memory_order_acquire);
+        Event* oldest = nullptr;
+        while (batch) {
+            auto* next = batch->next;
+            batch->next = oldest;
+            oldest = batch;
+            batch = next;
+        }
+
+        std::size_t count = 0;
+        while (oldest) {
+            std::unique_ptr<Event> event{oldest};
+            oldest = oldest->next;
+            Dispatch(*event);
+            ++count;
+        }
+        return count;
+    }
+
+    void LinkEventQueue::Dispatch(Event& event)
+    {
+        auto& handler = event.target->handler;
+        switch (event.kind) {
+        case Kind::Link: {
+            const bool linked = event.link.has_value();
+            auto user = event.acceptor->OnLink(std::move(event.link));
+            if (linked) {
+                handler = std::move(user);
+            }
+            break;
+        }
+        case Kind::Received:
+            if (handler.onPacket) {
+                handler.onPacket(event.packet);
+            } else if (handler.onReceived) {
+                handler.onReceived(event.packet.Span());
+            }
+            break;
+        case Kind::Disconnected:
+            if (handler.onDisconnected) {
+                handler.onDisconnected();
+            }
+            handler = {}; // release what the user's callbacks hold
+            break;
+        case Kind::Writable:
+            if (handler.onWritable) {
+                handler.onWritable();
+            }
+            break;
+        }
+    }
+}
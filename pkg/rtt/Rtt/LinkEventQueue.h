@@ -0,0 +1,107 @@
+#pragma once
+#include "Acceptor.h"
+#include "Delegate.h"
+#include "Handler.h"
+#include "Packet.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Rtt
+{
+    /// Moves link events of transports that call back on their own threads
+    /// (e.g. libdatachannel) onto the thread that drains the queue.
+    ///
+    /// Wrap() an acceptor and open the transport with the result: OnLink() and
+    /// every event of the links it accepts (data, disconnect, writable) are
+    /// queued, then delivered in order by Drain(). Handlers therefore run on a
+    /// single thread without locks of their own.
+    ///
+    /// Producers push onto a lock-free intrusive stack; Drain() takes the whole
+    /// batch with one exchange. Drain() once per frame from the update loop, or
+    /// drain on an executor from the `wake` callback, which runs (on the
+    /// producer's thread) only when an event finds the queue empty:
+    ///
+    ///     // Asio strand
+    ///     auto queue = std::make_shared<LinkEventQueue>([strand](LinkEventQueue& q) {
+    ///         asio::post(strand, [q = q.shared_from_this()] { q->Drain(); });
+    ///     });
+    ///     // Exec::Domain scheduler
+    ///     auto queue = std::make_shared<LinkEventQueue>([sched](LinkEventQueue& q) {
+    ///         stdexec::start_detached(stdexec::schedule(sched)
+    ///             | stdexec::then([q = q.shared_from_this()] { q->Drain(); }));
+    ///     });
+    ///
+    /// Received data reaches the handler's onPacket without a copy when the link
+    /// lends packets, onReceived otherwise. Events still queued when the queue is
+    /// destroyed are dropped.
+    class LinkEventQueue : public std::enable_shared_from_this<LinkEventQueue>
+    {
+    public:
+        /// Called when an event is pushed onto an empty queue. Must not drain inline.
+        using Wake = Delegate<void(LinkEventQueue&)>;
+
+        explicit LinkEventQueue(Wake wake = {});
+        ~LinkEventQueue();
+
+        LinkEventQueue(const LinkEventQueue&) = delete;
+        LinkEventQueue& operator=(const LinkEventQueue&) = delete;
+
+        /// An acceptor queueing its OnLink() calls and its links' events for
+        /// `acceptor`. The queue must be owned by a shared_ptr.
+        [[nodiscard]] std::shared_ptr<ILinkAcceptor> Wrap(std::shared_ptr<ILinkAcceptor> acceptor);
+
+        /// Deliver the queued events in arrival order. Single consumer: call
+        /// from one thread (or strand) at a time. Returns the number delivered.
+        std::size_t Drain();
+
+        /// Whether events are waiting (a snapshot; producers may add more).
+        [[nodiscard]] bool Empty() const noexcept { return _head.load(std::memory_order_relaxed) == nullptr; }
+
+    private:
+        class Acceptor;
+
+        /// The user's handler of one link, set when its OnLink event is delivered.
+        struct Target
+        {
+            LinkHandler handler;
+        };
+
+        enum class Kind : std::uint8_t
+        {
+            Link,
+            Received,
+            Disconnected,
+            Writable,
+        };
+
+        struct Event
+        {
+            Event* next = nullptr;
+            Kind kind;
+            std::shared_ptr<Target> target;
+            std::shared_ptr<ILinkAcceptor> acceptor; // Link
+            LinkResult link;                         // Link
+            Packet packet;                           // Received
+        };
+
+        void Push(std::unique_ptr<Event> event) noexcept;
+
+        /// Queue an event of the link bound to `target`, unless the queue is gone.
+        /// Callable from any thread.
+        static void Post(const std::weak_ptr<LinkEventQueue>& queue,
+                         const std::shared_ptr<Target>& target,
+                         Kind kind,
+                         const Packet* packet = nullptr);
+
+        /// The handler given to the transport: queues every event for `target`.
+        [[nodiscard]] LinkHandler Forward(std::shared_ptr<Target> target);
+
+        static void Dispatch(Event& event);
+
+        std::atomic<Event*> _head{nullptr}; // newest first
+        Wake _wake;
+    };
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Rtt
+{
+    /// Snapshot of one link's traffic counters and round-trip estimate,
+    /// returned by ILink::GetStats().
+    ///
+    /// Packets are what the link puts on or takes off the wire (datagrams,
+    /// DataChannel messages), including its own control frames.
+    struct LinkStats
+    {
+        std::uint64_t packetsSent = 0;
+        std::uint64_t bytesSent = 0;
+        std::uint64_t packetsReceived = 0;
+        std::uint64_t bytesReceived = 0;
+
+        /// Messages refused (oversized, over budget) or failed to send.
+        std::uint64_t sendDrops = 0;
+
+        /// Received packets discarded (malformed, unknown frame).
+        std::uint64_t receiveDrops = 0;
+
+        /// Smoothed round-trip time. 0 until the first sample.
+        std::chrono::microseconds rtt{0};
+
+        /// Mean deviation of the round-trip time (jitter).
+        std::chrono::microseconds rttVariation{0};
+
+        /// RTT samples taken so far.
+        std::uint64_t rttSamples = 0;
+    };
+
+    /// Lock-free counter block behind a link's GetStats().
+    ///
+    /// Counters are relaxed atomics: any thread may update them and read a
+    /// Snapshot() without synchronising with the link. RTT samples must come
+    /// from one thread at a time (the link's receive path); the estimate follows
+    /// RFC 6298 (srtt gain 1/8, variation gain 1/4).
+    class LinkCounters
+    {
+    public:
+        void OnSent(std::size_t bytes) noexcept
+        {
+            _packetsSent.fetch_add(1, std::memory_order_relaxed);
+            _bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        void OnReceived(std::size_t bytes) noexcept
+        {
+            _packetsReceived.fetch_add(1, std::memory_order_relaxed);
+            _bytesReceived.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        void OnSendDrop() noexcept { _sendDrops.fetch_add(1, std::memory_order_relaxed); }
+        void OnReceiveDrop() noexcept { _receiveDrops.fetch_add(1, std::memory_order_relaxed); }
+
+        void OnRttSample(std::chrono::microseconds sample) noexcept
+        {
+            const auto r = std::max<std::int64_t>(sample.count(), 0);
+            const auto samples = _rttSamples.load(std::memory_order_relaxed);
+            auto srtt = _rtt.load(std::memory_order_relaxed);
+            auto var = _rttVariation.load(std::memory_order_relaxed);
+            if (samples == 0) {
+                srtt = r;
+                var = r / 2;
+            } else {
+                const auto delta = srtt > r ? srtt - r : r - srtt;
+                var = var - var / 4 + delta / 4;
+                srtt = srtt - srtt / 8 + r / 8;
+            }
+            _rtt.store(srtt, std::memory_order_relaxed);
+            _rttVariation.store(var, std::memory_order_relaxed);
+            _rttSamples.store(samples + 1, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] LinkStats Snapshot() const noexcept
+        {
+            return LinkStats{
+                .packetsSent = _packetsSent.load(std::memory_order_relaxed),
+                .bytesSent = _bytesSent.load(std::memory_order_relaxed),
+                .packetsReceived = _packetsReceived.load(std::memory_order_relaxed),
+                .bytesReceived = _bytesReceived.load(std::memory_order_relaxed),
+                .sendDrops = _sendDrops.load(std::memory_order_relaxed),
+                .receiveDrops = _receiveDrops.load(std::memory_order_relaxed),
+                .rtt = std::chrono::microseconds(_rtt.load(std::memory_order_relaxed)),
+                .rttVariation = std::chrono::microseconds(_rttVariation.load(std::memory_order_relaxed)),
+                .rttSamples = _rttSamples.load(std::memory_order_relaxed),
+            };
+        }
+
+    private:
+        // Senders and the receive path often run on different threads: keep
+        // their counters on separate cache lines
+        static constexpr std::size_t CacheLine = 64;
+
+        alignas(CacheLine) std::atomic<std::uint64_t> _packetsSent{0};
+        std::atomic<std::uint64_t> _bytesSent{0};
+        std::atomic<std::uint64_t> _sendDrops{0};
+        alignas(CacheLine) std::atomic<std::uint64_t> _packetsReceived{0};
+        std::atomic<std::uint64_t> _bytesReceived{0};
+        std::atomic<std::uint64_t> _receiveDrops{0};
+        std::atomic<std::int64_t> _rtt{0};          // microseconds
+        std::atomic<std::int64_t> _rttVariation{0}; // microseconds
+        std::atomic<std::uint64_t> _rttSamples{0};
+    };
+}
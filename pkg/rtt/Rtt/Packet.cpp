@@ -0,0 +1,120 @@
+#include "Packet.h"
+
+#include <cstring>
+#include <new>
+
+namespace Rtt
+{
+    // -----------------------------------------------------------------------
+    // Packet
+    // -----------------------------------------------------------------------
+
+    auto Packet::Slab::Create(std::size_t capacity) -> Slab*
+    {
+        // Header and bytes in one allocation; the bytes are left uninitialised
+        void* memory = ::operator new(sizeof(Slab) + capacity);
+        auto* slab = ::new (memory) Slab;
+        slab->capacity = capacity;
+        return slab;
+    }
+
+    void Packet::Slab::Destroy(Slab* slab) noexcept
+    {
+        slab->~Slab();
+        ::operator delete(slab);
+    }
+
+    Packet Packet::Copy(std::span<const std::byte> data)
+    {
+        auto* slab = Slab::Create(data.size());
+        if (!data.empty()) {
+            std::memcpy(slab->Bytes(), data.data(), data.size());
+        }
+        return {slab, data.size()};
+    }
+
+    Packet Packet::Adopt(std::vector<std::byte> bytes)
+    {
+        auto* slab = Slab::Create(0);
+        slab->adopted = std::move(bytes);
+        return {slab, slab->adopted.data(), slab->adopted.size()};
+    }
+
+    void Packet::Release() noexcept
+    {
+        auto* slab = std::exchange(_slab, nullptr);
+        _data = nullptr;
+        _size = 0;
+        if (!slab || slab->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        if (auto pool = std::move(slab->pool)) {
+            pool->Recycle(slab);
+        } else {
+            Slab::Destroy(slab);
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    // PacketPool
+    // -----------------------------------------------------------------------
+
+    PacketPool::PacketPool(std::size_t slabSize, std::size_t maxIdle)
+        : _slabSize(slabSize)
+        , _maxIdle(maxIdle)
+    {
+        _idle.reserve(maxIdle);
+    }
+
+    PacketPool::~PacketPool()
+    {
+        // Slabs still in use hold a shared_ptr to the pool: only idle ones remain
+        for (auto* slab : _idle) {
+            Packet::Slab::Destroy(slab);
+        }
+    }
+
+    auto PacketPool::Acquire() -> Buffer
+    {
+        Packet::Slab* slab = nullptr;
+        {
+            std::lock_guard lock{_mutex};
+            if (!_idle.empty()) {
+                slab = _idle.back();
+                _idle.pop_back();
+                _idleCount.store(_idle.size(), std::memory_order_relaxed);
+            }
+        }
+        if (slab) {
+            _hits.fetch_add(1, std::memory_order_relaxed);
+            slab->refs.store(1, std::memory_order_relaxed);
+        } else {
+            slab = Packet::Slab::Create(_slabSize);
+            _misses.fetch_add(1, std::memory_order_relaxed);
+        }
+        slab->pool = shared_from_this();
+        return Buffer{Packet{slab, 0}};
+    }
+
+    auto PacketPool::GetStats() const noexcept -> Stats
+    {
+        return {
+            .hits = _hits.load(std::memory_order_relaxed),
+            .misses = _misses.load(std::memory_order_relaxed),
+            .idle = _idleCount.load(std::memory_order_relaxed),
+        };
+    }
+
+    void PacketPool::Recycle(Packet::Slab* slab) noexcept
+    {
+        {
+            std::lock_guard lock{_mutex};
+            if (_idle.size() < _maxIdle) {
+                _idle.push_back(slab); // capacity reserved in constructor: no throw
+                _idleCount.store(_idle.size(), std::memory_order_relaxed);
+                return;
+            }
+        }
+        Packet::Slab::Destroy(slab);
+    }
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Rtt
+{
+    class PacketPool;
+
+    /// Refcounted, read-only received bytes that may be kept past the receive
+    /// callback (see LinkHandler::onPacket).
+    ///
+    /// Copies share the storage; the last one frees it, or returns it to its
+    /// PacketPool when it came from one. Packets may be copied, kept and
+    /// released on any thread. Slice() narrows the view without copying.
+    class Packet
+    {
+    public:
+        Packet() noexcept = default;
+        ~Packet() { Release(); }
+
+        Packet(const Packet& other) noexcept
+            : _slab(other._slab)
+            , _data(other._data)
+            , _size(other._size)
+        {
+            AddRef();
+        }
+
+        Packet(Packet&& other) noexcept
+            : _slab(std::exchange(other._slab, nullptr))
+            , _data(std::exchange(other._data, nullptr))
+            , _size(std::exchange(other._size, 0))
+        {}
+
+        Packet& operator=(Packet other) noexcept
+        {
+            std::swap(_slab, other._slab);
+            std::swap(_data, other._data);
+            std::swap(_size, other._size);
+            return *this;
+        }
+
+        /// A standalone packet holding a copy of `data`.
+        [[nodiscard]] static Packet Copy(std::span<const std::byte> data);
+
+        /// A standalone packet taking over `bytes` without copying them (e.g. a
+        /// message buffer a library hands over by value).
+        [[nodiscard]] static Packet Adopt(std::vector<std::byte> bytes);
+
+        [[nodiscard]] const std::byte* Data() const noexcept { return _data; }
+        [[nodiscard]] std::size_t Size() const noexcept { return _size; }
+        [[nodiscard]] std::span<const std::byte> Span() const noexcept { return {_data, _size}; }
+        [[nodiscard]] bool Empty() const noexcept { return _size == 0; }
+
+        /// The bytes `part` (which must lie within Span()) as a packet sharing this one's storage.
+        [[nodiscard]] Packet Slice(std::span<const std::byte> part) const noexcept
+        {
+            Packet slice{*this};
+            slice._data = part.data();
+            slice._size = part.size();
+            return slice;
+        }
+
+    private:
+        friend class PacketPool;
+
+        /// Header in front of the bytes of one allocation.
+        struct Slab
+        {
+            std::atomic<std::uint32_t> refs{1};
+            std::shared_ptr<PacketPool> pool; // null when idle or standalone
+            std::size_t capacity = 0;
+            std::vector<std::byte> adopted; // Adopt(): the bytes, instead of inline storage
+
+            [[nodiscard]] std::byte* Bytes() noexcept { return reinterpret_cast<std::byte*>(this + 1); } //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+            static Slab* Create(std::size_t capacity);
+            static void Destroy(Slab* slab) noexcept;
+        };
+
+        Packet(Slab* slab, std::size_t size) noexcept
+            : Packet(slab, slab->Bytes(), size)
+        {}
+
+        Packet(Slab* slab, const std::byte* data, std::size_t size) noexcept
+            : _slab(slab)
+            , _data(data)
+            , _size(size)
+        {}
+
+        void AddRef() const noexcept
+        {
+            if (_slab) {
+                _slab->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void Release() noexcept;
+
+        Slab* _slab = nullptr;
+        const std::byte* _data = nullptr;
+        std::size_t _size = 0;
+    };
+
+    /// Recycling pool of fixed-size receive slabs.
+    ///
+    /// A transport Acquire()s a Buffer, receives into it and Publish()es the
+    /// datagram as a Packet. When the last copy of that packet is released the
+    /// slab returns to the idle list, so a consumer that drops packets within
+    /// the callback costs no allocation per datagram. At most `maxIdle` slabs
+    /// are retained; extra ones are freed.
+    ///
+    /// Acquire() is meant for the transport's thread; packets may be released
+    /// on any thread. The pool must be owned by a shared_ptr.
+    class PacketPool : public std::enable_shared_from_this<PacketPool>
+    {
+    public:
+        struct Stats
+        {
+            /// Acquire() calls served from the idle list.
+            std::uint64_t hits = 0;
+
+            /// Acquire() calls that had to allocate a new slab.
+            std::uint64_t misses = 0;
+
+            /// Slabs currently held in the idle list.
+            std::size_t idle = 0;
+        };
+
+        /// Move-only, writable slab for one receive. Returns to the pool unless published.
+        class Buffer
+        {
+        public:
+            Buffer() = default;
+
+            /// The whole slab, for the receive operation to fill.
+            [[nodiscard]] std::span<std::byte> Span() const noexcept
+            {
+                return {_packet._slab->Bytes(), _packet._slab->capacity};
+            }
+
+            /// Turn the first `size` bytes into a packet. The buffer is empty afterwards.
+            [[nodiscard]] Packet Publish(std::size_t size) && noexcept
+            {
+                _packet._size = size;
+                return std::move(_packet);
+            }
+
+        private:
+            friend class PacketPool;
+
+            explicit Buffer(Packet packet) noexcept
+                : _packet(std::move(packet))
+            {}
+
+            Packet _packet;
+        };
+
+        /// @param slabSize Size of every slab in bytes (the transport's maxDatagramSize).
+        /// @param maxIdle  Maximum number of idle slabs kept for reuse.
+        PacketPool(std::size_t slabSize, std::size_t maxIdle);
+        ~PacketPool();
+
+        PacketPool(const PacketPool&) = delete;
+        PacketPool& operator=(const PacketPool&) = delete;
+
+        /// Take a slab from the idle list or allocate a new one.
+        [[nodiscard]] Buffer Acquire();
+
+        [[nodiscard]] std::size_t SlabSize() const noexcept { return _slabSize; }
+        [[nodiscard]] Stats GetStats() const noexcept;
+
+    private:
+        friend class Packet;
+
+        void Recycle(Packet::Slab* slab) noexcept;
+
+        std::size_t _slabSize;
+        std::size_t _maxIdle;
+        std::mutex _mutex;
+        std::vector<Packet::Slab*> _idle; // guarded by _mutex
+        std::atomic<std::uint64_t> _hits{0};
+        std::atomic<std::uint64_t> _misses{0};
+        std::atomic<std::size_t> _idleCount{0};
+    };
+}
@@ -0,0 +1,62 @@
+#include "PeerId.h"
+
+#include <algorithm>
+#include <charconv>
+
+namespace Rtt
+{
+    PeerIdValue PeerIdValue::FromIpv4(std::uint32_t address, std::uint16_t port) noexcept
+    {
+        PeerIdValue v;
+        char* out = v._inline;
+        char* const end = v._inline + InlineCapacity; // "255.255.255.255:65535" always fits
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            out = std::to_chars(out, end, (address >> shift) & 0xffU).ptr;
+            *out++ = shift != 0 ? '.' : ':';
+        }
+        out = std::to_chars(out, end, port).ptr;
+        *out = '\0';
+
+        v._size = static_cast<std::uint32_t>(out - v._inline);
+        v._endpoint = (static_cast<std::uint64_t>(address) << 16) | port;
+        v._hash = HashOf(v.View());
+        return v;
+    }
+
+    void PeerIdValue::Assign(std::string_view text)
+    {
+        char* dst = _inline;
+        if (text.size() > InlineCapacity) {
+            _heap = std::make_unique_for_overwrite<char[]>(text.size() + 1);
+            dst = _heap.get();
+        }
+        std::copy(text.begin(), text.end(), dst);
+        dst[text.size()] = '\0';
+        _size = static_cast<std::uint32_t>(text.size());
+        _endpoint = 0;
+        _hash = HashOf(text);
+    }
+
+    void PeerIdValue::CopyFrom(const PeerIdValue& other)
+    {
+        _heap.reset();
+        Assign(other.View());
+        _endpoint = other._endpoint;
+    }
+
+    void PeerIdValue::MoveFrom(PeerIdValue& other) noexcept
+    {
+        _heap = std::move(other._heap);
+        if (!_heap) {
+            std::copy_n(other._inline, other._size + 1, _inline);
+        }
+        _size = other._size;
+        _endpoint = other._endpoint;
+        _hash = other._hash;
+
+        other._inline[0] = '\0';
+        other._size = 0;
+        other._endpoint = 0;
+        other._hash = HashOf({});
+    }
+}
@@ -1,19 +1,158 @@
 #pragma once
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 
 namespace Rtt
 {
+    /// Immutable identifier text with inline storage and a precomputed hash.
+    ///
+    /// Identifiers up to InlineCapacity characters (UUIDs, "ip:port") are kept
+    /// in place, longer ones fall back to a heap copy. The FNV-1a hash is
+    /// computed once on construction, so hashing is free and comparisons of
+    /// different IDs usually stop at the hash.
+    ///
+    /// IDs built by PeerId::FromIpv4() also keep the packed endpoint
+    /// (`address << 16 | port`): they are formatted without allocation and
+    /// compared as integers.
+    ///
+    /// Exposes the std::string subset used for IDs (size/empty/data/c_str)
+    /// so it can replace the former std::string value in place.
+    class PeerIdValue
+    {
+    public:
+        static constexpr std::size_t InlineCapacity = 47;
+
+        PeerIdValue() noexcept { _inline[0] = '\0'; }
+        PeerIdValue(std::string_view text) { Assign(text); } // NOLINT(*-explicit-*)
+        PeerIdValue(const char* text) : PeerIdValue(std::string_view{text}) {} // NOLINT(*-explicit-*)
+        PeerIdValue(const std::string& text) : PeerIdValue(std::string_view{text}) {} // NOLINT(*-explicit-*)
+
+        PeerIdValue(const PeerIdValue& other) { CopyFrom(other); }
+        PeerIdValue(PeerIdValue&& other) noexcept { MoveFrom(other); }
+        PeerIdValue& operator=(const PeerIdValue& other)
+        {
+            if (this != &other) {
+                CopyFrom(other);
+            }
+            return *this;
+        }
+        PeerIdValue& operator=(PeerIdValue&& other) noexcept
+        {
+            if (this != &other) {
+                MoveFrom(other);
+            }
+            return *this;
+        }
+        ~PeerIdValue() = default;
+
+        /// Build "a.b.c.d:port" for a host-order IPv4 address without allocating.
+        [[nodiscard]] static PeerIdValue FromIpv4(std::uint32_t address, std::uint16_t port) noexcept;
+
+        [[nodiscard]] const char* data() const noexcept { return _heap ? _heap.get() : _inline; }
+        [[nodiscard]] const char* c_str() const noexcept { return data(); }
+        [[nodiscard]] std::size_t size() const noexcept { return _size; }
+        [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+        [[nodiscard]] std::string_view View() const noexcept { return {data(), _size}; }
+        [[nodiscard]] std::size_t Hash() const noexcept { return _hash; }
+
+        /// Packed IPv4 endpoint for IDs created by FromIpv4(), std::nullopt otherwise.
+        [[nodiscard]] std::optional<std::uint64_t> Ipv4Endpoint() const noexcept
+        {
+            return _endpoint != 0 ? std::optional{_endpoint} : std::nullopt;
+        }
+
+        operator std::string_view() const noexcept { return View(); } // NOLINT(*-explicit-*)
+
+        friend bool operator==(const PeerIdValue& a, const PeerIdValue& b) noexcept
+        {
+            if (a._endpoint != 0 && b._endpoint != 0) {
+                return a._endpoint == b._endpoint;
+            }
+            return a._hash == b._hash && a.View() == b.View();
+        }
+
+        friend std::strong_ordering operator<=>(const PeerIdValue& a, const PeerIdValue& b) noexcept
+        {
+            return a.View() <=> b.View();
+        }
+
+    private:
+        static constexpr std::size_t HashOf(std::string_view text) noexcept
+        {
+            // FNV-1a, 64-bit
+            std::uint64_t hash = 0xcbf29ce484222325ULL;
+            for (const char c : text) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 0x100000001b3ULL;
+            }
+            return static_cast<std::size_t>(hash);
+        }
+
+        void Assign(std::string_view text);
+        void CopyFrom(const PeerIdValue& other);
+        void MoveFrom(PeerIdValue& other) noexcept;
+
+        char _inline[InlineCapacity + 1];
+        std::unique_ptr<char[]> _heap;
+        std::uint32_t _size = 0;
+        std::uint64_t _endpoint = 0; // 0.0.0.0:0 is never a peer: 0 means "not an endpoint"
+        std::size_t _hash = HashOf({});
+    };
+
     /// Universal peer identity for transport links.
     ///
     /// String-based to accommodate heterogeneous transport schemes
     /// (UUIDs, IP:port, overlay node IDs, etc.).
     struct PeerId
     {
-        std::string value;
+        PeerIdValue value;
+
+        /// Allocation-free "a.b.c.d:port" identity for an IPv4 endpoint (host byte order).
+        [[nodiscard]] static PeerId FromIpv4(std::uint32_t address, std::uint16_t port) noexcept
+        {
+            return PeerId{.value = PeerIdValue::FromIpv4(address, port)};
+        }
 
         auto operator<=>(const PeerId&) const = default;
 
         operator std::string_view() const noexcept { return value; }
     };
 }
+
+template <>
+struct std::hash<Rtt::PeerIdValue>
+{
+    std::size_t operator()(const Rtt::PeerIdValue& v) const noexcept { return v.Hash(); }
+};
+
+template <>
+struct std::hash<Rtt::PeerId>
+{
+    std::size_t operator()(const Rtt::PeerId& id) const noexcept { return id.value.Hash(); }
+};
+
+template <>
+struct std::formatter<Rtt::PeerIdValue> : std::formatter<std::string_view>
+{
+    auto format(const Rtt::PeerIdValue& v, std::format_context& ctx) const
+    {
+        return std::formatter<std::string_view>::format(v.View(), ctx);
+    }
+};
+
+template <>
+struct std::formatter<Rtt::PeerId> : std::formatter<Rtt::PeerIdValue>
+{
+    auto format(const Rtt::PeerId& id, std::format_context& ctx) const
+    {
+        return std::formatter<Rtt::PeerIdValue>::format(id.value, ctx);
+    }
+};
@@ -104,7 +104,7 @@ void SigHub::Register(PeerId localId, SigJoinHandler onJoined)
     // (e.g. libdatachannel ICE/SDP) can deliver messages into the pending buffer.
     {
         std::lock_guard lock{_mutex};
-        _peers[localId.value] = user;
+        _peers[localId] = user;
     }
 
     Log::Debug("registered peer {}", localId.value);
@@ -115,7 +115,7 @@ void SigHub::Register(PeerId localId, SigJoinHandler onJoined)
     if (!whandler.lock()) {
         // Caller returned no handler (e.g. join failed) — remove from registry.
         std::lock_guard lock{_mutex};
-        _peers.erase(localId.value);
+        _peers.erase(localId);
         return;
     }
 
@@ -126,7 +126,7 @@ void SigHub::Register(PeerId localId, SigJoinHandler onJoined)
 void SigHub::Unregister(const PeerId& localId)
 {
     std::lock_guard lock{_mutex};
-    _peers.erase(localId.value);
+    _peers.erase(localId);
 }
 
 void SigHub::Dispatch(const PeerId& from, const PeerId& to, std::string payload)
@@ -134,7 +134,7 @@ void SigHub::Dispatch(const PeerId& from, const PeerId& to, std::string payload)
     std::shared_ptr<HubUser> target;
     {
         std::lock_guard lock{_mutex};
-        if (auto it = _peers.find(to.value); it != _peers.end()) {
+        if (auto it = _peers.find(to); it != _peers.end()) {
             target = it->second.lock();
             if (!target) {
                 _peers.erase(it); // lazy cleanup of stale entry
@@ -57,7 +57,7 @@ private:
     class HubUser;
 
     std::mutex _mutex;
-    std::unordered_map<std::string, std::weak_ptr<HubUser>> _peers;
+    std::unordered_map<PeerId, std::weak_ptr<HubUser>> _peers;
 };
 
 } // namespace Rtt::Rtc
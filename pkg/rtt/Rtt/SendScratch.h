@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Rtt
+{
+    /// Per-thread buffer for building an outgoing message that is sent or
+    /// copied before the call returns, so links need no buffer of their own.
+    ///
+    /// The buffer grows to the largest size requested on the thread and is
+    /// reused by every link there. A scope opened while another one is alive
+    /// on the same thread (a WriteCallback that sends again from inside
+    /// itself) gets a private buffer instead of overwriting the outer message.
+    ///
+    ///     SendScratch scratch{_maxMessageSize};
+    ///     const auto written = writer(scratch.Span());
+    class SendScratch
+    {
+    public:
+        explicit SendScratch(std::size_t size)
+            : _nested(std::exchange(_busy, true))
+            , _size(size)
+        {
+            auto& buffer = _nested ? _own : _shared;
+            if (buffer.size() < size) {
+                buffer.resize(size);
+            }
+        }
+
+        ~SendScratch()
+        {
+            if (!_nested) {
+                _busy = false;
+            }
+        }
+
+        SendScratch(const SendScratch&) = delete;
+        SendScratch& operator=(const SendScratch&) = delete;
+
+        [[nodiscard]] std::span<std::byte> Span() noexcept
+        {
+            return std::span{_nested ? _own : _shared}.first(_size);
+        }
+
+    private:
+        static inline thread_local std::vector<std::byte> _shared;
+        static inline thread_local bool _busy = false;
+
+        bool _nested;
+        std::size_t _size;
+        std::vector<std::byte> _own; // nested scopes only
+    };
+}
@@ -0,0 +1,91 @@
+#include "TransportStats.h"
+
+#include "Log/Log.h"
+#include <algorithm>
+
+namespace Rtt
+{
+    namespace
+    {
+        void AddCounters(LinkStats& total, const LinkStats& link) noexcept
+        {
+            total.packetsSent += link.packetsSent;
+            total.bytesSent += link.bytesSent;
+            total.packetsReceived += link.packetsReceived;
+            total.bytesReceived += link.bytesReceived;
+            total.sendDrops += link.sendDrops;
+            total.receiveDrops += link.receiveDrops;
+            total.rttSamples += link.rttSamples;
+        }
+    }
+
+    std::shared_ptr<LinkCounters> TransportStats::Track()
+    {
+        auto counters = std::make_shared<LinkCounters>();
+        std::lock_guard lock{_mutex};
+        if (_links.size() >= _retireAt) {
+            // Bound the list under link churn even if nobody calls Collect()
+            RetireLocked();
+            _retireAt = std::max<std::size_t>(64, 2 * _links.size());
+        }
+        _links.push_back(counters);
+        return counters;
+    }
+
+    void TransportStats::RetireLocked()
+    {
+        // Blocks no link holds any more: their final values no longer change
+        std::erase_if(_links, [this](const std::shared_ptr<LinkCounters>& counters) {
+            if (counters.use_count() > 1) {
+                return false;
+            }
+            AddCounters(_retired, counters->Snapshot());
+            return true;
+        });
+    }
+
+    auto TransportStats::Collect() -> Summary
+    {
+        std::lock_guard lock{_mutex};
+        RetireLocked();
+
+        Summary summary{.total = _retired, .links = _links.size()};
+        std::chrono::microseconds rttSum{0};
+        std::chrono::microseconds variationSum{0};
+        std::size_t measured = 0;
+        for (const auto& counters : _links) {
+            const auto link = counters->Snapshot();
+            AddCounters(summary.total, link);
+            if (link.rttSamples > 0) {
+                rttSum += link.rtt;
+                variationSum += link.rttVariation;
+                summary.maxRtt = std::max(summary.maxRtt, link.rtt);
+                ++measured;
+            }
+        }
+        if (measured > 0) {
+            summary.total.rtt = rttSum / measured;
+            summary.total.rttVariation = variationSum / measured;
+        }
+        return summary;
+    }
+
+    bool TransportStats::LogEvery(std::string_view name, Clock::duration interval, Clock::time_point now)
+    {
+        const auto ticks = now.time_since_epoch().count();
+        auto due = _nextLog.load(std::memory_order_relaxed);
+        if (ticks < due || !_nextLog.compare_exchange_strong(due, ticks + interval.count(), std::memory_order_relaxed)) {
+            return false; // not due, or another thread is logging this period
+        }
+
+        const auto s = Collect();
+        const auto ms = [](std::chrono::microseconds us) { return static_cast<double>(us.count()) / 1000.0; };
+        Log::Info("{}: {} links, sent {} pkts / {} B ({} dropped), received {} pkts / {} B ({} dropped), "
+                  "rtt {:.1f} ms ±{:.1f} (max {:.1f})",
+                  name, s.links,
+                  s.total.packetsSent, s.total.bytesSent, s.total.sendDrops,
+                  s.total.packetsReceived, s.total.bytesReceived, s.total.receiveDrops,
+                  ms(s.total.rtt), ms(s.total.rttVariation), ms(s.maxRtt));
+        return true;
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "LinkStats.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace Rtt
+{
+    /// Link statistics summed over all links of a transport.
+    ///
+    /// The transport takes each link's counter block from Track(); links update
+    /// it lock-free and only Collect() takes the mutex. Blocks no link holds
+    /// any more are folded into a retired total, so the sums cover every link
+    /// the transport ever had. Thread-safe.
+    class TransportStats
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Summary
+        {
+            /// Counters summed over all links. rtt and rttVariation are averages
+            /// over the live links that have RTT samples.
+            LinkStats total;
+
+            /// Links alive now.
+            std::size_t links = 0;
+
+            /// Highest smoothed RTT among live links.
+            std::chrono::microseconds maxRtt{0};
+        };
+
+        /// Counter block for a new link.
+        [[nodiscard]] std::shared_ptr<LinkCounters> Track();
+
+        [[nodiscard]] Summary Collect();
+
+        /// Log a one-line Summary at Info level, tagged with `name`, if `interval`
+        /// has passed since the last time it logged. One atomic load when not
+        /// due, so it can be called every frame. Returns true if it logged.
+        bool LogEvery(std::string_view name, Clock::duration interval, Clock::time_point now = Clock::now());
+
+    private:
+        void RetireLocked();
+
+        std::mutex _mutex;
+        std::vector<std::shared_ptr<LinkCounters>> _links;
+        std::size_t _retireAt = 64; // Track() retires when _links reaches this size
+        LinkStats _retired;
+        std::atomic<Clock::rep> _nextLog{0}; // time_since_epoch of the next due log
+    };
+}
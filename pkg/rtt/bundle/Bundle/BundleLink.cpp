@@ -0,0 +1,266 @@
+#include "BundleLink.h"
+
+#include "BundleProtocol.h"
+#include "Log/Log.h"
+
+#include <cstring>
+#include <utility>
+
+namespace Rtt::Bundle
+{
+    using namespace Protocol;
+
+    // -----------------------------------------------------------------------
+    // Construction
+    // -----------------------------------------------------------------------
+
+    BundleLink::BundleLink(std::shared_ptr<ILink> inner,
+                           std::shared_ptr<const Options> options,
+                           std::shared_ptr<FlushList> flushList)
+        : _inner(std::move(inner))
+        , _options(std::move(options))
+        , _flushList(std::move(flushList))
+        , _bundle(2 * _options->maxDatagramSize)
+        , _enabled(_options->enabled)
+    {}
+
+    // -----------------------------------------------------------------------
+    // ILink
+    // -----------------------------------------------------------------------
+
+    const PeerId& BundleLink::LocalId() const { return _inner->LocalId(); }
+    const PeerId& BundleLink::RemoteId() const { return _inner->RemoteId(); }
+
+    void BundleLink::Send(WriteCallback writer)
+    {
+        std::lock_guard lock{_mutex};
+        if (!_closed) {
+            SendLocked(std::move(writer));
+        }
+    }
+
+    void BundleLink::SendLocked(WriteCallback writer)
+    {
+        if (!_enabled) {
+            SendSingle(std::move(writer));
+            return;
+        }
+
+        // Write straight into the bundle, past the message's length prefix
+        const auto offset = NextOffset();
+        const auto written = writer(std::span{_bundle}.subspan(offset + LengthSize, MaxPayload()));
+        if (written == 0) {
+            return;
+        }
+        Append(offset, written);
+    }
+
+    void BundleLink::SendV(ConstBufferSequence buffers)
+    {
+        std::lock_guard lock{_mutex};
+        if (_closed) {
+            return;
+        }
+
+        const auto total = BufferSize(buffers);
+        if (!_enabled || total > MaxPayload()) {
+            SendSingle([buffers](std::span<std::byte> out) -> std::size_t { return GatherInto(buffers, out); });
+            return;
+        }
+        if (total == 0) {
+            return;
+        }
+
+        const auto offset = NextOffset();
+        GatherInto(buffers, std::span{_bundle}.subspan(offset + LengthSize));
+        Append(offset, total);
+    }
+
+    void BundleLink::Disconnect()
+    {
+        {
+            std::lock_guard lock{_mutex};
+            if (_closed) {
+                return;
+            }
+            FlushLocked();
+            _closed = true;
+            _deferred.clear();
+        }
+        _inner->Disconnect();
+    }
+
+    LinkStats BundleLink::GetStats() const
+    {
+        return _inner->GetStats();
+    }
+
+    bool BundleLink::Writable() const
+    {
+        return _inner->Writable();
+    }
+
+    std::size_t BundleLink::OutstandingBytes() const
+    {
+        std::lock_guard lock{_mutex};
+        return _used + _inner->OutstandingBytes();
+    }
+
+    void BundleLink::SendWhenWritable(WriteCallback writer)
+    {
+        std::lock_guard lock{_mutex};
+        if (_closed) {
+            return;
+        }
+        if (!_deferred.empty() || !_inner->Writable()) {
+            _deferred.push_back(std::move(writer));
+            return;
+        }
+        SendLocked(std::move(writer));
+    }
+
+    // -----------------------------------------------------------------------
+    // Bundling
+    // -----------------------------------------------------------------------
+
+    void BundleLink::SetBundling(bool enabled)
+    {
+        std::lock_guard lock{_mutex};
+        if (!enabled) {
+            FlushLocked();
+        }
+        _enabled = enabled;
+    }
+
+    void BundleLink::Flush()
+    {
+        std::lock_guard lock{_mutex};
+        _listed = false;
+        if (!_closed) {
+            FlushLocked();
+        }
+    }
+
+    std::size_t BundleLink::MaxPayload() const noexcept
+    {
+        return _options->maxDatagramSize - HeaderSize - LengthSize;
+    }
+
+    std::size_t BundleLink::NextOffset() const noexcept
+    {
+        return _used == 0 ? HeaderSize : _used;
+    }
+
+    void BundleLink::Append(std::size_t offset, std::size_t size)
+    {
+        if (offset + LengthSize + size > _options->maxDatagramSize) {
+            // Overflow: send the bundle so far, the new message starts the next one
+            FlushLocked();
+            std::memmove(_bundle.data() + HeaderSize + LengthSize, _bundle.data() + offset + LengthSize, size);
+            offset = HeaderSize;
+        }
+        WriteLength(std::span{_bundle}.subspan(offset), size);
+        _used = offset + LengthSize + size;
+        ++_count;
+
+        if (!_listed) {
+            _listed = true;
+            std::lock_guard lock{_flushList->mutex};
+            _flushList->links.push_back(std::static_pointer_cast<BundleLink>(shared_from_this()));
+        }
+    }
+
+    void BundleLink::FlushLocked()
+    {
+        if (_count == 0) {
+            return;
+        }
+        if (_count == 1) {
+            // A lone message goes out as Single: the tag overwrites the end of
+            // its length prefix, so the datagram stays contiguous
+            constexpr auto tagAt = HeaderSize + LengthSize - HeaderSize;
+            _bundle[tagAt] = static_cast<std::byte>(Kind::Single);
+            const std::span<const std::byte> parts[] = {std::span{_bundle}.subspan(tagAt, _used - tagAt)};
+            _inner->SendV(parts);
+        } else {
+            _bundle[0] = static_cast<std::byte>(Kind::Bundle);
+            const std::span<const std::byte> parts[] = {std::span{_bundle}.first(_used)};
+            _inner->SendV(parts);
+        }
+        _used = 0;
+        _count = 0;
+    }
+
+    void BundleLink::SendSingle(WriteCallback writer)
+    {
+        // Keep messages in order: whatever is pending goes first
+        FlushLocked();
+        _inner->Send([&writer](std::span<std::byte> out) -> std::size_t {
+            if (out.size() <= HeaderSize) {
+                return 0;
+            }
+            const auto written = writer(out.subspan(HeaderSize));
+            if (written == 0) {
+                return 0;
+            }
+            out[0] = static_cast<std::byte>(Kind::Single);
+            return HeaderSize + written;
+        });
+    }
+
+    // -----------------------------------------------------------------------
+    // Inner link events
+    // -----------------------------------------------------------------------
+
+    void BundleLink::SetHandler(LinkHandler handler)
+    {
+        _handler = std::move(handler);
+    }
+
+    void BundleLink::OnInnerReceived(std::span<const std::byte> data, const Packet* packet)
+    {
+        const auto valid = Unpack(data, [this, packet](std::span<const std::byte> message) {
+            if (packet && _handler.onPacket) {
+                _handler.onPacket(packet->Slice(message));
+            } else {
+                Deliver(_handler, message);
+            }
+        });
+        if (!valid) {
+            Log::Trace("malformed bundle ({} bytes) from {}", data.size(), RemoteId().value);
+        }
+    }
+
+    void BundleLink::OnInnerDisconnected()
+    {
+        {
+            std::lock_guard lock{_mutex};
+            _closed = true;
+            _used = 0;
+            _count = 0;
+            _deferred.clear();
+        }
+        if (_handler.onDisconnected) {
+            _handler.onDisconnected();
+        }
+    }
+
+    void BundleLink::OnInnerWritable()
+    {
+        {
+            // Deferred writers first, in order
+            std::lock_guard lock{_mutex};
+            while (!_closed && !_deferred.empty() && _inner->Writable()) {
+                auto writer = std::move(_deferred.front());
+                _deferred.pop_front();
+                SendLocked(std::move(writer));
+            }
+            if (_closed || !_deferred.empty()) {
+                return;
+            }
+        }
+        if (_handler.onWritable) {
+            _handler.onWritable();
+        }
+    }
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include "Rtt/Handler.h"
+#include "Rtt/Link.h"
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace Rtt::Bundle
+{
+    class BundleLink;
+
+    /// Links of one BundleTransport holding a started bundle, in the order they
+    /// started it. Drained by BundleTransport::Flush().
+    struct FlushList
+    {
+        std::mutex mutex;
+        std::vector<std::weak_ptr<BundleLink>> links; // guarded by mutex
+    };
+
+    /// Link decorator coalescing small messages into shared datagrams.
+    ///
+    /// Messages sent between two flushes are packed, length-prefixed, into as
+    /// few datagrams as fit Options::maxDatagramSize (see BundleProtocol.h). A
+    /// datagram goes to the inner link when the next message does not fit or
+    /// when the transport flushes, normally once per frame (FrameFlusher). The
+    /// receiving side unpacks bundles before the user's onReceived, so both
+    /// peers must use the decorator.
+    ///
+    /// Writers fill the bundle in place. A message that fits no bundle on its
+    /// own goes out alone, after whatever is pending.
+    ///
+    /// Threading follows the decorator contract on ILink; Flush() is the
+    /// frame-driven send.
+    class BundleLink : public ILink
+    {
+    public:
+        struct Options
+        {
+            /// Bytes of one bundled datagram, header included. Must not exceed
+            /// what the inner link accepts in one message.
+            std::size_t maxDatagramSize = 1472;
+
+            /// Whether new links start bundling (see SetBundling()).
+            bool enabled = true;
+        };
+
+        BundleLink(std::shared_ptr<ILink> inner,
+                   std::shared_ptr<const Options> options,
+                   std::shared_ptr<FlushList> flushList);
+
+        BundleLink(const BundleLink&) = delete;
+        BundleLink& operator=(const BundleLink&) = delete;
+
+        // ILink
+        [[nodiscard]] const PeerId& LocalId() const override;
+        [[nodiscard]] const PeerId& RemoteId() const override;
+        void Send(WriteCallback writer) override;
+        void SendV(ConstBufferSequence buffers) override;
+
+        /// Sends what is pending, then disconnects the inner link.
+        void Disconnect() override;
+
+        [[nodiscard]] LinkStats GetStats() const override;
+
+        /// The inner link's; pending bundle bytes count as outstanding.
+        [[nodiscard]] bool Writable() const override;
+        [[nodiscard]] std::size_t OutstandingBytes() const override;
+
+        /// Bundles like Send() once the inner link is Writable(); until then
+        /// the writer waits, in order, for the inner link's onWritable.
+        void SendWhenWritable(WriteCallback writer) override;
+
+        /// Turn bundling on or off for this link. Turning it off sends what is
+        /// pending; later messages go out one per datagram.
+        void SetBundling(bool enabled);
+
+        /// Send the pending bundle now.
+        void Flush();
+
+        /// Bind the user's handler. Called by BundleTransport before any data arrives.
+        void SetHandler(LinkHandler handler);
+
+        /// Whether the user's handler takes Packets (the inner link should lend its own).
+        [[nodiscard]] bool WantsPackets() const noexcept { return static_cast<bool>(_handler.onPacket); }
+
+        /// Unpack a datagram received by the inner link. With `packet` (owning
+        /// `data`), messages reach onPacket as slices of it, without a copy.
+        void OnInnerReceived(std::span<const std::byte> data, const Packet* packet = nullptr);
+
+        /// The inner link went down (on its own or via Disconnect()).
+        void OnInnerDisconnected();
+
+        /// The inner link drained below its low watermark.
+        void OnInnerWritable();
+
+    private:
+        /// Largest message that fits a bundle on its own.
+        [[nodiscard]] std::size_t MaxPayload() const noexcept;
+
+        /// Where the next message's length prefix goes.
+        [[nodiscard]] std::size_t NextOffset() const noexcept;
+
+        /// Commit `size` bytes written after the length prefix at `offset`,
+        /// moving them to a new bundle when they overflow the current one.
+        void Append(std::size_t offset, std::size_t size);
+
+        void SendLocked(WriteCallback writer);
+        void FlushLocked();
+        void SendSingle(WriteCallback writer);
+
+        std::shared_ptr<ILink> _inner;
+        std::shared_ptr<const Options> _options;
+        std::shared_ptr<FlushList> _flushList;
+        LinkHandler _handler;
+
+        mutable std::mutex _mutex;
+        // Room for a full bundle plus one more message written past its end
+        std::vector<std::byte> _bundle;
+        std::size_t _used = 0;  // bytes of the pending bundle, header included
+        std::size_t _count = 0; // messages in the pending bundle
+        std::deque<WriteCallback> _deferred; // SendWhenWritable() while the inner link is blocked
+        bool _enabled;
+        bool _listed = false; // in _flushList
+        bool _closed = false;
+    };
+
+    static_assert(LinkLike<BundleLink>);
+}
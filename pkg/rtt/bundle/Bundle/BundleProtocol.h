@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Rtt::Bundle
+{
+    /// Wire format of the bundling layer (lengths big-endian).
+    ///
+    ///     Single: [kind=1] payload...
+    ///     Bundle: [kind=2] ([length:16] payload)...
+    ///
+    /// A datagram carrying one message is sent as Single, so an idle link pays
+    /// one byte per message. Receivers accept both kinds whether or not their
+    /// own side bundles.
+    namespace Protocol
+    {
+        enum class Kind : std::uint8_t
+        {
+            Single = 1,
+            Bundle = 2,
+        };
+
+        inline constexpr std::size_t HeaderSize = 1;
+        inline constexpr std::size_t LengthSize = 2;
+
+        inline void WriteLength(std::span<std::byte> out, std::size_t length) noexcept
+        {
+            out[0] = static_cast<std::byte>(length >> 8);
+            out[1] = static_cast<std::byte>(length);
+        }
+
+        inline std::size_t ReadLength(std::span<const std::byte> in) noexcept
+        {
+            return (std::to_integer<std::size_t>(in[0]) << 8) | std::to_integer<std::size_t>(in[1]);
+        }
+
+        /// Call `onMessage` for every message in `datagram`, in order. Returns
+        /// false on an unknown kind or a truncated bundle; messages before the
+        /// damage have been delivered.
+        template <typename F>
+        bool Unpack(std::span<const std::byte> datagram, F&& onMessage)
+        {
+            if (datagram.size() < HeaderSize) {
+                return false;
+            }
+            const auto kind = static_cast<Kind>(datagram[0]);
+            auto rest = datagram.subspan(HeaderSize);
+            if (kind == Kind::Single) {
+                onMessage(rest);
+                return true;
+            }
+            if (kind != Kind::Bundle) {
+                return false;
+            }
+            while (!rest.empty()) {
+                if (rest.size() < LengthSize) {
+                    return false;
+                }
+                const auto length = ReadLength(rest);
+                if (rest.size() - LengthSize < length) {
+                    return false;
+                }
+                onMessage(rest.subspan(LengthSize, length));
+                rest = rest.subspan(LengthSize + length);
+            }
+            return true;
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#include "BundleTransport.h"
+
+#include "BundleProtocol.h"
+
+#include <cassert>
+#include <utility>
+
+namespace Rtt::Bundle
+{
+    namespace
+    {
+        /// Sits between the inner transport and the user's acceptor.
+        class BundleAcceptor : public ILinkAcceptor
+        {
+        public:
+            BundleAcceptor(std::shared_ptr<ILinkAcceptor> user,
+                           std::shared_ptr<const BundleLink::Options> options,
+                           std::shared_ptr<FlushList> flushList)
+                : _user(std::move(user))
+                , _options(std::move(options))
+                , _flushList(std::move(flushList))
+            {}
+
+            LinkHandler OnLink(LinkResult result) override
+            {
+                if (!result) {
+                    return _user->OnLink(std::unexpected(result.error()));
+                }
+
+                auto link = std::make_shared<BundleLink>(std::move(*result), _options, _flushList);
+                link->SetHandler(_user->OnLink(link));
+
+                // Weak: the user owns the BundleLink, the inner link only feeds it
+                std::weak_ptr<BundleLink> weak = link;
+                LinkHandler handler{
+                    .onDisconnected = [weak] {
+                        if (auto l = weak.lock()) {
+                            l->OnInnerDisconnected();
+                        }
+                    },
+                    .onWritable = [weak] {
+                        if (auto l = weak.lock()) {
+                            l->OnInnerWritable();
+                        }
+                    },
+                };
+                if (link->WantsPackets()) {
+                    // Bundled messages become slices of the inner link's packets
+                    handler.onPacket = [weak](const Packet& packet) {
+                        if (auto l = weak.lock()) {
+                            l->OnInnerReceived(packet.Span(), &packet);
+                        }
+                    };
+                } else {
+                    handler.onReceived = [weak](std::span<const std::byte> data) {
+                        if (auto l = weak.lock()) {
+                            l->OnInnerReceived(data);
+                        }
+                    };
+                }
+                return handler;
+            }
+
+        private:
+            std::shared_ptr<ILinkAcceptor> _user;
+            std::shared_ptr<const BundleLink::Options> _options;
+            std::shared_ptr<FlushList> _flushList;
+        };
+    }
+
+    BundleTransport::BundleTransport(std::shared_ptr<ITransport> inner, Options options)
+        : _inner(std::move(inner))
+        , _options(std::make_shared<const Options>(std::move(options)))
+        , _flushList(std::make_shared<FlushList>())
+    {
+        assert(_options->maxDatagramSize > Protocol::HeaderSize + Protocol::LengthSize && "BundleTransport datagrams too small");
+    }
+
+    void BundleTransport::Open(std::shared_ptr<ILinkAcceptor> acceptor)
+    {
+        _inner->Open(std::make_shared<BundleAcceptor>(std::move(acceptor), _options, _flushList));
+    }
+
+    void BundleTransport::Flush()
+    {
+        {
+            std::lock_guard lock{_flushList->mutex};
+            _flushing.swap(_flushList->links);
+        }
+        for (const auto& weak : _flushing) {
+            if (auto link = weak.lock()) {
+                link->Flush();
+            }
+        }
+        _flushing.clear();
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "BundleLink.h"
+#include "Rtt/Transport.h"
+
+#include <memory>
+#include <vector>
+
+namespace Rtt::Bundle
+{
+    /// ITransport decorator coalescing each link's small sends into shared
+    /// datagrams (see BundleLink).
+    ///
+    /// Open() opens the inner transport and wraps every link it produces in a
+    /// BundleLink before handing it to the acceptor. Bundles are sent when full
+    /// and on Flush(), which the application calls once per frame after its own
+    /// sends — add a FrameFlusher last to the frame's RunLoop handlers. Both
+    /// peers must use the decorator.
+    class BundleTransport : public ITransport
+    {
+    public:
+        using Options = BundleLink::Options;
+
+        BundleTransport(std::shared_ptr<ITransport> inner, Options options);
+
+        // ITransport
+        void Open(std::shared_ptr<ILinkAcceptor> acceptor) override;
+
+        /// Send every bundle started since the last Flush(). Costs nothing for
+        /// links that sent nothing. Call from one thread (the frame loop).
+        void Flush();
+
+    private:
+        std::shared_ptr<ITransport> _inner;
+        std::shared_ptr<const Options> _options;
+        std::shared_ptr<FlushList> _flushList;
+        std::vector<std::weak_ptr<BundleLink>> _flushing; // reused by Flush()
+    };
+
+    static_assert(TransportLike<BundleTransport>);
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "BundleTransport.h"
+#include "RunLoop/Handler.h"
+
+namespace Rtt::Bundle
+{
+    /// RunLoop handler flushing a BundleTransport once per frame.
+    ///
+    /// Add it after the handlers that send, so a frame's messages leave in the
+    /// same frame. The transport must outlive the handler.
+    class FrameFlusher : public RunLoop::Handler
+    {
+    public:
+        explicit FrameFlusher(BundleTransport& transport)
+            : _transport(transport)
+        {}
+
+        // RunLoop::Handler
+        void Update(const RunLoop::UpdateCtx&) override { _transport.Flush(); }
+
+    private:
+        BundleTransport& _transport;
+    };
+}
@@ -0,0 +1,301 @@
+#include "PacedLink.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Rtt::Pace
+{
+    // -----------------------------------------------------------------------
+    // Construction
+    // -----------------------------------------------------------------------
+
+    PacedLink::PacedLink(std::shared_ptr<ILink> inner,
+                         std::shared_ptr<const Options> options,
+                         std::shared_ptr<TransportBudget> budget)
+        : _inner(std::move(inner))
+        , _options(std::move(options))
+        , _budget(std::move(budget))
+        , _bucket(_options->rate, _options->burst)
+    {}
+
+    PacedLink::~PacedLink()
+    {
+        // Outstanding timers hold a weak_ptr and become no-ops
+        _budget->queueDepth.fetch_sub(_queue.size(), std::memory_order_relaxed);
+    }
+
+    // -----------------------------------------------------------------------
+    // ILink
+    // -----------------------------------------------------------------------
+
+    const PeerId& PacedLink::LocalId() const { return _inner->LocalId(); }
+    const PeerId& PacedLink::RemoteId() const { return _inner->RemoteId(); }
+
+    void PacedLink::Send(WriteCallback writer)
+    {
+        std::lock_guard lock{_mutex};
+        if (_closed) {
+            return;
+        }
+
+        const auto now = Clock::now();
+        if (_queue.empty() && _inner->Writable() && Ready(now)) {
+            // Within budget: the writer fills the inner link's buffer directly
+            const auto drops = InnerDrops();
+            std::size_t written = 0;
+            _inner->Send([&writer, &written](std::span<std::byte> out) {
+                written = writer(out);
+                return written;
+            });
+            if (written > 0 && InnerDrops() == drops) {
+                Consume(written, now);
+            }
+            return;
+        }
+
+        if (!Admit()) {
+            return;
+        }
+        std::vector<std::byte> packet(_options->maxMessageSize);
+        const auto written = writer(packet);
+        if (written == 0) {
+            return;
+        }
+        packet.resize(written);
+        Enqueue(std::move(packet), now);
+    }
+
+    void PacedLink::SendV(ConstBufferSequence buffers)
+    {
+        std::lock_guard lock{_mutex};
+        if (_closed) {
+            return;
+        }
+
+        const auto size = BufferSize(buffers);
+        if (size > _options->maxMessageSize) {
+            Drop();
+            return;
+        }
+
+        const auto now = Clock::now();
+        if (_queue.empty() && _inner->Writable() && Ready(now)) {
+            const auto drops = InnerDrops();
+            _inner->SendV(buffers);
+            if (InnerDrops() == drops) {
+                Consume(size, now);
+            }
+            return;
+        }
+
+        if (!Admit()) {
+            return;
+        }
+        std::vector<std::byte> packet(size);
+        GatherInto(buffers, packet);
+        Enqueue(std::move(packet), now);
+    }
+
+    void PacedLink::Disconnect()
+    {
+        {
+            std::lock_guard lock{_mutex};
+            _closed = true;
+            _budget->queueDepth.fetch_sub(_queue.size(), std::memory_order_relaxed);
+            _stats.queueDepth = 0;
+            _queue.clear();
+            _deferred.clear();
+        }
+        _inner->Disconnect();
+    }
+
+    void PacedLink::SendWhenWritable(WriteCallback writer)
+    {
+        {
+            std::lock_guard lock{_mutex};
+            if (_closed) {
+                return;
+            }
+            if (!_deferred.empty() || !_inner->Writable()) {
+                _deferred.push_back(std::move(writer));
+                return;
+            }
+        }
+        Send(std::move(writer));
+    }
+
+    LinkStats PacedLink::GetStats() const
+    {
+        auto stats = _inner->GetStats();
+        std::lock_guard lock{_mutex};
+        stats.sendDrops += _stats.dropped;
+        return stats;
+    }
+
+    bool PacedLink::Writable() const { return _inner->Writable(); }
+    std::size_t PacedLink::OutstandingBytes() const { return _inner->OutstandingBytes(); }
+
+    PacedLink::Stats PacedLink::GetPacingStats() const
+    {
+        std::lock_guard lock{_mutex};
+        return _stats;
+    }
+
+    void PacedLink::SetWritableHandler(Delegate<void()> onWritable)
+    {
+        _onWritable = std::move(onWritable);
+    }
+
+    void PacedLink::OnInnerWritable()
+    {
+        {
+            std::lock_guard lock{_mutex};
+            if (_closed) {
+                return;
+            }
+            DrainLocked(Clock::now());
+        }
+
+        // Deferred writers next, in order, each paced like a Send()
+        for (;;) {
+            WriteCallback writer;
+            {
+                std::lock_guard lock{_mutex};
+                if (_closed || _deferred.empty() || !_inner->Writable()) {
+                    break;
+                }
+                writer = std::move(_deferred.front());
+                _deferred.pop_front();
+            }
+            Send(std::move(writer));
+        }
+
+        {
+            std::lock_guard lock{_mutex};
+            if (_closed || !_deferred.empty()) {
+                return;
+            }
+        }
+        if (_onWritable) {
+            _onWritable();
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    // Budget
+    // -----------------------------------------------------------------------
+
+    bool PacedLink::Ready(Clock::time_point now)
+    {
+        if (!_bucket.Ready(now)) {
+            return false;
+        }
+        std::lock_guard lock{_budget->mutex};
+        return _budget->bucket.Ready(now);
+    }
+
+    PacedLink::Clock::time_point PacedLink::ReadyAt(Clock::time_point now)
+    {
+        const auto link = _bucket.ReadyAt(now);
+        std::lock_guard lock{_budget->mutex};
+        return std::max(link, _budget->bucket.ReadyAt(now));
+    }
+
+    void PacedLink::Consume(std::size_t bytes, Clock::time_point now)
+    {
+        _bucket.Consume(bytes, now);
+        {
+            std::lock_guard lock{_budget->mutex};
+            _budget->bucket.Consume(bytes, now);
+        }
+        ++_stats.sent;
+        _budget->sent.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool PacedLink::Admit()
+    {
+        if (_options->overLimit == OverLimit::Queue && _queue.size() < _options->maxQueued) {
+            return true;
+        }
+        Drop();
+        return false;
+    }
+
+    void PacedLink::Drop()
+    {
+        ++_stats.dropped;
+        _budget->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::uint64_t PacedLink::InnerDrops() const
+    {
+        // The inner link counts what it refuses (closed, oversized, ...); those
+        // are its drops, reported through GetStats(), and are not charged here
+        return _inner->GetStats().sendDrops;
+    }
+
+    // -----------------------------------------------------------------------
+    // Queue
+    // -----------------------------------------------------------------------
+
+    void PacedLink::Enqueue(std::vector<std::byte> packet, Clock::time_point now)
+    {
+        _queue.push_back(std::move(packet));
+        ++_stats.queued;
+        _stats.queueDepth = _queue.size();
+        _budget->queued.fetch_add(1, std::memory_order_relaxed);
+        _budget->queueDepth.fetch_add(1, std::memory_order_relaxed);
+        ArmTimer(ReadyAt(now));
+    }
+
+    void PacedLink::ArmTimer(Clock::time_point deadline)
+    {
+        // Same scheme as Rel::RelLink: timers are never cancelled, a stale one
+        // finds the queue empty or the budget still in debt and re-arms.
+        if (_armedAt && *_armedAt <= deadline) {
+            return;
+        }
+        _armedAt = deadline;
+        std::weak_ptr<PacedLink> weak = std::static_pointer_cast<PacedLink>(shared_from_this());
+        _options->timers->ScheduleAt(deadline, [weak, deadline] {
+            if (auto self = weak.lock()) {
+                self->Drain(deadline);
+            }
+        });
+    }
+
+    void PacedLink::Drain(Clock::time_point deadline)
+    {
+        std::lock_guard lock{_mutex};
+        if (_armedAt == deadline) {
+            _armedAt.reset();
+        }
+        if (!_closed) {
+            DrainLocked(Clock::now());
+        }
+    }
+
+    void PacedLink::DrainLocked(Clock::time_point now)
+    {
+        // Only packets the inner link accepts count as sent and are charged
+        std::size_t drained = 0;
+        while (!_queue.empty() && _inner->Writable() && Ready(now)) {
+            const auto& packet = _queue.front();
+            const std::span<const std::byte> parts[] = {packet};
+            const auto drops = InnerDrops();
+            _inner->SendV(parts);
+            if (InnerDrops() == drops) {
+                Consume(packet.size(), now);
+            }
+            _queue.pop_front();
+            ++drained;
+        }
+        _stats.queueDepth = _queue.size();
+        _budget->queueDepth.fetch_sub(drained, std::memory_order_relaxed);
+
+        // A blocked inner link resumes the queue from OnInnerWritable() instead
+        if (!_queue.empty() && _inner->Writable()) {
+            ArmTimer(ReadyAt(now));
+        }
+    }
+}
@@ -0,0 +1,170 @@
+#pragma once
+#include "Exec/Delay/LoopTimerBackend.h"
+#include "Rtt/Delegate.h"
+#include "Rtt/Link.h"
+#include "TokenBucket.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace Rtt::Pace
+{
+    /// What a PacedLink does with a packet sent over its budget.
+    enum class OverLimit : std::uint8_t
+    {
+        /// Copy it into the link's queue and send it when tokens are available;
+        /// drop it if the queue is full.
+        Queue,
+
+        /// Drop it without calling the writer.
+        Drop,
+    };
+
+    /// Packet counters of a paced link or, summed, of a PacedTransport.
+    struct PacingStats
+    {
+        /// Packets handed to the inner link.
+        std::uint64_t sent = 0;
+
+        /// Packets that had to wait in a queue (also counted in `sent` once out).
+        std::uint64_t queued = 0;
+
+        /// Packets dropped over budget or on a full queue.
+        std::uint64_t dropped = 0;
+
+        /// Packets waiting right now.
+        std::size_t queueDepth = 0;
+    };
+
+    /// Token bucket and counters shared by all links of one PacedTransport.
+    struct TransportBudget
+    {
+        std::mutex mutex;
+        TokenBucket bucket; // guarded by mutex
+
+        std::atomic<std::uint64_t> sent{0};
+        std::atomic<std::uint64_t> queued{0};
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<std::size_t> queueDepth{0};
+    };
+
+    /// Link decorator pacing outbound packets through token buckets.
+    ///
+    /// A packet goes straight to the inner link, with no copy, while both the
+    /// link's bucket and the transport's shared bucket are out of debt; its size
+    /// is debited once the inner link has taken it (see TokenBucket), so
+    /// messages the inner link drops cost nothing. Over budget, or while the inner
+    /// link is not Writable(), it is queued or dropped per OverLimit. The queue
+    /// is drained from LoopTimerBackend timers as tokens refill and stops while
+    /// the inner link is blocked; the inner link's onWritable resumes it.
+    /// Receiving is not affected.
+    ///
+    /// Threading follows the decorator contract on ILink; queue draining is
+    /// the timer-driven send.
+    class PacedLink : public ILink
+    {
+    public:
+        struct Options
+        {
+            /// Drives queue draining.
+            Exec::LoopTimerBackend* timers = nullptr;
+
+            /// Bytes per second per link. 0 = unlimited.
+            std::uint64_t rate = 0;
+
+            /// Bytes a link may send back to back after being idle.
+            std::size_t burst = 16 * 1024;
+
+            /// Bytes per second shared by all links of the transport. 0 = unlimited.
+            std::uint64_t transportRate = 0;
+
+            /// Burst of the shared transport bucket.
+            std::size_t transportBurst = 64 * 1024;
+
+            /// Policy for packets over budget.
+            OverLimit overLimit = OverLimit::Queue;
+
+            /// Packets queued per link before new ones are dropped.
+            std::size_t maxQueued = 256;
+
+            /// Largest message SendV() accepts, and the buffer handed to the
+            /// writer of a packet that is queued. Larger ones are dropped.
+            std::size_t maxMessageSize = 1472;
+        };
+
+        using Stats = PacingStats;
+
+        PacedLink(std::shared_ptr<ILink> inner,
+                  std::shared_ptr<const Options> options,
+                  std::shared_ptr<TransportBudget> budget);
+        ~PacedLink() override;
+
+        PacedLink(const PacedLink&) = delete;
+        PacedLink& operator=(const PacedLink&) = delete;
+
+        // ILink
+        [[nodiscard]] const PeerId& LocalId() const override;
+        [[nodiscard]] const PeerId& RemoteId() const override;
+        void Send(WriteCallback writer) override;
+        void SendV(ConstBufferSequence buffers) override;
+        void Disconnect() override;
+
+        /// Waits for the inner link to be Writable(), then sends like Send(),
+        /// so the message is still paced.
+        void SendWhenWritable(WriteCallback writer) override;
+
+        /// The inner link's traffic; packets dropped here count as sendDrops.
+        [[nodiscard]] LinkStats GetStats() const override;
+
+        /// Backpressure is the inner link's; the pacing queue has its own bound (maxQueued).
+        [[nodiscard]] bool Writable() const override;
+        [[nodiscard]] std::size_t OutstandingBytes() const override;
+
+        [[nodiscard]] Stats GetPacingStats() const;
+
+        /// Bind the user's onWritable. Called by PacedTransport; the rest of the
+        /// user's handler goes to the inner link as is.
+        void SetWritableHandler(Delegate<void()> onWritable);
+
+        /// The inner link drained below its low watermark: resume the queue and
+        /// deferred writers, then tell the user.
+        void OnInnerWritable();
+
+    private:
+        using Clock = TokenBucket::Clock;
+
+        [[nodiscard]] bool Ready(Clock::time_point now);
+        [[nodiscard]] Clock::time_point ReadyAt(Clock::time_point now);
+        void Consume(std::size_t bytes, Clock::time_point now);
+        [[nodiscard]] bool Admit();
+        void Drop();
+        [[nodiscard]] std::uint64_t InnerDrops() const;
+        void Enqueue(std::vector<std::byte> packet, Clock::time_point now);
+        void Drain(Clock::time_point deadline);
+        void DrainLocked(Clock::time_point now);
+        void ArmTimer(Clock::time_point deadline);
+
+        std::shared_ptr<ILink> _inner;
+        std::shared_ptr<const Options> _options;
+        std::shared_ptr<TransportBudget> _budget;
+
+        mutable std::mutex _mutex;
+        TokenBucket _bucket;
+        std::deque<std::vector<std::byte>> _queue;
+        std::deque<WriteCallback> _deferred; // SendWhenWritable() while the inner link is blocked
+        std::optional<Clock::time_point> _armedAt; // earliest outstanding timer
+        Stats _stats;
+        bool _closed = false;
+
+        Delegate<void()> _onWritable;
+    };
+
+    static_assert(LinkLike<PacedLink>);
+}
@@ -0,0 +1,73 @@
+#include "PacedTransport.h"
+
+#include <cassert>
+#include <utility>
+
+namespace Rtt::Pace
+{
+    namespace
+    {
+        /// Sits between the inner transport and the user's acceptor.
+        class PacedAcceptor : public ILinkAcceptor
+        {
+        public:
+            PacedAcceptor(std::shared_ptr<ILinkAcceptor> user,
+                          std::shared_ptr<const PacedLink::Options> options,
+                          std::shared_ptr<TransportBudget> budget)
+                : _user(std::move(user))
+                , _options(std::move(options))
+                , _budget(std::move(budget))
+            {}
+
+            LinkHandler OnLink(LinkResult result) override
+            {
+                if (!result) {
+                    return _user->OnLink(std::unexpected(result.error()));
+                }
+
+                auto link = std::make_shared<PacedLink>(std::move(*result), _options, _budget);
+                auto handler = _user->OnLink(link);
+
+                // Only sends are paced, so the user's handler goes to the inner link
+                // as is, except onWritable: the link resumes its queue first
+                link->SetWritableHandler(std::move(handler.onWritable));
+                std::weak_ptr<PacedLink> weak = link;
+                handler.onWritable = [weak] {
+                    if (auto l = weak.lock()) {
+                        l->OnInnerWritable();
+                    }
+                };
+                return handler;
+            }
+
+        private:
+            std::shared_ptr<ILinkAcceptor> _user;
+            std::shared_ptr<const PacedLink::Options> _options;
+            std::shared_ptr<TransportBudget> _budget;
+        };
+    }
+
+    PacedTransport::PacedTransport(std::shared_ptr<ITransport> inner, Options options)
+        : _inner(std::move(inner))
+        , _options(std::make_shared<const Options>(std::move(options)))
+        , _budget(std::make_shared<TransportBudget>())
+    {
+        assert(_options->timers && "PacedTransport requires a timer backend");
+        _budget->bucket = TokenBucket(_options->transportRate, _options->transportBurst);
+    }
+
+    void PacedTransport::Open(std::shared_ptr<ILinkAcceptor> acceptor)
+    {
+        _inner->Open(std::make_shared<PacedAcceptor>(std::move(acceptor), _options, _budget));
+    }
+
+    PacingStats PacedTransport::GetPacingStats() const
+    {
+        return PacingStats{
+            .sent = _budget->sent.load(std::memory_order_relaxed),
+            .queued = _budget->queued.load(std::memory_order_relaxed),
+            .dropped = _budget->dropped.load(std::memory_order_relaxed),
+            .queueDepth = _budget->queueDepth.load(std::memory_order_relaxed),
+        };
+    }
+}
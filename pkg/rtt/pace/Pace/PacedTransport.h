@@ -0,0 +1,36 @@
+#pragma once
+#include "PacedLink.h"
+#include "Rtt/Transport.h"
+
+#include <memory>
+
+namespace Rtt::Pace
+{
+    /// ITransport decorator rate limiting the links of an inner transport.
+    ///
+    /// Open() opens the inner transport and wraps every link it produces in a
+    /// PacedLink before handing it to the acceptor. Each link gets its own
+    /// bucket (Options::rate / burst) and all of them share the transport bucket
+    /// (Options::transportRate / transportBurst). Inbound data reaches the user's
+    /// handler unchanged, and only the sending side needs the decorator.
+    class PacedTransport : public ITransport
+    {
+    public:
+        using Options = PacedLink::Options;
+
+        PacedTransport(std::shared_ptr<ITransport> inner, Options options);
+
+        // ITransport
+        void Open(std::shared_ptr<ILinkAcceptor> acceptor) override;
+
+        /// Totals over all links opened so far; queueDepth counts live links only.
+        [[nodiscard]] PacingStats GetPacingStats() const;
+
+    private:
+        std::shared_ptr<ITransport> _inner;
+        std::shared_ptr<const Options> _options;
+        std::shared_ptr<TransportBudget> _budget;
+    };
+
+    static_assert(TransportLike<PacedTransport>);
+}
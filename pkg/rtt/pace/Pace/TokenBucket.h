@@ -0,0 +1,76 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Rtt::Pace
+{
+    /// Byte-rate token bucket that may go into debt.
+    ///
+    /// Tokens refill at `rate` bytes per second up to `burst`. A packet may be
+    /// sent whenever the balance is not negative; its size is then debited in
+    /// full, possibly below zero. The debt delays the next packet instead of
+    /// requiring the exact size up front, so the sender never has to know a
+    /// packet's size before writing it.
+    ///
+    /// rate == 0 means unlimited. Not thread-safe.
+    class TokenBucket
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        TokenBucket() = default;
+        TokenBucket(std::uint64_t rate, std::size_t burst, Clock::time_point now = Clock::now()) noexcept
+            : _rate(static_cast<double>(rate))
+            , _burst(static_cast<double>(burst))
+            , _tokens(static_cast<double>(burst))
+            , _updated(now)
+        {}
+
+        [[nodiscard]] bool Unlimited() const noexcept { return _rate <= 0.0; }
+
+        /// True if a packet may be sent at `now`.
+        [[nodiscard]] bool Ready(Clock::time_point now) noexcept
+        {
+            Refill(now);
+            return Unlimited() || _tokens >= 0.0;
+        }
+
+        /// Debit a sent packet.
+        void Consume(std::size_t bytes, Clock::time_point now) noexcept
+        {
+            if (!Unlimited()) {
+                Refill(now);
+                _tokens -= static_cast<double>(bytes);
+            }
+        }
+
+        /// Earliest time Ready() turns true (`now` if it already is).
+        [[nodiscard]] Clock::time_point ReadyAt(Clock::time_point now) noexcept
+        {
+            Refill(now);
+            if (Unlimited() || _tokens >= 0.0) {
+                return now;
+            }
+            const std::chrono::duration<double> wait{-_tokens / _rate};
+            return now + std::chrono::ceil<Clock::duration>(wait);
+        }
+
+    private:
+        void Refill(Clock::time_point now) noexcept
+        {
+            if (now <= _updated) {
+                return;
+            }
+            const std::chrono::duration<double> elapsed = now - _updated;
+            _tokens = std::min(_burst, _tokens + elapsed.count() * _rate);
+            _updated = now;
+        }
+
+        double _rate = 0.0;
+        double _burst = 0.0;
+        double _tokens = 0.0;
+        Clock::time_point _updated;
+    };
+}
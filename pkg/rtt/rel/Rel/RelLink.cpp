@@ -0,0 +1,441 @@
+#include "RelLink.h"
+
+#include "Log/Log.h"
+#include "Rtt/SendScratch.h"
+#include <algorithm>
+#include <utility>
+
+namespace Rtt::Rel
+{
+    using namespace Protocol;
+
+    // -----------------------------------------------------------------------
+    // Construction
+    // -----------------------------------------------------------------------
+
+    RelLink::RelLink(std::shared_ptr<ILink> inner, std::shared_ptr<const Options> options)
+        : _inner(std::move(inner))
+        , _options(std::move(options))
+        , _localId(_inner->LocalId())
+        , _remoteId(_inner->RemoteId())
+    {
+        const auto count = std::min<std::size_t>(_options->channels.size(), 256);
+        _channels.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto& ch = _channels[i];
+            ch.delivery = _options->channels[i];
+            ch.inFlight.resize(Window);
+            ch.received.resize(Window);
+            if (ch.delivery == Delivery::Ordered) {
+                ch.pending.resize(Window);
+            }
+        }
+    }
+
+    RelLink::~RelLink()
+    {
+        // Outstanding timers hold a weak_ptr and become no-ops
+        if (_inner) {
+            _inner->Disconnect();
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    // ILink
+    // -----------------------------------------------------------------------
+
+    const PeerId& RelLink::LocalId() const { return _localId; }
+    const PeerId& RelLink::RemoteId() const { return _remoteId; }
+
+    void RelLink::Send(WriteCallback writer)
+    {
+        Send(0, std::move(writer));
+    }
+
+    std::size_t RelLink::ChannelCount() const
+    {
+        return _channels.size(); // sized once in the constructor
+    }
+
+    void RelLink::Send(ChannelId channel, WriteCallback writer)
+    {
+        std::vector<std::byte> packet;
+        {
+            SendScratch scratch{_options->maxMessageSize};
+            const auto payload = scratch.Span();
+            const auto written = writer(payload);
+            if (written == 0) {
+                return;
+            }
+            // Kept at its real size until acknowledged; the header is written by Transmit()
+            packet.resize(DataHeaderSize + written);
+            std::copy_n(payload.begin(), written, packet.begin() + DataHeaderSize);
+        }
+
+        std::lock_guard lock{_mutex};
+        if (_closed || channel >= _channels.size()) {
+            return;
+        }
+        auto& ch = _channels[channel];
+        if (SeqDistance(ch.sendBase, ch.nextSeq) >= Window) {
+            if (BacklogFull(ch)) {
+                ++_stats.dropped;
+                Log::Trace("backlog full on channel {}, dropping message {} -> {}", channel, _localId.value, _remoteId.value);
+                return;
+            }
+            ch.backlog.push_back(std::move(packet));
+            if (BacklogFull(ch)) {
+                _fullBacklogs.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+        Transmit(channel, ch, std::move(packet));
+    }
+
+    void RelLink::SendWhenWritable(WriteCallback writer)
+    {
+        {
+            std::lock_guard lock{_mutex};
+            if (_closed) {
+                return;
+            }
+            if (!_deferred.empty() || !Writable()) {
+                _deferred.push_back(std::move(writer));
+                return;
+            }
+        }
+        Send(0, std::move(writer));
+    }
+
+    void RelLink::Disconnect()
+    {
+        std::shared_ptr<ILink> inner;
+        {
+            std::lock_guard lock{_mutex};
+            if (_closed) {
+                return;
+            }
+            _closed = true;
+            _deferred.clear();
+            inner = _inner;
+        }
+        Log::Trace("disconnect {} -> {}", _localId.value, _remoteId.value);
+        // The inner link reports back through OnInnerDisconnected()
+        inner->Disconnect();
+    }
+
+    void RelLink::SetHandler(LinkHandler handler)
+    {
+        _handler = std::move(handler);
+    }
+
+    LinkStats RelLink::GetStats() const
+    {
+        return _inner ? _inner->GetStats() : LinkStats{};
+    }
+
+    bool RelLink::Writable() const
+    {
+        return _fullBacklogs.load(std::memory_order_relaxed) == 0 && (!_inner || _inner->Writable());
+    }
+
+    std::size_t RelLink::OutstandingBytes() const
+    {
+        return _inner ? _inner->OutstandingBytes() : 0;
+    }
+
+    auto RelLink::GetReliabilityStats() const -> Stats
+    {
+        std::lock_guard lock{_mutex};
+        return _stats;
+    }
+
+    // -----------------------------------------------------------------------
+    // Send path
+    // -----------------------------------------------------------------------
+
+    void RelLink::Transmit(std::uint8_t channelId, Channel& ch, std::vector<std::byte> packet)
+    {
+        const auto seq = ch.nextSeq++;
+        WriteDataHeader(packet, {.channel = channelId, .seq = seq});
+
+        auto& slot = ch.inFlight[seq % Window];
+        slot = Outgoing{
+            .packet = std::move(packet),
+            .deadline = Clock::now() + RetransmitDelay(0),
+            .retries = 0,
+        };
+        ++_stats.sent;
+
+        const std::span<const std::byte> parts[] = {slot->packet};
+        _inner->SendV(parts);
+        ArmTimer(slot->deadline);
+    }
+
+    void RelLink::PromoteBacklog(std::uint8_t channelId, Channel& ch, Deferred& out)
+    {
+        const bool wasFull = BacklogFull(ch);
+        while (!ch.backlog.empty() && SeqDistance(ch.sendBase, ch.nextSeq) < Window) {
+            auto packet = std::move(ch.backlog.front());
+            ch.backlog.pop_front();
+            Transmit(channelId, ch, std::move(packet));
+        }
+        if (wasFull && !BacklogFull(ch)) {
+            out.writable = _fullBacklogs.fetch_sub(1, std::memory_order_relaxed) == 1;
+        }
+    }
+
+    bool RelLink::BacklogFull(const Channel& ch) const noexcept
+    {
+        return _options->maxBacklog > 0 && ch.backlog.size() >= _options->maxBacklog;
+    }
+
+    auto RelLink::RetransmitDelay(std::uint32_t retries) const -> Clock::duration
+    {
+        auto delay = std::chrono::duration_cast<Clock::duration>(_options->retransmitTimeout);
+        const auto limit = std::chrono::duration_cast<Clock::duration>(_options->maxRetransmitTimeout);
+        for (std::uint32_t i = 0; i < retries && delay < limit; ++i) {
+            delay *= 2;
+        }
+        return std::min(delay, limit);
+    }
+
+    // -----------------------------------------------------------------------
+    // Receive path
+    // -----------------------------------------------------------------------
+
+    void RelLink::OnInnerReceived(std::span<const std::byte> data)
+    {
+        const auto kind = ReadKind(data);
+        if (!kind) {
+            Log::Trace("malformed packet ({} bytes) from {}", data.size(), _remoteId.value);
+            return;
+        }
+
+        Deferred deferred;
+        {
+            std::lock_guard lock{_mutex};
+            if (_closed) {
+                return;
+            }
+            if (*kind == Kind::Data) {
+                HandleData(data, deferred);
+            } else {
+                HandleAck(ReadAck(data), deferred);
+            }
+        }
+        Deliver(deferred);
+    }
+
+    void RelLink::HandleData(std::span<const std::byte> data, Deferred& out)
+    {
+        const auto header = ReadDataHeader(data);
+        if (header.channel >= _channels.size()) {
+            return;
+        }
+        auto& ch = _channels[header.channel];
+        const auto payload = data.subspan(DataHeaderSize);
+
+        const auto distance = SeqDistance(ch.recvNext, header.seq);
+        if (!SeqLess(header.seq, ch.recvNext) && distance >= Window) {
+            return; // beyond the reorder window: the sender will retry
+        }
+        if (SeqLess(header.seq, ch.recvNext) || (distance > 0 && ch.received[header.seq % Window])) {
+            // Already received: our previous ack was lost, repeat it
+            ++_stats.duplicates;
+            SendAck(header.channel, ch);
+            return;
+        }
+
+        if (distance == 0) {
+            out.direct = payload;
+            ++ch.recvNext;
+            // Close the gap: release what arrived ahead of it
+            while (ch.received[ch.recvNext % Window]) {
+                const auto index = ch.recvNext % Window;
+                ch.received[index] = false;
+                if (ch.delivery == Delivery::Ordered) {
+                    out.buffered.push_back(std::move(ch.pending[index]));
+                    ch.pending[index] = {};
+                }
+                ++ch.recvNext;
+            }
+        } else {
+            const auto index = header.seq % Window;
+            ch.received[index] = true;
+            if (ch.delivery == Delivery::Ordered) {
+                ch.pending[index].assign(payload.begin(), payload.end());
+            } else {
+                out.direct = payload;
+            }
+        }
+        _stats.delivered += (out.direct ? 1 : 0) + out.buffered.size();
+        SendAck(header.channel, ch);
+    }
+
+    void RelLink::SendAck(std::uint8_t channelId, const Channel& ch)
+    {
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < AckMaskBits; ++i) {
+            if (ch.received[(ch.recvNext + 1 + i) % Window]) {
+                mask |= 1U << i;
+            }
+        }
+        std::array<std::byte, AckSize> packet{};
+        WriteAck(packet, {.channel = channelId, .next = ch.recvNext, .mask = mask});
+        const std::span<const std::byte> parts[] = {packet};
+        _inner->SendV(parts);
+    }
+
+    void RelLink::HandleAck(const Ack& ack, Deferred& out)
+    {
+        if (ack.channel >= _channels.size()) {
+            return;
+        }
+        auto& ch = _channels[ack.channel];
+
+        for (auto seq = ch.sendBase; seq != ch.nextSeq; ++seq) {
+            auto& slot = ch.inFlight[seq % Window];
+            if (!slot) {
+                continue;
+            }
+            const auto ahead = SeqDistance(ack.next, seq);
+            const bool acked = SeqLess(seq, ack.next) ||
+                               (ahead >= 1 && ahead <= AckMaskBits && (ack.mask >> (ahead - 1)) & 1U);
+            if (acked) {
+                slot.reset();
+            }
+        }
+        while (ch.sendBase != ch.nextSeq && !ch.inFlight[ch.sendBase % Window]) {
+            ++ch.sendBase;
+        }
+        PromoteBacklog(ack.channel, ch, out);
+    }
+
+    void RelLink::Deliver(Deferred& deferred)
+    {
+        if (deferred.direct) {
+            Rtt::Deliver(_handler, *deferred.direct);
+        }
+        for (auto& message : deferred.buffered) {
+            Rtt::Deliver(_handler, std::move(message));
+        }
+        if (deferred.writable && SendDeferred() && Writable() && _handler.onWritable) {
+            _handler.onWritable();
+        }
+        if (deferred.disconnect) {
+            Disconnect();
+        }
+    }
+
+    void RelLink::OnInnerDisconnected()
+    {
+        {
+            std::lock_guard lock{_mutex};
+            _closed = true;
+            _deferred.clear();
+            if (std::exchange(_disconnectNotified, true)) {
+                return;
+            }
+        }
+        if (_handler.onDisconnected) {
+            _handler.onDisconnected();
+        }
+    }
+
+    void RelLink::OnInnerWritable()
+    {
+        if (SendDeferred() && Writable() && _handler.onWritable) {
+            _handler.onWritable();
+        }
+    }
+
+    bool RelLink::SendDeferred()
+    {
+        // In order, outside the lock: Send() takes it and runs the writer
+        for (;;) {
+            WriteCallback writer;
+            {
+                std::lock_guard lock{_mutex};
+                if (_closed || !Writable()) {
+                    return false;
+                }
+                if (_deferred.empty()) {
+                    return true;
+                }
+                writer = std::move(_deferred.front());
+                _deferred.pop_front();
+            }
+            Send(0, std::move(writer));
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    // Retransmission
+    // -----------------------------------------------------------------------
+
+    void RelLink::ArmTimer(Clock::time_point deadline)
+    {
+        // Timers are never cancelled: an earlier deadline adds a timer, a stale
+        // one just rescans. Cancel() could block on an in-flight callback that
+        // waits for our mutex.
+        if (_armedAt && *_armedAt <= deadline) {
+            return;
+        }
+        _armedAt = deadline;
+        std::weak_ptr<RelLink> weak = std::static_pointer_cast<RelLink>(shared_from_this());
+        _options->timers->ScheduleAt(deadline, [weak, deadline] {
+            if (auto self = weak.lock()) {
+                self->OnTimer(deadline);
+            }
+        });
+    }
+
+    void RelLink::OnTimer(Clock::time_point deadline)
+    {
+        Deferred deferred;
+        {
+            std::lock_guard lock{_mutex};
+            if (_armedAt == deadline) {
+                _armedAt.reset();
+            }
+            if (_closed) {
+                return;
+            }
+
+            const auto now = Clock::now();
+            std::optional<Clock::time_point> next;
+            for (auto& ch : _channels) {
+                if (deferred.disconnect) {
+                    break; // given up: no more resends on any channel
+                }
+                for (auto seq = ch.sendBase; seq != ch.nextSeq; ++seq) {
+                    auto& slot = ch.inFlight[seq % Window];
+                    if (!slot) {
+                        continue;
+                    }
+                    if (slot->deadline <= now) {
+                        if (slot->retries >= _options->maxRetransmits) {
+                            Log::Debug("no ack after {} retransmits, disconnecting {} -> {}",
+                                       slot->retries, _localId.value, _remoteId.value);
+                            deferred.disconnect = true;
+                            break;
+                        }
+                        ++slot->retries;
+                        ++_stats.retransmitted;
+                        slot->deadline = now + RetransmitDelay(slot->retries);
+                        const std::span<const std::byte> parts[] = {slot->packet};
+                        _inner->SendV(parts);
+                    }
+                    if (!next || slot->deadline < *next) {
+                        next = slot->deadline;
+                    }
+                }
+            }
+            if (next && !deferred.disconnect) {
+                ArmTimer(*next);
+            }
+        }
+        Deliver(deferred);
+    }
+}
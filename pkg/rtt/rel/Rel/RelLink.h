@@ -0,0 +1,213 @@
+#pragma once
+#include "Exec/Delay/LoopTimerBackend.h"
+#include "RelProtocol.h"
+#include "Rtt/Handler.h"
+#include "Rtt/Link.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Rtt::Rel
+{
+    /// Delivery order of one reliable channel.
+    enum class Delivery : std::uint8_t
+    {
+        /// Messages are handed over in send order; later arrivals wait for gaps.
+        Ordered,
+
+        /// Messages are handed over as soon as they arrive, each exactly once.
+        Unordered,
+    };
+
+    /// Reliable link over an unreliable one (e.g. a UdpLink).
+    ///
+    /// Every message gets a per-channel sequence number and is kept until the
+    /// peer acknowledges it. The receiver answers each data packet with an Ack
+    /// carrying its cumulative position plus a 32-bit selective bitmap, so one
+    /// lost packet does not hold back acknowledgement of the ones after it.
+    /// Unacknowledged packets are resent from LoopTimerBackend timers with
+    /// exponential backoff; after `maxRetransmits` resends of one packet the
+    /// link is considered dead and disconnected.
+    ///
+    /// A channel keeps at most Protocol::Window packets in flight; further
+    /// messages wait in its backlog. A backlog holds at most `maxBacklog`
+    /// messages: while one is full the link is not Writable(), Send() on that
+    /// channel drops (counted in Stats::dropped) and SendWhenWritable() waits,
+    /// and onWritable fires once acknowledgements drain it.
+    ///
+    /// Threading follows the decorator contract on ILink; retransmits are the
+    /// timer-driven sends. A sharded UdpServer's links, which live on their
+    /// own threads, cannot be wrapped.
+    ///
+    /// The link stays alive while the user holds it; destroying it disconnects
+    /// the inner link.
+    class RelLink : public ILink
+    {
+    public:
+        struct Options
+        {
+            /// Drives retransmissions.
+            Exec::LoopTimerBackend* timers = nullptr;
+
+            /// Channel delivery modes, indexed by channel id (at most 256).
+            /// Send(writer) uses channel 0.
+            std::vector<Delivery> channels{Delivery::Ordered};
+
+            /// Largest payload accepted by Send(); the inner link must carry
+            /// `maxMessageSize + Protocol::DataHeaderSize` bytes.
+            std::size_t maxMessageSize = 1200;
+
+            /// First retransmission delay; doubled on every resend of a packet.
+            std::chrono::milliseconds retransmitTimeout{100};
+
+            /// Upper bound for the backed-off retransmission delay.
+            std::chrono::milliseconds maxRetransmitTimeout{2000};
+
+            /// Resends of one packet before the link is disconnected.
+            std::uint32_t maxRetransmits = 10;
+
+            /// Messages per channel waiting for window space. 0 = unlimited.
+            std::size_t maxBacklog = 1024;
+        };
+
+        struct Stats
+        {
+            /// Data packets sent for the first time.
+            std::uint64_t sent = 0;
+
+            /// Data packets sent again after a timeout.
+            std::uint64_t retransmitted = 0;
+
+            /// Messages handed to the user's onReceived.
+            std::uint64_t delivered = 0;
+
+            /// Data packets received more than once (acknowledged again, not delivered).
+            std::uint64_t duplicates = 0;
+
+            /// Messages refused by Send() because their channel's backlog was full.
+            std::uint64_t dropped = 0;
+        };
+
+        RelLink(std::shared_ptr<ILink> inner, std::shared_ptr<const Options> options);
+        ~RelLink() override;
+
+        RelLink(const RelLink&) = delete;
+        RelLink& operator=(const RelLink&) = delete;
+
+        // ILink
+        [[nodiscard]] const PeerId& LocalId() const override;
+        [[nodiscard]] const PeerId& RemoteId() const override;
+        void Send(WriteCallback writer) override;
+        void Disconnect() override;
+
+        /// The inner link's traffic, which includes acks and retransmissions.
+        [[nodiscard]] LinkStats GetStats() const override;
+
+        /// The inner link's backpressure, plus full backlogs (see above).
+        /// Packets refused by the inner link are resent like lost ones.
+        [[nodiscard]] bool Writable() const override;
+        [[nodiscard]] std::size_t OutstandingBytes() const override;
+
+        /// Options::channels.size().
+        [[nodiscard]] std::size_t ChannelCount() const override;
+
+        /// Send one reliable message on `channel`. Invalid channels are ignored.
+        void Send(ChannelId channel, WriteCallback writer) override;
+
+        /// Send on channel 0 once the link is Writable(): deferred writers wait
+        /// for a full backlog or a blocked inner link to drain.
+        void SendWhenWritable(WriteCallback writer) override;
+
+        /// Bind the user's handler. Called by RelTransport before any data arrives.
+        void SetHandler(LinkHandler handler);
+
+        /// Feed a datagram received by the inner link.
+        void OnInnerReceived(std::span<const std::byte> data);
+
+        /// The inner link went down (on its own or via Disconnect()).
+        void OnInnerDisconnected();
+
+        /// The inner link drained below its low watermark.
+        void OnInnerWritable();
+
+        [[nodiscard]] Stats GetReliabilityStats() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+        using Seq = Protocol::Seq;
+
+        struct Outgoing
+        {
+            std::vector<std::byte> packet; // header + payload, kept for resends
+            Clock::time_point deadline;
+            std::uint32_t retries = 0;
+        };
+
+        struct Channel
+        {
+            Delivery delivery = Delivery::Ordered;
+
+            // Sender: [sendBase, nextSeq) are in flight, acked slots are reset
+            Seq nextSeq = 0;
+            Seq sendBase = 0;
+            std::vector<std::optional<Outgoing>> inFlight;
+            std::deque<std::vector<std::byte>> backlog; // waiting for window space, at most maxBacklog
+
+            // Receiver: everything before recvNext has arrived
+            Seq recvNext = 0;
+            std::vector<bool> received;                  // arrived ahead of recvNext
+            std::vector<std::vector<std::byte>> pending; // Ordered: payloads waiting for a gap
+        };
+
+        /// Work collected under the lock and run after releasing it.
+        struct Deferred
+        {
+            std::optional<std::span<const std::byte>> direct; // in-place payload, delivered first
+            std::vector<std::vector<std::byte>> buffered;
+            bool disconnect = false;
+            bool writable = false; // the last full backlog drained
+        };
+
+        void Transmit(std::uint8_t channelId, Channel& ch, std::vector<std::byte> packet);
+        void HandleData(std::span<const std::byte> data, Deferred& out);
+        void HandleAck(const Protocol::Ack& ack, Deferred& out);
+        void SendAck(std::uint8_t channelId, const Channel& ch);
+        void PromoteBacklog(std::uint8_t channelId, Channel& ch, Deferred& out);
+        [[nodiscard]] bool BacklogFull(const Channel& ch) const noexcept;
+        void OnTimer(Clock::time_point deadline);
+        void ArmTimer(Clock::time_point deadline);
+        [[nodiscard]] Clock::duration RetransmitDelay(std::uint32_t retries) const;
+        void Deliver(Deferred& deferred);
+
+        /// Run deferred writers while Writable(); true once none are left.
+        [[nodiscard]] bool SendDeferred();
+
+        std::shared_ptr<ILink> _inner;
+        std::shared_ptr<const Options> _options;
+        PeerId _localId;
+        PeerId _remoteId;
+
+        mutable std::mutex _mutex;
+        std::vector<Channel> _channels;
+        std::optional<Clock::time_point> _armedAt; // earliest outstanding timer
+        std::deque<WriteCallback> _deferred;       // SendWhenWritable() while not Writable()
+        std::atomic<std::size_t> _fullBacklogs{0}; // read by Writable() without the lock
+        Stats _stats;
+        bool _closed = false;
+
+        bool _disconnectNotified = false;
+
+        LinkHandler _handler;
+    };
+
+    static_assert(LinkLike<RelLink>);
+}
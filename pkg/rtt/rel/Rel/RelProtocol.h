@@ -0,0 +1,117 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace Rtt::Rel
+{
+    /// Wire format of the reliability layer (all integers big-endian).
+    ///
+    ///     Data: [kind=1][channel][seq:16] payload...
+    ///     Ack:  [kind=2][channel][next:16][mask:32]
+    ///
+    /// Every channel has its own 16-bit sequence space. An Ack reports the
+    /// receiver's `next` expected sequence (everything before it has arrived)
+    /// plus a selective bitmap: bit i set = `next + 1 + i` has arrived.
+    namespace Protocol
+    {
+        using Seq = std::uint16_t;
+
+        enum class Kind : std::uint8_t
+        {
+            Data = 1,
+            Ack = 2,
+        };
+
+        inline constexpr std::size_t DataHeaderSize = 4;
+        inline constexpr std::size_t AckSize = 8;
+        inline constexpr std::size_t AckMaskBits = 32;
+
+        /// Maximum sequences in flight per channel (sender) and the receiver's
+        /// reorder window. Far below 2^15, so wrapped comparisons stay unambiguous.
+        inline constexpr std::size_t Window = 256;
+
+        /// Wrap-around "a precedes b" for 16-bit sequence numbers.
+        constexpr bool SeqLess(Seq a, Seq b) noexcept
+        {
+            return static_cast<std::int16_t>(static_cast<Seq>(a - b)) < 0;
+        }
+
+        /// Forward distance from `from` to `to` (mod 2^16).
+        constexpr std::size_t SeqDistance(Seq from, Seq to) noexcept
+        {
+            return static_cast<Seq>(to - from);
+        }
+
+        struct DataHeader
+        {
+            std::uint8_t channel = 0;
+            Seq seq = 0;
+        };
+
+        struct Ack
+        {
+            std::uint8_t channel = 0;
+            Seq next = 0;
+            std::uint32_t mask = 0;
+        };
+
+        inline void WriteDataHeader(std::span<std::byte> out, const DataHeader& h) noexcept
+        {
+            out[0] = static_cast<std::byte>(Kind::Data);
+            out[1] = static_cast<std::byte>(h.channel);
+            out[2] = static_cast<std::byte>(h.seq >> 8);
+            out[3] = static_cast<std::byte>(h.seq);
+        }
+
+        inline void WriteAck(std::span<std::byte> out, const Ack& a) noexcept
+        {
+            out[0] = static_cast<std::byte>(Kind::Ack);
+            out[1] = static_cast<std::byte>(a.channel);
+            out[2] = static_cast<std::byte>(a.next >> 8);
+            out[3] = static_cast<std::byte>(a.next);
+            for (std::size_t i = 0; i < 4; ++i) {
+                out[4 + i] = static_cast<std::byte>(a.mask >> (24 - 8 * i));
+            }
+        }
+
+        inline std::optional<Kind> ReadKind(std::span<const std::byte> in) noexcept
+        {
+            if (in.empty()) {
+                return std::nullopt;
+            }
+            const auto kind = static_cast<Kind>(in[0]);
+            if (kind == Kind::Data && in.size() >= DataHeaderSize) {
+                return kind;
+            }
+            if (kind == Kind::Ack && in.size() >= AckSize) {
+                return kind;
+            }
+            return std::nullopt;
+        }
+
+        /// Requires ReadKind(in) == Kind::Data.
+        inline DataHeader ReadDataHeader(std::span<const std::byte> in) noexcept
+        {
+            return {
+                .channel = std::to_integer<std::uint8_t>(in[1]),
+                .seq = static_cast<Seq>((std::to_integer<Seq>(in[2]) << 8) | std::to_integer<Seq>(in[3])),
+            };
+        }
+
+        /// Requires ReadKind(in) == Kind::Ack.
+        inline Ack ReadAck(std::span<const std::byte> in) noexcept
+        {
+            std::uint32_t mask = 0;
+            for (std::size_t i = 0; i < 4; ++i) {
+                mask = (mask << 8) | std::to_integer<std::uint32_t>(in[4 + i]);
+            }
+            return {
+                .channel = std::to_integer<std::uint8_t>(in[1]),
+                .next = static_cast<Seq>((std::to_integer<Seq>(in[2]) << 8) | std::to_integer<Seq>(in[3])),
+                .mask = mask,
+            };
+        }
+    }
+}
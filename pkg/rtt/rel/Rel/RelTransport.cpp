@@ -0,0 +1,67 @@
+#include "RelTransport.h"
+
+#include <cassert>
+#include <utility>
+
+namespace Rtt::Rel
+{
+    namespace
+    {
+        /// Sits between the inner transport and the user's acceptor.
+        class RelAcceptor : public ILinkAcceptor
+        {
+        public:
+            RelAcceptor(std::shared_ptr<ILinkAcceptor> user, std::shared_ptr<const RelLink::Options> options)
+                : _user(std::move(user))
+                , _options(std::move(options))
+            {}
+
+            LinkHandler OnLink(LinkResult result) override
+            {
+                if (!result) {
+                    _user->OnLink(std::unexpected(result.error()));
+                    return {};
+                }
+
+                auto link = std::make_shared<RelLink>(std::move(*result), _options);
+                link->SetHandler(_user->OnLink(link));
+
+                // Weak: the user owns the RelLink, the inner link only feeds it
+                std::weak_ptr<RelLink> weak = link;
+                return LinkHandler{
+                    .onReceived = [weak](std::span<const std::byte> data) {
+                        if (auto l = weak.lock()) {
+                            l->OnInnerReceived(data);
+                        }
+                    },
+                    .onDisconnected = [weak] {
+                        if (auto l = weak.lock()) {
+                            l->OnInnerDisconnected();
+                        }
+                    },
+                    .onWritable = [weak] {
+                        if (auto l = weak.lock()) {
+                            l->OnInnerWritable();
+                        }
+                    },
+                };
+            }
+
+        private:
+            std::shared_ptr<ILinkAcceptor> _user;
+            std::shared_ptr<const RelLink::Options> _options;
+        };
+    }
+
+    RelTransport::RelTransport(std::shared_ptr<ITransport> inner, Options options)
+        : _inner(std::move(inner))
+        , _options(std::make_shared<const Options>(std::move(options)))
+    {
+        assert(_options->timers && "RelTransport requires a timer backend");
+    }
+
+    void RelTransport::Open(std::shared_ptr<ILinkAcceptor> acceptor)
+    {
+        _inner->Open(std::make_shared<RelAcceptor>(std::move(acceptor), _options));
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "RelLink.h"
+#include "Rtt/Transport.h"
+
+#include <memory>
+
+namespace Rtt::Rel
+{
+    /// ITransport decorator adding reliable, channelled delivery to an
+    /// unreliable transport such as Udp::UdpClient or Udp::UdpServer.
+    ///
+    /// Open() opens the inner transport and wraps every link it produces in a
+    /// RelLink before handing it to the acceptor, so users keep working with
+    /// plain ILink / LinkHandler. Both peers must use the reliability layer.
+    class RelTransport : public ITransport
+    {
+    public:
+        using Options = RelLink::Options;
+
+        RelTransport(std::shared_ptr<ITransport> inner, Options options);
+
+        // ITransport
+        void Open(std::shared_ptr<ILinkAcceptor> acceptor) override;
+
+    private:
+        std::shared_ptr<ITransport> _inner;
+        std::shared_ptr<const Options> _options;
+    };
+
+    static_assert(TransportLike<RelTransport>);
+}
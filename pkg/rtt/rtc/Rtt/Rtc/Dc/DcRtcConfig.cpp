@@ -11,5 +11,14 @@ namespace Rtt::Rtc
         }
         return config;
     }
+
+    rtc::Reliability BuildReliability(const RtcChannelOptions& options)
+    {
+        rtc::Reliability reliability;
+        reliability.unordered = options.unordered;
+        reliability.maxRetransmits = options.maxRetransmits;
+        reliability.maxPacketLifeTime = options.maxPacketLifeTime;
+        return reliability;
+    }
 }
 #endif
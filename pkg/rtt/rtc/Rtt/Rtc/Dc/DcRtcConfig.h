@@ -1,8 +1,10 @@
 #pragma once
 #include "Rtt/Rtc/RtcOptions.h"
 #include <rtc/configuration.hpp>
+#include <rtc/reliability.hpp>
 
 namespace Rtt::Rtc
 {
     rtc::Configuration BuildConfiguration(const RtcOptions& options);
+    rtc::Reliability BuildReliability(const RtcChannelOptions& options);
 }
@@ -1,11 +1,16 @@
 #if !defined(__EMSCRIPTEN__)
 #include "DcRtcLink.h"
 
+#include "DcRtcConfig.h"
 #include "Rtt/Rtc/ISigUser.h"
+#include "Rtt/SendScratch.h"
 
 #include <nlohmann/json.hpp>
 #include <rtc/rtc.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <format>
 #include <functional>
 #include <memory>
 #include <string>
@@ -16,6 +21,10 @@ namespace Rtt::Rtc
 {
     using json = nlohmann::json;
 
+    // SCTP stream of pre-negotiated channel i is StreamBase + i, well clear of
+    // the ids libdatachannel assigns to in-band channels (0, 1, 2, ...)
+    static constexpr std::uint16_t StreamBase = 256;
+
     static std::string_view ToStringView(rtc::PeerConnection::GatheringState st)
     {
         using G = rtc::PeerConnection::GatheringState;
@@ -51,13 +60,16 @@ namespace Rtt::Rtc
         PeerId remoteId,
         std::weak_ptr<ISigUser> sigUser,
         std::size_t maxMessageSize,
-        Log::Logger logger
+        Log::Logger logger,
+        std::shared_ptr<LinkCounters> counters
     )
         : pc(std::move(config))
         , _localId(localId)
         , _remoteId(remoteId)
         , _maxMessageSize(maxMessageSize)
         , _logger(logger)
+        , _channels(1)
+        , _counters(counters ? std::move(counters) : std::make_shared<LinkCounters>())
     {
         pc.onLocalDescription([sigUser, remoteId, logger](const rtc::Description& desc) mutable {
             if (auto su = sigUser.lock()) {
@@ -96,27 +108,19 @@ namespace Rtt::Rtc
         std::function<void()> onFailed
     )
     {
-        _dc = std::move(dc);
-        _logger.Debug("data channel open {} -> {}", _localId.value, _remoteId.value);
+        _channels[0] = std::move(dc);
+        _logger.Debug("data channel open {} -> {} ({} channel(s))", _localId.value, _remoteId.value, _channels.size());
 
         auto wlink = std::weak_ptr<DcRtcLink>{std::static_pointer_cast<DcRtcLink>(shared_from_this())};
         assert(wlink.expired() == false && "shared_from_this() must be valid when calling Attach()");
 
-        _dc->onMessage([wlink](rtc::message_variant data) {
-            auto self = wlink.lock();
-            if (!self || self->_disconnectRequested) {
-                return;
-            }
-            if (!std::holds_alternative<rtc::binary>(data)) {
-                return;
-            }
-            const auto& bin = std::get<rtc::binary>(data);
-            if (self->_handler.onReceived) {
-                self->_handler.onReceived(std::span<const std::byte>{bin.data(), bin.size()});
-            }
-        });
+        // Pre-negotiated channels may already hold messages: libdatachannel
+        // queues them until onMessage is set
+        for (const auto& channel : _channels) {
+            Wire(*channel);
+        }
 
-        _dc->onClosed([wlink]() {
+        _channels[0]->onClosed([wlink]() {
             // Log the DC-level close. onDisconnected fires later from PC state change
             // to guarantee all libdatachannel internal threads (SCTP/DTLS/ICE) are done.
             if (auto self = wlink.lock()) {
@@ -154,6 +158,50 @@ namespace Rtt::Rtc
         });
     }
 
+    void DcRtcLink::SetChannels(std::span<const RtcChannelOptions> channels)
+    {
+        const auto count = std::clamp<std::size_t>(channels.size(), 1, 256);
+        _channels.resize(count);
+        for (std::size_t i = 1; i < count; ++i) {
+            rtc::DataChannelInit init;
+            init.reliability = BuildReliability(channels[i]);
+            init.negotiated = true;
+            init.id = static_cast<std::uint16_t>(StreamBase + i);
+            _channels[i] = pc.createDataChannel(std::format("data/{}", i), std::move(init));
+        }
+    }
+
+    void DcRtcLink::Wire(rtc::DataChannel& dc)
+    {
+        auto wlink = std::weak_ptr<DcRtcLink>{std::static_pointer_cast<DcRtcLink>(shared_from_this())};
+
+        dc.onMessage([wlink](rtc::message_variant data) {
+            auto self = wlink.lock();
+            if (!self || self->_disconnectRequested) {
+                return;
+            }
+            if (!std::holds_alternative<rtc::binary>(data)) {
+                self->_counters->OnReceiveDrop();
+                return;
+            }
+            // The message is ours: an onPacket handler takes it over without a copy
+            auto& bin = std::get<rtc::binary>(data);
+            self->_counters->OnReceived(bin.size());
+            Deliver(self->_handler, std::move(bin));
+        });
+
+        if (_maxBufferedAmount > 0) {
+            // Each channel reports below its share of half the limit, so the
+            // link is back under half of it once every busy channel has reported
+            dc.setBufferedAmountLowThreshold(_maxBufferedAmount / (2 * _channels.size()));
+            dc.onBufferedAmountLow([wlink]() {
+                if (auto self = wlink.lock()) {
+                    self->OnBufferedAmountLow();
+                }
+            });
+        }
+    }
+
     // ---------------------------------------------------------------------------
     // ICE negotiation
     // ---------------------------------------------------------------------------
@@ -213,20 +261,130 @@ namespace Rtt::Rtc
 
     void DcRtcLink::Send(WriteCallback writer)
     {
-        if (_disconnectRequested || !_dc || !_dc->isOpen()) {
+        Send(0, std::move(writer));
+    }
+
+    std::size_t DcRtcLink::ChannelCount() const
+    {
+        return _channels.size();
+    }
+
+    void DcRtcLink::Send(ChannelId channel, WriteCallback writer)
+    {
+        if (channel >= _channels.size()) {
+            _counters->OnSendDrop();
+            return;
+        }
+        const auto& dc = _channels[channel];
+        if (_disconnectRequested || !dc || !dc->isOpen()) {
+            return;
+        }
+        if (!Writable()) {
+            _counters->OnSendDrop();
             return;
         }
 
-        std::vector<std::byte> buf(_maxMessageSize);
-        const auto bytesWritten = writer(std::span<std::byte>{buf});
+        // A writer that sends again gets its own buffer (see SendScratch)
+        SendScratch scratch{_maxMessageSize};
+        const auto buf = scratch.Span();
+        const auto bytesWritten = writer(buf);
         if (bytesWritten == 0) {
             return;
         }
 
-        _logger.Trace("send {} bytes {} -> {}", bytesWritten, _localId.value, _remoteId.value);
+        _logger.Trace("send {} bytes on channel {} {} -> {}", bytesWritten, channel, _localId.value, _remoteId.value);
 
-        rtc::binary payload(buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(bytesWritten));
-        _dc->send(std::move(payload));
+        // Right-sized and moved into the channel, which keeps it until SCTP has sent it
+        const auto written = buf.first(bytesWritten);
+        dc->send(rtc::binary(written.begin(), written.end())); // false = buffered by the channel, not lost
+        _counters->OnSent(bytesWritten);
+    }
+
+    void DcRtcLink::SendV(ConstBufferSequence buffers)
+    {
+        const auto& dc = _channels[0];
+        if (_disconnectRequested || !dc || !dc->isOpen()) {
+            return;
+        }
+
+        const auto total = BufferSize(buffers);
+        if (total == 0 || total > _maxMessageSize || !Writable()) {
+            _counters->OnSendDrop();
+            return;
+        }
+
+        _logger.Trace("sendv {} bytes in {} buffer(s) {} -> {}", total, buffers.size(), _localId.value, _remoteId.value);
+
+        // Assemble the message once, directly in the binary handed to the channel
+        rtc::binary payload;
+        payload.reserve(total);
+        for (const auto& b : buffers) {
+            payload.insert(payload.end(), b.begin(), b.end());
+        }
+        dc->send(std::move(payload));
+        _counters->OnSent(total);
+    }
+
+    LinkStats DcRtcLink::GetStats() const
+    {
+        auto stats = _counters->Snapshot();
+        // rtc::PeerConnection accessors are not const
+        if (const auto rtt = const_cast<rtc::PeerConnection&>(pc).rtt()) { // NOLINT(*-const-cast)
+            stats.rtt = std::chrono::duration_cast<std::chrono::microseconds>(*rtt);
+            stats.rttSamples = 1;
+        }
+        return stats;
+    }
+
+    // ---------------------------------------------------------------------------
+    // Backpressure
+    // ---------------------------------------------------------------------------
+
+    bool DcRtcLink::Writable() const
+    {
+        // Over the limit, at least one of the N channels holds limit/N or more,
+        // above its limit/(2N) threshold, and reports when it drains: the total
+        // is rechecked until it is back under the limit
+        return _maxBufferedAmount == 0 || OutstandingBytes() < _maxBufferedAmount;
+    }
+
+    std::size_t DcRtcLink::OutstandingBytes() const
+    {
+        std::size_t total = 0;
+        for (const auto& dc : _channels) {
+            total += dc ? dc->bufferedAmount() : 0;
+        }
+        return total;
+    }
+
+    void DcRtcLink::SendWhenWritable(WriteCallback writer)
+    {
+        {
+            std::lock_guard lock{_deferredMutex};
+            if (!_deferred.empty() || !Writable()) {
+                _deferred.push_back(std::move(writer));
+                return;
+            }
+        }
+        Send(std::move(writer));
+    }
+
+    void DcRtcLink::OnBufferedAmountLow()
+    {
+        {
+            // Sent under the lock so SendWhenWritable() cannot overtake them
+            std::lock_guard lock{_deferredMutex};
+            while (!_deferred.empty() && Writable() && !_disconnectRequested) {
+                Send(std::move(_deferred.front()));
+                _deferred.pop_front();
+            }
+            if (!_deferred.empty() || _disconnectRequested) {
+                return;
+            }
+        }
+        if (_handler.onWritable) {
+            _handler.onWritable();
+        }
     }
 
     void DcRtcLink::Disconnect()
@@ -234,13 +392,19 @@ namespace Rtt::Rtc
         if (_disconnectRequested.exchange(true)) {
             return;
         }
+        {
+            std::lock_guard lock{_deferredMutex};
+            _deferred.clear();
+        }
 
         _logger.Trace("disconnect {} -> {}", _localId.value, _remoteId.value);
 
         // Close the DataChannel and PeerConnection asynchronously.
         // onDisconnected will fire from pc->onStateChange on both sides uniformly.
-        if (_dc) {
-            _dc->close();
+        for (const auto& dc : _channels) {
+            if (dc) {
+                dc->close();
+            }
         }
         pc.close();
     }
@@ -3,6 +3,8 @@
 #include "Log/Log.h"
 #include "Rtt/Handler.h"
 #include "Rtt/Link.h"
+#include "Rtt/LinkStats.h"
+#include "Rtt/Rtc/RtcOptions.h"
 
 #include <rtc/peerconnection.hpp>
 #include <rtc/configuration.hpp>
@@ -10,9 +12,11 @@
 
 #include <atomic>
 #include <cstddef>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -39,6 +43,19 @@ namespace Rtt::Rtc
     ///
     /// After Attach(), pass the link to ILinkAcceptor::OnLink(), then call SetHandler()
     /// synchronously before returning from the callback.
+    ///
+    /// Channel 0 is the DataChannel passed to Attach(); SetChannels() adds
+    /// pre-negotiated ones with their own reliability. Messages of all channels
+    /// reach the same handler.
+    ///
+    /// Backpressure (SetMaxBufferedAmount) follows the channels' total buffered
+    /// amount. Deferred writers and onWritable run on the libdatachannel thread
+    /// that reports the buffer draining.
+    ///
+    /// Send() writers fill a per-thread buffer; one that sends on a link again
+    /// from inside the callback gets a separate buffer for the nested message,
+    /// which goes out first. Deferred writers run under the deferred-queue
+    /// lock and must not call SendWhenWritable().
     class DcRtcLink: public ILink
     {
     public:
@@ -50,13 +67,15 @@ namespace Rtt::Rtc
         /// @param sigUser        Signaling user for forwarding local SDP/ICE to the remote peer.
         /// @param logger         Logger instance carrying the caller's area tag.
         /// @param maxMessageSize Maximum send buffer size in bytes.
+        /// @param counters       Traffic counters, usually the transport's TransportStats::Track(); null = own block.
         DcRtcLink(
             rtc::Configuration config,
             PeerId localId,
             PeerId remoteId,
             std::weak_ptr<ISigUser> sigUser,
             std::size_t maxMessageSize,
-            Log::Logger logger
+            Log::Logger logger,
+            std::shared_ptr<LinkCounters> counters = {}
         );
 
         /// Phase 2: Bind the open DataChannel and finalize the link.
@@ -64,7 +83,7 @@ namespace Rtt::Rtc
         /// Overrides the pre-link onStateChange handler set in Create() with one
         /// that fires onClosed/onFailed and notifies the link handler.
         ///
-        /// @param dc        Open DataChannel to use for data transfer.
+        /// @param dc        Open DataChannel to use as channel 0.
         /// @param onClosed  Called when the PeerConnection reaches Closed/Disconnected.
         /// @param onFailed  Called when the PeerConnection reaches Failed.
         void Attach(
@@ -82,9 +101,31 @@ namespace Rtt::Rtc
         // ILink
         [[nodiscard]] const PeerId& LocalId() const override;
         [[nodiscard]] const PeerId& RemoteId() const override;
+        /// Send on channel 0. The writer may send again (see the class comment).
         void Send(WriteCallback writer) override;
+
+        /// Copies the buffers into one message on channel 0 before returning.
+        void SendV(ConstBufferSequence buffers) override;
         void Disconnect() override;
 
+        /// Message counters plus the SCTP association's RTT estimate (no ping
+        /// frames: DataChannel payloads are not framed).
+        [[nodiscard]] LinkStats GetStats() const override;
+        [[nodiscard]] bool Writable() const override;
+        [[nodiscard]] std::size_t OutstandingBytes() const override;
+        void SendWhenWritable(WriteCallback writer) override;
+        [[nodiscard]] std::size_t ChannelCount() const override;
+        void Send(ChannelId channel, WriteCallback writer) override;
+
+        /// Buffered-amount limit. 0 = unlimited (default). Must be called before Attach().
+        void SetMaxBufferedAmount(std::size_t limit) noexcept { _maxBufferedAmount = limit; }
+
+        /// Create the pre-negotiated DataChannels 1.. of `channels` (channel 0
+        /// is Attach()'s). Must be called before Attach(), once the connection
+        /// has a local description (so no renegotiation starts): after creating
+        /// channel 0 on the offerer, after SetRemoteDescription() on the answerer.
+        void SetChannels(std::span<const RtcChannelOptions> channels);
+
         /// Bind the data and disconnect handlers.
         ///
         /// Must be called synchronously after OnLink() delivers the link — before
@@ -96,18 +137,29 @@ namespace Rtt::Rtc
         rtc::PeerConnection pc;
 
     private:
+        /// A channel drained below the low-watermark: run deferred writers, then onWritable.
+        void OnBufferedAmountLow();
+
+        /// Wire data and backpressure callbacks of one channel.
+        void Wire(rtc::DataChannel& dc);
+
         PeerId _localId;
         PeerId _remoteId;
         std::size_t _maxMessageSize;
         Log::Logger _logger;
-        std::shared_ptr<rtc::DataChannel> _dc;
+        std::vector<std::shared_ptr<rtc::DataChannel>> _channels; // [0] set by Attach()
         LinkHandler _handler;
+        std::shared_ptr<LinkCounters> _counters;
+        std::size_t _maxBufferedAmount = 0;
         std::atomic<bool> _disconnectRequested{false};
         std::atomic<bool> _closedFired{false};
 
         std::mutex _mutex;
         bool _remoteDescSet{false};
         std::vector<std::pair<std::string, std::string>> _pendingCandidates;
+
+        std::mutex _deferredMutex;
+        std::deque<WriteCallback> _deferred; // protected by _deferredMutex
     };
 
     static_assert(LinkLike<DcRtcLink>);
@@ -15,6 +15,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace Rtt::Rtc
 {
@@ -24,7 +25,7 @@ namespace Rtt::Rtc
     // DcRtcTransport::State — ISigHandler, manages offerer and answerer connections.
     //
     // peers map holds all active DcRtcLink instances:
-    //   - outbound link keyed on remoteId.value  (offerer mode)
+    //   - outbound link keyed on remoteId  (offerer mode)
     //   - inbound links keyed on each peer's ID  (answerer mode)
     // ---------------------------------------------------------------------------
 
@@ -48,10 +49,13 @@ namespace Rtt::Rtc
         PeerId remoteId;
         rtc::Configuration config;
         std::size_t maxMessageSize = 65535;
+        std::size_t maxBufferedAmount = 0;
+        std::vector<RtcChannelOptions> channels;
         std::size_t maxInboundConnections = 4096;
+        std::shared_ptr<TransportStats> linkStats;
 
         std::mutex mutex;
-        std::unordered_map<std::string, std::shared_ptr<DcRtcLink>> peers;
+        std::unordered_map<PeerId, std::shared_ptr<DcRtcLink>> peers;
         std::size_t inboundCount = 0; // protected by mutex; counts active inbound peer connections
 
         bool isOfferer() const { return !remoteId.value.empty(); }
@@ -93,7 +97,7 @@ namespace Rtt::Rtc
                 std::shared_ptr<DcRtcLink> link;
                 {
                     std::lock_guard lock{mutex};
-                    if (auto it = peers.find(remoteId.value); it != peers.end()) {
+                    if (auto it = peers.find(remoteId); it != peers.end()) {
                         link = it->second;
                     }
                 }
@@ -106,7 +110,7 @@ namespace Rtt::Rtc
                 std::shared_ptr<DcRtcLink> link;
                 {
                     std::lock_guard lock{mutex};
-                    if (auto it = peers.find(fromId.value); it != peers.end()) {
+                    if (auto it = peers.find(fromId); it != peers.end()) {
                         link = it->second;
                     }
                 }
@@ -135,14 +139,19 @@ namespace Rtt::Rtc
                 remoteId,
                 std::weak_ptr<ISigUser>{sigUser},
                 maxMessageSize,
-                logger
+                logger,
+                linkStats->Track()
             );
+            link->SetMaxBufferedAmount(maxBufferedAmount);
             {
                 std::lock_guard lock{mutex};
-                peers[remoteId.value] = link;
+                peers[remoteId] = link;
             }
 
-            auto dc = link->pc.createDataChannel("data");
+            rtc::DataChannelInit init;
+            init.reliability = BuildReliability(channels.front());
+            auto dc = link->pc.createDataChannel("data", std::move(init));
+            link->SetChannels(channels); // the offer is out: no renegotiation
             auto wself = std::weak_ptr<State>{shared_from_this()};
             auto wlink = std::weak_ptr<DcRtcLink>{link};
             auto waccept = std::weak_ptr<ILinkAcceptor>{acceptor};
@@ -159,14 +168,14 @@ namespace Rtt::Rtc
                 auto onClosed = [wself, remId]() {
                     if (auto s = wself.lock()) {
                         std::lock_guard lock{s->mutex};
-                        s->peers.erase(remId.value);
+                        s->peers.erase(remId);
                     }
                 };
                 auto onFailed = [wself, waccept, remId]() {
                     if (auto s = wself.lock()) {
                         s->logger.Error("peer connection failed for {}", remId.value);
                         std::lock_guard lock{s->mutex};
-                        s->peers.erase(remId.value);
+                        s->peers.erase(remId);
                     }
                     if (auto acc = waccept.lock()) {
                         acc->OnLink(std::unexpected(Error::Unknown));
@@ -194,11 +203,13 @@ namespace Rtt::Rtc
                 fromId,
                 std::weak_ptr<ISigUser>{sigUser},
                 maxMessageSize,
-                logger
+                logger,
+                linkStats->Track()
             );
+            link->SetMaxBufferedAmount(maxBufferedAmount);
             {
                 std::lock_guard lock{mutex};
-                peers[fromId.value] = link;
+                peers[fromId] = link;
                 ++inboundCount;
             }
 
@@ -217,7 +228,7 @@ namespace Rtt::Rtc
                     auto onGone = [wself, fromId]() {
                         if (auto s = wself.lock()) {
                             std::lock_guard lock{s->mutex};
-                            s->peers.erase(fromId.value);
+                            s->peers.erase(fromId);
                             if (s->inboundCount > 0) {
                                 --s->inboundCount;
                             }
@@ -231,6 +242,10 @@ namespace Rtt::Rtc
             );
 
             link->SetRemoteDescription(sdp, rtc::Description::Type::Offer, fromId);
+            // After the answer (creating channels earlier would start an offer
+            // of our own); the channel-0 DataChannel cannot arrive before ICE
+            // and DTLS complete
+            link->SetChannels(channels);
         }
     };
 
@@ -247,12 +262,15 @@ namespace Rtt::Rtc
     void DcRtcTransport::Open(std::shared_ptr<ILinkAcceptor> acceptor)
     {
         auto state = std::make_shared<State>(_options.localId.value);
-        state->acceptor = std::move(acceptor);
+        state->acceptor = _options.events ? _options.events->Wrap(std::move(acceptor)) : std::move(acceptor);
         state->localId = _options.localId;
         state->remoteId = _options.remoteId;
         state->config = BuildConfiguration(_options);
         state->maxMessageSize = _options.maxMessageSize;
+        state->maxBufferedAmount = _options.maxBufferedAmount;
+        state->channels = _options.channels.empty() ? std::vector<RtcChannelOptions>(1) : _options.channels;
         state->maxInboundConnections = _options.maxInboundConnections;
+        state->linkStats = _linkStats;
 
         _state = state;
 
@@ -2,6 +2,7 @@
 #if !defined(__EMSCRIPTEN__)
 #include "Rtt/Rtc/RtcOptions.h"
 #include "Rtt/Transport.h"
+#include "Rtt/TransportStats.h"
 
 #include <cstddef>
 #include <memory>
@@ -15,6 +16,12 @@ namespace Rtt::Rtc
     ///   - options.maxInboundConnections > 0     → answerer: accepts incoming offers up to the limit.
     ///   Both modes can be active simultaneously.
     ///
+    /// Every link opens the DataChannels listed in options.channels, addressed
+    /// with ILink::Send(channel, writer).
+    ///
+    /// The acceptor and link handlers are called on libdatachannel's threads,
+    /// or where options.events is drained when set.
+    ///
     /// Each instance logs under "DcRtc/{localId}" for easy per-instance filtering.
     ///
     /// Only available on host and droid platforms (not WASM).
@@ -30,8 +37,12 @@ namespace Rtt::Rtc
         // ITransport — may call acceptor.OnLink() multiple times (one per remote peer).
         void Open(std::shared_ptr<ILinkAcceptor> acceptor) override;
 
+        /// Traffic of all links. Call LogEvery() from the frame loop to dump it periodically.
+        [[nodiscard]] TransportStats& GetLinkStats() const noexcept { return *_linkStats; }
+
     private:
         Options _options;
+        std::shared_ptr<TransportStats> _linkStats = std::make_shared<TransportStats>();
 
         struct State;
         std::shared_ptr<State> _state;
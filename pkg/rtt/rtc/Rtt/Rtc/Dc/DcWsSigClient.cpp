@@ -45,7 +45,7 @@ namespace Rtt::Rtc
                 return;
             }
             Log::Trace("[{}] -> [{}] send {} bytes", _id.value, to.value, payload.size());
-            const json envelope = {{"id", to.value}, {"payload", std::move(payload)}};
+            const json envelope = {{"id", to.value.View()}, {"payload", std::move(payload)}};
             _ws->send(envelope.dump());
         }
 
@@ -122,7 +122,7 @@ namespace Rtt::Rtc
 
     void DcWsSigClient::Join(PeerId id, SigJoinHandler onJoined)
     {
-        const std::string url = "ws://" + _options.host + ":" + std::to_string(_options.port) + "/" + id.value;
+        const std::string url = "ws://" + _options.host + ":" + std::to_string(_options.port) + "/" + std::string{id.value};
 
         Log::Debug("[{}] connecting to {}", id.value, url);
 
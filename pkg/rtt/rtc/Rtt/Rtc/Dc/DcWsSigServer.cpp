@@ -30,7 +30,7 @@ namespace Rtt::Rtc
             if (!ws->isOpen()) {
                 return;
             }
-            const json envelope = {{"id", msg.from.value}, {"payload", std::move(msg.payload)}};
+            const json envelope = {{"id", msg.from.value.View()}, {"payload", std::move(msg.payload)}};
             ws->send(envelope.dump());
         }
 
@@ -53,7 +53,7 @@ namespace Rtt::Rtc
         // Used to avoid use-after-free when a client disconnects while a message
         // is in flight.  The map is cleaned up on close events.
         std::mutex connMutex;
-        std::unordered_map<std::string, std::weak_ptr<rtc::WebSocket>> connections;
+        std::unordered_map<PeerId, std::weak_ptr<rtc::WebSocket>> connections;
     };
 
     // ---------------------------------------------------------------------------
@@ -112,7 +112,7 @@ namespace Rtt::Rtc
                 // Track the connection so we can clean up on close.
                 {
                     std::lock_guard lock{impl->connMutex};
-                    impl->connections[connId] = ws;
+                    impl->connections[PeerId{connId}] = ws;
                 }
 
                 ws->onMessage([impl, hub, connId, handler](auto raw) {
@@ -146,7 +146,7 @@ namespace Rtt::Rtc
                     Log::Info("client disconnected: [{}]", connId);
                     {
                         std::lock_guard lock{impl->connMutex};
-                        impl->connections.erase(connId);
+                        impl->connections.erase(PeerId{connId});
                     }
                     // Explicit leave so the hub unregisters the peer.
                     if (handler->user) {
@@ -173,7 +173,7 @@ namespace Rtt::Rtc
         std::shared_ptr<rtc::WebSocket> ws;
         {
             std::lock_guard lock{_impl->connMutex};
-            if (auto it = _impl->connections.find(peerId.value); it != _impl->connections.end()) {
+            if (auto it = _impl->connections.find(peerId); it != _impl->connections.end()) {
                 ws = it->second.lock();
             }
         }
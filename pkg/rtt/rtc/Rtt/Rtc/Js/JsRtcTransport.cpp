@@ -253,11 +253,9 @@ namespace Rtt::Rtc
         /// Called from EMSCRIPTEN_KEEPALIVE JsRtcPc_OnMessage.
         void OnMessage(const void* data, int size)
         {
-            if (_handler.onReceived) {
-                _handler.onReceived(std::span<const std::byte>{
-                    static_cast<const std::byte*>(data),
-                    static_cast<std::size_t>(size)});
-            }
+            Deliver(_handler, std::span<const std::byte>{
+                static_cast<const std::byte*>(data),
+                static_cast<std::size_t>(size)});
         }
 
     private:
@@ -441,7 +439,7 @@ namespace Rtt::Rtc
         // Non-owning raw pointers to in-progress peer contexts.
         // Entries removed when JsRtcLink::_onGone fires (after DC open) or on early error.
         std::mutex mutex;
-        std::unordered_map<std::string, JsRtcPeerContext*> peers;
+        std::unordered_map<PeerId, JsRtcPeerContext*> peers;
         std::size_t inboundCount = 0; // protected by mutex; counts active inbound peer connections
 
         bool isOfferer() const { return !remoteId.value.empty(); }
@@ -480,7 +478,7 @@ namespace Rtt::Rtc
                 JsRtcPeerContext* ctx = nullptr;
                 {
                     std::lock_guard lock{mutex};
-                    auto it = peers.find(fromId.value);
+                    auto it = peers.find(fromId);
                     if (it != peers.end()) {
                         ctx = it->second;
                     }
@@ -494,7 +492,7 @@ namespace Rtt::Rtc
                 JsRtcPeerContext* ctx = nullptr;
                 {
                     std::lock_guard lock{mutex};
-                    auto it = peers.find(fromId.value);
+                    auto it = peers.find(fromId);
                     if (it != peers.end()) {
                         ctx = it->second;
                     }
@@ -542,7 +540,7 @@ namespace Rtt::Rtc
                 auto onGone = [wself, remId = c->remoteId]() {
                     if (auto ss = wself.lock()) {
                         std::lock_guard lock{ss->mutex};
-                        ss->peers.erase(remId.value);
+                        ss->peers.erase(remId);
                     }
                 };
 
@@ -565,7 +563,7 @@ namespace Rtt::Rtc
 
             {
                 std::lock_guard lock{mutex};
-                peers[remoteId.value] = ctx;
+                peers[remoteId] = ctx;
             }
 
             logger.Debug("starting offerer {} -> {}", localId.value, remoteId.value);
@@ -598,7 +596,7 @@ namespace Rtt::Rtc
                 auto onGone = [wself, remId = c->remoteId]() {
                     if (auto ss = wself.lock()) {
                         std::lock_guard lock{ss->mutex};
-                        ss->peers.erase(remId.value);
+                        ss->peers.erase(remId);
                         if (ss->inboundCount > 0) {
                             --ss->inboundCount;
                         }
@@ -615,7 +613,7 @@ namespace Rtt::Rtc
 
             {
                 std::lock_guard lock{mutex};
-                peers[fromId.value] = ctx;
+                peers[fromId] = ctx;
                 ++inboundCount;
             }
 
@@ -637,7 +635,7 @@ namespace Rtt::Rtc
     void JsRtcTransport::Open(std::shared_ptr<ILinkAcceptor> acceptor)
     {
         auto state = std::make_shared<State>(_options.localId.value);
-        state->acceptor = std::move(acceptor);
+        state->acceptor = _options.events ? _options.events->Wrap(std::move(acceptor)) : std::move(acceptor);
         state->localId = _options.localId;
         state->remoteId = _options.remoteId;
         state->iceServers = _options.iceServers;
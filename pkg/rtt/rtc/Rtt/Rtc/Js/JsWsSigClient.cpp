@@ -248,7 +248,7 @@ namespace Rtt::Rtc
 
     void JsWsSigClient::Join(PeerId id, SigJoinHandler onJoined)
     {
-        const std::string url = "ws://" + _options.host + ":" + std::to_string(_options.port) + "/" + id.value;
+        const std::string url = "ws://" + _options.host + ":" + std::to_string(_options.port) + "/" + std::string{id.value};
 
         Log::Debug("[{}] connecting to {}", id.value, url);
 
@@ -1,13 +1,32 @@
 #pragma once
+#include "Rtt/LinkEventQueue.h"
 #include "Rtt/Rtc/ISigClient.h"
 
+#include <chrono>
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 namespace Rtt::Rtc
 {
+    /// Delivery guarantees of one DataChannel of a link (see RtcOptions::channels).
+    /// The default is reliable and ordered; `{.unordered = true, .maxRetransmits = 0}`
+    /// gives datagram-like delivery where a late message never holds back newer ones.
+    struct RtcChannelOptions
+    {
+        /// Deliver messages as they arrive instead of in send order.
+        bool unordered = false;
+
+        /// Give up on a message after this many retransmissions. Unset = retransmit until delivered.
+        std::optional<unsigned> maxRetransmits;
+
+        /// Give up on a message once it is this old. Unset = no limit.
+        /// Not combinable with maxRetransmits.
+        std::optional<std::chrono::milliseconds> maxPacketLifeTime;
+    };
+
     /// Common options shared by all WebRtc transport implementations.
     struct RtcOptions
     {
@@ -27,6 +46,24 @@ namespace Rtt::Rtc
         /// Maximum send buffer size in bytes.
         std::size_t maxMessageSize = 65535;
 
+        /// Bytes a link's DataChannel may hold buffered before the link stops
+        /// being Writable() (see ILink backpressure). Send() drops while over it;
+        /// SendWhenWritable() defers. 0 = unlimited (default).
+        std::size_t maxBufferedAmount = 0;
+
+        /// DataChannels of every link, indexed by ChannelId (at most 256; see
+        /// ILink::Send(channel, writer)). Channel 0 is opened by the offerer and
+        /// negotiated in-band, so the answerer follows the offerer's options for
+        /// it. The others are pre-negotiated: both peers must list the same
+        /// number of channels, and each side's options govern what it sends.
+        /// JsRtcTransport opens channel 0 only and sends everything on it.
+        std::vector<RtcChannelOptions> channels{RtcChannelOptions{}};
+
+        /// Queue for OnLink() and link events. Set it to have them run where the
+        /// queue is drained (the frame loop, a strand, a Domain scheduler)
+        /// instead of on the WebRTC stack's threads. Null = called directly.
+        std::shared_ptr<LinkEventQueue> events;
+
         /// Maximum number of simultaneous inbound connections accepted by this transport.
         /// 0 = reject all inbound offers (pure offerer mode).
         std::size_t maxInboundConnections = 4096;
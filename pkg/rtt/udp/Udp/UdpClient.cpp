@@ -1,10 +1,15 @@
 #include "UdpClient.h"
 #include "UdpCommon.h"
+#include "UdpHandshake.h"
 #include "UdpLink.h"
 
 #include "Log/Log.h"
+#include <array>
 #include <boost/asio/ip/udp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <utility>
 
 namespace Rtt::Udp
@@ -12,27 +17,170 @@ namespace Rtt::Udp
     namespace asio = boost::asio;
     using udp = asio::ip::udp;
 
+    namespace
+    {
+        /// Everything needed to turn a connected socket into a delivered link.
+        struct LinkSetup
+        {
+            std::shared_ptr<ILinkAcceptor> acceptor;
+            std::size_t maxDatagramSize{};
+            std::shared_ptr<UdpSendPool> sendPool;
+            UdpFragmentOptions fragment;
+            std::shared_ptr<TransportStats> stats;
+            std::size_t maxOutstandingBytes = 0;
+            std::shared_ptr<PacketPool> recvPool;
+        };
+
+        void DeliverLink(udp::socket socket, LinkSetup setup)
+        {
+            auto localId = EndpointToPeerId(socket.local_endpoint());
+            auto remoteId = EndpointToPeerId(socket.remote_endpoint());
+
+            Log::Trace("connected {} -> {}", localId.value, remoteId.value);
+
+            auto link = std::make_shared<UdpLink>(
+                std::move(socket), std::move(localId), std::move(remoteId),
+                setup.maxDatagramSize, std::move(setup.sendPool), setup.fragment, setup.stats->Track());
+            link->SetMaxOutstandingBytes(setup.maxOutstandingBytes);
+            link->SetReceivePool(std::move(setup.recvPool));
+
+            auto handler = setup.acceptor->OnLink(link);
+            link->StartReceive(std::move(handler));
+        }
+
+        /// Client side of the cookie handshake: Hello until a Challenge arrives,
+        /// then Response until Accept, resending every `retry`.
+        class ClientHandshake : public std::enable_shared_from_this<ClientHandshake>
+        {
+        public:
+            ClientHandshake(udp::socket socket, LinkSetup setup,
+                            std::chrono::milliseconds retry, std::uint32_t attempts)
+                : _socket(std::move(socket))
+                , _timer(_socket.get_executor())
+                , _setup(std::move(setup))
+                , _retry(retry)
+                , _attempts(attempts)
+                , _attemptsLeft(attempts)
+            {}
+
+            void Start()
+            {
+                Send();
+                Receive();
+            }
+
+        private:
+            void Send()
+            {
+                if (_attemptsLeft == 0) {
+                    Log::Trace("handshake timed out with {}", EndpointToPeerId(_socket.remote_endpoint()).value);
+                    _done = true;
+                    boost::system::error_code ec;
+                    auto _ = _socket.close(ec);
+                    _setup.acceptor->OnLink(std::unexpected(Error::Timeout));
+                    return;
+                }
+                --_attemptsLeft;
+
+                std::array<std::byte, Handshake::MaxMessageSize> buf;
+                const auto size = _cookie
+                    ? Handshake::Write(buf, Handshake::Message::Response, *_cookie)
+                    : Handshake::Write(buf, Handshake::Message::Hello);
+                boost::system::error_code ec;
+                auto _ = _socket.send(asio::buffer(buf.data(), size), 0, ec);
+
+                _timer.expires_after(_retry);
+                _timer.async_wait([self = shared_from_this()](boost::system::error_code ec) {
+                    if (!ec && !self->_done) {
+                        self->Send();
+                    }
+                });
+            }
+
+            void Receive()
+            {
+                _socket.async_receive(
+                    asio::buffer(_recvBuf),
+                    [self = shared_from_this()](boost::system::error_code ec, std::size_t size) {
+                        if (self->_done) {
+                            return;
+                        }
+                        if (ec) {
+                            // e.g. ICMP port unreachable: keep trying until the attempts run out
+                            Log::Trace("handshake receive error — {}", ec.message());
+                            self->Receive();
+                            return;
+                        }
+                        self->OnReceived(std::span<const std::byte>{self->_recvBuf.data(), size});
+                    });
+            }
+
+            void OnReceived(std::span<const std::byte> data)
+            {
+                const auto message = Handshake::Classify(data);
+                if (message == Handshake::Message::Challenge) {
+                    // Answer right away; the server is alive, so restart the retry budget
+                    _cookie = Handshake::ReadCookie(data);
+                    _attemptsLeft = _attempts;
+                    Send();
+                } else if (message == Handshake::Message::Accept && _cookie) {
+                    _done = true;
+                    _timer.cancel();
+                    DeliverLink(std::move(_socket), std::move(_setup));
+                    return;
+                }
+                Receive();
+            }
+
+            udp::socket _socket;
+            asio::steady_timer _timer;
+            LinkSetup _setup;
+            std::chrono::milliseconds _retry;
+            std::uint32_t _attempts;
+            std::uint32_t _attemptsLeft;
+            std::optional<Handshake::Cookie> _cookie;
+            std::array<std::byte, Handshake::MaxMessageSize> _recvBuf{};
+            bool _done = false;
+        };
+    }
+
     UdpClient::UdpClient(Options options)
         : _options(std::move(options))
-    {}
+        , _sendPool(std::make_shared<UdpSendPool>(_options.maxDatagramSize, _options.sendPoolCapacity))
+    {
+        if (_options.pooledReceive) {
+            _recvPool = std::make_shared<PacketPool>(_options.maxDatagramSize, _options.receivePoolCapacity);
+        }
+    }
 
     void UdpClient::Open(std::shared_ptr<ILinkAcceptor> acceptor)
     {
         auto executor = _options.executor;
         auto host = _options.remoteHost;
         auto port = std::to_string(_options.remotePort);
-        auto maxDgSize = _options.maxDatagramSize;
+        auto handshake = _options.handshake;
+        auto retry = _options.handshakeRetry;
+        auto attempts = _options.handshakeAttempts;
+        auto setup = LinkSetup{
+            .acceptor = std::move(acceptor),
+            .maxDatagramSize = _options.maxDatagramSize,
+            .sendPool = _sendPool,
+            .fragment = FragmentOptions(),
+            .stats = _linkStats,
+            .maxOutstandingBytes = _options.maxOutstandingBytes,
+            .recvPool = _recvPool,
+        };
 
         Log::Trace("resolving {}:{}", host, port);
 
         auto resolver = std::make_shared<udp::resolver>(executor);
         resolver->async_resolve(
             host, port,
-            [resolver, executor, maxDgSize, acceptor = std::move(acceptor), host, port]
+            [resolver, executor, handshake, retry, attempts, setup = std::move(setup), host, port]
             (boost::system::error_code ec, udp::resolver::results_type results) mutable {
                 if (ec) {
                     Log::Trace("resolve failed for {}:{} — {}", host, port, ec.message());
-                    acceptor->OnLink(std::unexpected(MapAsioError(ec)));
+                    setup.acceptor->OnLink(std::unexpected(MapAsioError(ec)));
                     return;
                 }
 
@@ -43,21 +191,17 @@ namespace Rtt::Udp
                 auto _ = socket.connect(remoteEp, connectEc);
                 if (connectEc) {
                     Log::Trace("connect failed to {}:{} — {}", host, port, connectEc.message());
-                    acceptor->OnLink(std::unexpected(MapAsioError(connectEc)));
+                    setup.acceptor->OnLink(std::unexpected(MapAsioError(connectEc)));
                     return;
                 }
+                _ = socket.non_blocking(true, connectEc); // for UdpLink::SendV
 
-                auto localEp = socket.local_endpoint();
-                auto localId = EndpointToPeerId(localEp);
-                auto remoteId = EndpointToPeerId(remoteEp);
-
-                Log::Trace("connected {} -> {}", localId.value, remoteId.value);
-
-                auto link = std::make_shared<UdpLink>(
-                    std::move(socket), std::move(localId), std::move(remoteId), maxDgSize);
-
-                auto handler = acceptor->OnLink(link);
-                link->StartReceive(std::move(handler));
+                if (handshake) {
+                    Log::Trace("handshake with {}:{}", host, port);
+                    std::make_shared<ClientHandshake>(std::move(socket), std::move(setup), retry, attempts)->Start();
+                    return;
+                }
+                DeliverLink(std::move(socket), std::move(setup));
             });
     }
 }
@@ -1,9 +1,15 @@
 #pragma once
+#include "Rtt/Packet.h"
 #include "Rtt/Transport.h"
+#include "Rtt/TransportStats.h"
+#include "UdpFragment.h"
+#include "UdpSendPool.h"
 
 #include <boost/asio/any_io_executor.hpp>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 
 namespace Rtt::Udp
@@ -12,7 +18,8 @@ namespace Rtt::Udp
     ///
     /// Resolves a remote host:port and creates a connected UDP socket.
     /// Open() delivers exactly one link to the acceptor on success,
-    /// or an error on failure.
+    /// or an error on failure. With `handshake` the link is delivered
+    /// once the server accepted the cookie handshake.
     ///
     /// Requires an externally-managed executor (e.g., from AsioPoller).
     class UdpClient : public ITransport
@@ -30,6 +37,48 @@ namespace Rtt::Udp
 
             /// Maximum UDP datagram payload size.
             std::size_t maxDatagramSize = 1472;
+
+            /// Maximum number of idle send buffers kept for reuse by the send pool.
+            std::size_t sendPoolCapacity = 64;
+
+            /// Receive every datagram into its own refcounted slab, so handlers with
+            /// LinkHandler::onPacket keep packets past the callback without a copy.
+            /// Off = one reused receive buffer, onPacket gets copies (default).
+            bool pooledReceive = false;
+
+            /// Maximum number of idle receive slabs kept for reuse in pooled mode.
+            std::size_t receivePoolCapacity = 64;
+
+            /// Largest message Send() accepts. Messages over maxDatagramSize are sent
+            /// as fragments and reassembled by the peer, which must use the same
+            /// setting. 0 = no fragmentation, one message per datagram (default).
+            std::size_t maxMessageSize = 0;
+
+            /// Bytes of incomplete fragmented messages buffered per link.
+            std::size_t reassemblyBufferSize = 256 * 1024;
+
+            /// Incomplete fragmented messages are dropped after this long.
+            std::chrono::milliseconds reassemblyTimeout{1000};
+
+            /// Minimum time between in-band pings measuring each link's RTT, sent
+            /// ahead of outgoing messages. Frames every datagram, so the peer must
+            /// use the same setting. 0 = no pings (default).
+            std::chrono::milliseconds pingInterval{0};
+
+            /// Bytes a link may have in flight in asynchronous sends before it
+            /// stops being Writable() (see ILink backpressure). Send() drops while
+            /// over it; SendWhenWritable() defers. 0 = unlimited (default).
+            std::size_t maxOutstandingBytes = 0;
+
+            /// Complete the cookie handshake (see UdpHandshake.h) before delivering
+            /// the link. Required by servers with UdpServer::Options::handshake.
+            bool handshake = false;
+
+            /// Interval between handshake retries.
+            std::chrono::milliseconds handshakeRetry{250};
+
+            /// Handshake messages sent before Open() fails with Error::Timeout.
+            std::uint32_t handshakeAttempts = 8;
         };
 
         explicit UdpClient(Options options);
@@ -37,8 +86,34 @@ namespace Rtt::Udp
         // ITransport
         void Open(std::shared_ptr<ILinkAcceptor> acceptor) override;
 
+        /// Hit/miss counters of the send buffer pool used by this client's link.
+        [[nodiscard]] UdpSendPool::Stats GetSendPoolStats() const noexcept { return _sendPool->GetStats(); }
+
+        /// Hit/miss counters of the receive slab pool (pooled receive only).
+        [[nodiscard]] PacketPool::Stats GetReceivePoolStats() const noexcept
+        {
+            return _recvPool ? _recvPool->GetStats() : PacketPool::Stats{};
+        }
+
+        /// Traffic of the client's link (of every link, if opened more than once).
+        [[nodiscard]] TransportStats& GetLinkStats() const noexcept { return *_linkStats; }
+
     private:
+        /// Fragmentation settings handed to every link.
+        [[nodiscard]] UdpFragmentOptions FragmentOptions() const noexcept
+        {
+            return {
+                .maxMessageSize = _options.maxMessageSize,
+                .reassemblyBufferSize = _options.reassemblyBufferSize,
+                .reassemblyTimeout = _options.reassemblyTimeout,
+                .pingInterval = _options.pingInterval,
+            };
+        }
+
         Options _options;
+        std::shared_ptr<UdpSendPool> _sendPool;
+        std::shared_ptr<PacketPool> _recvPool; // set when pooled receive is enabled
+        std::shared_ptr<TransportStats> _linkStats = std::make_shared<TransportStats>();
     };
 
     static_assert(TransportLike<UdpClient>);
@@ -10,8 +10,16 @@
 namespace Rtt::Udp
 {
     /// Format a UDP endpoint as a PeerId ("ip:port").
+    /// IPv4 (and IPv4-mapped) endpoints take the allocation-free binary form.
     inline PeerId EndpointToPeerId(const boost::asio::ip::udp::endpoint& ep)
     {
+        auto address = ep.address();
+        if (address.is_v6() && address.to_v6().is_v4_mapped()) {
+            address = boost::asio::ip::make_address_v4(boost::asio::ip::v4_mapped, address.to_v6());
+        }
+        if (address.is_v4()) {
+            return PeerId::FromIpv4(address.to_v4().to_uint(), ep.port());
+        }
         return PeerId{
             .value = std::format("{}:{}", ep.address().to_string(), ep.port())
         };
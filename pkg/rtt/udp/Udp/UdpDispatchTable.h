@@ -0,0 +1,193 @@
+#pragma once
+#include <boost/asio/ip/udp.hpp>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace Rtt::Udp
+{
+    /// Packed (IPv4 address, port) key: `address << 16 | port`. 0 is never a
+    /// valid sender (0.0.0.0:0) and marks empty slots in UdpDispatchTable.
+    using EndpointKey = std::uint64_t;
+
+    /// Pack a UDP endpoint into an EndpointKey.
+    /// IPv4 and IPv4-mapped IPv6 addresses only (UdpServer binds udp::v4());
+    /// returns std::nullopt for other endpoints.
+    inline std::optional<EndpointKey> PackEndpoint(const boost::asio::ip::udp::endpoint& ep) noexcept
+    {
+        auto address = ep.address();
+        if (address.is_v6() && address.to_v6().is_v4_mapped()) {
+            address = boost::asio::ip::make_address_v4(boost::asio::ip::v4_mapped, address.to_v6());
+        }
+        if (!address.is_v4()) {
+            return std::nullopt;
+        }
+        return (static_cast<EndpointKey>(address.to_v4().to_uint()) << 16) | ep.port();
+    }
+
+    /// Flat open-addressing hash table from EndpointKey to Value.
+    ///
+    /// Linear probing over a power-of-two slot array with backward-shift
+    /// deletion (no tombstones), kept at most half full. Find() first checks a
+    /// one-entry "last sender" cache so bursts from the same peer skip hashing.
+    /// Any erase or rehash moves slots and therefore resets the cache.
+    ///
+    /// Not thread-safe.
+    template <class Value>
+    class UdpDispatchTable
+    {
+    public:
+        explicit UdpDispatchTable(std::size_t initialCapacity = 16)
+            : _slots(std::bit_ceil(std::max<std::size_t>(initialCapacity, 2)))
+            , _mask(_slots.size() - 1)
+        {}
+
+        [[nodiscard]] std::size_t Size() const noexcept { return _size; }
+        [[nodiscard]] bool Empty() const noexcept { return _size == 0; }
+
+        /// Returns the value stored for `key` or nullptr.
+        [[nodiscard]] Value* Find(EndpointKey key) noexcept
+        {
+            if (key == EmptyKey) {
+                return nullptr;
+            }
+            if (key == _lastKey) {
+                return &_slots[_lastIndex].value;
+            }
+            for (auto i = Home(key);; i = (i + 1) & _mask) {
+                auto& slot = _slots[i];
+                if (slot.key == key) {
+                    _lastKey = key;
+                    _lastIndex = i;
+                    return &slot.value;
+                }
+                if (slot.key == EmptyKey) {
+                    return nullptr;
+                }
+            }
+        }
+
+        /// Insert or replace the value for `key`. Returns a reference to the stored value.
+        Value& Insert(EndpointKey key, Value value)
+        {
+            assert(key != EmptyKey && "0.0.0.0:0 cannot be stored");
+            if ((_size + 1) * 2 > _slots.size()) {
+                Rehash(_slots.size() * 2);
+            }
+            for (auto i = Home(key);; i = (i + 1) & _mask) {
+                auto& slot = _slots[i];
+                if (slot.key == key) {
+                    slot.value = std::move(value);
+                    return slot.value;
+                }
+                if (slot.key == EmptyKey) {
+                    slot.key = key;
+                    slot.value = std::move(value);
+                    ++_size;
+                    return slot.value;
+                }
+            }
+        }
+
+        /// Remove `key`. Returns true if it was present.
+        bool Erase(EndpointKey key)
+        {
+            if (key == EmptyKey) {
+                return false;
+            }
+            auto i = Home(key);
+            while (_slots[i].key != key) {
+                if (_slots[i].key == EmptyKey) {
+                    return false;
+                }
+                i = (i + 1) & _mask;
+            }
+
+            // Backward-shift: pull following entries of the probe chain into the hole
+            for (auto j = (i + 1) & _mask; _slots[j].key != EmptyKey; j = (j + 1) & _mask) {
+                const auto home = Home(_slots[j].key);
+                // Move j into hole i unless its home lies cyclically in (i, j]
+                const bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+                if (!stays) {
+                    _slots[i] = std::move(_slots[j]);
+                    i = j;
+                }
+            }
+            _slots[i] = Slot{};
+            --_size;
+            ResetCache();
+            return true;
+        }
+
+        /// Visit every (key, value) pair. The callback must not modify the table.
+        template <class F>
+        void ForEach(F&& f)
+        {
+            for (auto& slot : _slots) {
+                if (slot.key != EmptyKey) {
+                    f(slot.key, slot.value);
+                }
+            }
+        }
+
+        void Clear()
+        {
+            for (auto& slot : _slots) {
+                slot = Slot{};
+            }
+            _size = 0;
+            ResetCache();
+        }
+
+    private:
+        static constexpr EndpointKey EmptyKey = 0;
+        static constexpr EndpointKey NoKey = ~EndpointKey{0}; // never packed: only 48 bits are used
+
+        struct Slot
+        {
+            EndpointKey key = EmptyKey;
+            Value value{};
+        };
+
+        [[nodiscard]] std::size_t Home(EndpointKey key) const noexcept
+        {
+            // splitmix64 finalizer: address and port bits both reach the low bits
+            key ^= key >> 30;
+            key *= 0xbf58476d1ce4e5b9ULL;
+            key ^= key >> 27;
+            key *= 0x94d049bb133111ebULL;
+            key ^= key >> 31;
+            return static_cast<std::size_t>(key) & _mask;
+        }
+
+        void Rehash(std::size_t capacity)
+        {
+            auto old = std::exchange(_slots, std::vector<Slot>(capacity));
+            _mask = capacity - 1;
+            _size = 0;
+            ResetCache();
+            for (auto& slot : old) {
+                if (slot.key != EmptyKey) {
+                    Insert(slot.key, std::move(slot.value));
+                }
+            }
+        }
+
+        void ResetCache() noexcept
+        {
+            _lastKey = NoKey;
+            _lastIndex = 0;
+        }
+
+        std::vector<Slot> _slots;
+        std::size_t _mask;
+        std::size_t _size = 0;
+        EndpointKey _lastKey = NoKey;
+        std::size_t _lastIndex = 0;
+    };
+}
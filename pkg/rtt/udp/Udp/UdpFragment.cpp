@@ -0,0 +1,93 @@
+#include "UdpFragment.h"
+
+#include "Log/Log.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace Rtt::Udp
+{
+    using namespace Fragment;
+
+    UdpReassembler::UdpReassembler(const UdpFragmentOptions& options) noexcept
+        : _maxMessageSize(options.maxMessageSize)
+        , _bufferLimit(options.reassemblyBufferSize)
+        , _timeout(options.reassemblyTimeout)
+    {}
+
+    auto UdpReassembler::Add(std::span<const std::byte> datagram, Clock::time_point now)
+        -> std::optional<std::vector<std::byte>>
+    {
+        Expire(now);
+
+        if (datagram.size() < HeaderSize) {
+            return std::nullopt;
+        }
+        const auto header = ReadHeader(datagram);
+        const auto chunk = datagram.subspan(HeaderSize);
+
+        // Reject anything the sender could not have produced
+        if (header.count == 0 || header.index >= header.count ||
+            header.totalSize == 0 || header.totalSize > _maxMessageSize || header.totalSize > _bufferLimit) {
+            Log::Trace("bad fragment {}/{} of {} bytes", header.index, header.count, header.totalSize);
+            return std::nullopt;
+        }
+        const auto chunkSize = ChunkSize(header.totalSize, header.count);
+        const auto offset = header.index * chunkSize;
+        if (offset >= header.totalSize || chunk.size() != std::min(chunkSize, header.totalSize - offset)) {
+            Log::Trace("bad fragment {}/{}: {} bytes at offset {}", header.index, header.count, chunk.size(), offset);
+            return std::nullopt;
+        }
+
+        auto it = std::ranges::find(_partials, header.messageId, &Partial::messageId);
+        if (it != _partials.end() && (it->count != header.count || it->data.size() != header.totalSize)) {
+            // Message id reused by a new message before the old one completed
+            Drop(static_cast<std::size_t>(it - _partials.begin()));
+            it = _partials.end();
+        }
+        if (it == _partials.end()) {
+            while (!_partials.empty() && _buffered + header.totalSize > _bufferLimit) {
+                Drop(0);
+            }
+            _buffered += header.totalSize;
+            it = _partials.insert(_partials.end(), Partial{
+                .messageId = header.messageId,
+                .count = header.count,
+                .remaining = header.count,
+                .started = now,
+                .received = std::vector<bool>(header.count),
+                .data = std::vector<std::byte>(header.totalSize),
+            });
+        }
+
+        if (it->received[header.index]) {
+            return std::nullopt; // duplicate datagram
+        }
+        it->received[header.index] = true;
+        std::memcpy(it->data.data() + offset, chunk.data(), chunk.size());
+        if (--it->remaining > 0) {
+            return std::nullopt;
+        }
+
+        auto message = std::move(it->data);
+        _buffered -= message.size();
+        _partials.erase(it);
+        return message;
+    }
+
+    void UdpReassembler::Expire(Clock::time_point now)
+    {
+        // Oldest first: stop at the first one still within its timeout
+        while (!_partials.empty() && now - _partials.front().started > _timeout) {
+            Log::Trace("reassembly timed out for message {}", _partials.front().messageId);
+            Drop(0);
+        }
+    }
+
+    void UdpReassembler::Drop(std::size_t index)
+    {
+        _buffered -= _partials[index].data.size();
+        _partials.erase(_partials.begin() + static_cast<std::ptrdiff_t>(index));
+        ++_dropped;
+    }
+}
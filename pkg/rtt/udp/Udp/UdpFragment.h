@@ -0,0 +1,165 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Rtt::Udp
+{
+    /// Per-link fragmentation settings, taken from the transport's Options.
+    struct UdpFragmentOptions
+    {
+        /// Largest message Send() accepts. 0 = fragmentation off: one message is
+        /// one datagram, unframed. Otherwise every datagram carries a frame tag,
+        /// so both peers must use the same setting.
+        std::size_t maxMessageSize = 0;
+
+        /// Bytes of incomplete messages kept per link. When a new message does not
+        /// fit, the oldest incomplete ones are dropped.
+        std::size_t reassemblyBufferSize = 256 * 1024;
+
+        /// Incomplete messages older than this are dropped.
+        std::chrono::milliseconds reassemblyTimeout{1000};
+
+        /// Minimum time between ping frames measuring the link's RTT (see
+        /// ILink::GetStats). Pings ride the frame tag, so a non-zero interval
+        /// frames every datagram even when maxMessageSize is 0; both peers must
+        /// agree. 0 = no pings (default).
+        std::chrono::milliseconds pingInterval{0};
+
+        [[nodiscard]] bool Enabled() const noexcept { return maxMessageSize > 0; }
+    };
+
+    /// Wire format of a framed link (integers big-endian).
+    ///
+    ///     Whole:    [tag=0] payload...
+    ///     Fragment: [tag=1][messageId:16][index][count][totalSize:24] chunk...
+    ///     Ping:     [tag=2][stamp:64]
+    ///     Pong:     [tag=3][stamp:64]    (the Ping's stamp, echoed)
+    ///
+    /// A message that fits one datagram goes out Whole. Larger ones are cut into
+    /// `count` chunks of ceil(totalSize / count) bytes (the last one shorter), so
+    /// the receiver places chunk `index` without knowing the sender's datagram size.
+    /// The Ping stamp is the sender's own clock, so no clock sync is needed.
+    namespace Fragment
+    {
+        enum class Tag : std::uint8_t
+        {
+            Whole = 0,
+            Fragment = 1,
+            Ping = 2,
+            Pong = 3,
+        };
+
+        inline constexpr std::size_t WholeHeaderSize = 1;
+        inline constexpr std::size_t HeaderSize = 8;
+        inline constexpr std::size_t PingSize = 9;
+        inline constexpr std::size_t MaxFragments = 255;
+        inline constexpr std::size_t MaxTotalSize = (1U << 24) - 1;
+
+        struct Header
+        {
+            std::uint16_t messageId = 0;
+            std::uint8_t index = 0;
+            std::uint8_t count = 0;
+            std::uint32_t totalSize = 0;
+        };
+
+        /// Bytes per chunk for a message of `totalSize` split into `count` chunks.
+        constexpr std::size_t ChunkSize(std::size_t totalSize, std::size_t count) noexcept
+        {
+            return (totalSize + count - 1) / count;
+        }
+
+        inline void WriteHeader(std::span<std::byte, HeaderSize> out, const Header& h) noexcept
+        {
+            out[0] = static_cast<std::byte>(Tag::Fragment);
+            out[1] = static_cast<std::byte>(h.messageId >> 8);
+            out[2] = static_cast<std::byte>(h.messageId);
+            out[3] = static_cast<std::byte>(h.index);
+            out[4] = static_cast<std::byte>(h.count);
+            out[5] = static_cast<std::byte>(h.totalSize >> 16);
+            out[6] = static_cast<std::byte>(h.totalSize >> 8);
+            out[7] = static_cast<std::byte>(h.totalSize);
+        }
+
+        /// Requires data.size() >= HeaderSize and a Fragment tag.
+        inline Header ReadHeader(std::span<const std::byte> in) noexcept
+        {
+            const auto u = [&](std::size_t i) { return std::to_integer<std::uint32_t>(in[i]); };
+            return {
+                .messageId = static_cast<std::uint16_t>((u(1) << 8) | u(2)),
+                .index = static_cast<std::uint8_t>(u(3)),
+                .count = static_cast<std::uint8_t>(u(4)),
+                .totalSize = (u(5) << 16) | (u(6) << 8) | u(7),
+            };
+        }
+
+        /// Write a Ping or Pong frame.
+        inline void WritePing(std::span<std::byte, PingSize> out, Tag tag, std::uint64_t stamp) noexcept
+        {
+            out[0] = static_cast<std::byte>(tag);
+            for (std::size_t i = 1; i < PingSize; ++i) {
+                out[i] = static_cast<std::byte>(stamp >> (8 * (PingSize - 1 - i)));
+            }
+        }
+
+        /// Requires data.size() == PingSize.
+        inline std::uint64_t ReadStamp(std::span<const std::byte> in) noexcept
+        {
+            std::uint64_t stamp = 0;
+            for (std::size_t i = 1; i < PingSize; ++i) {
+                stamp = (stamp << 8) | std::to_integer<std::uint64_t>(in[i]);
+            }
+            return stamp;
+        }
+    }
+
+    /// Reassembles fragmented messages of one link.
+    ///
+    /// Partial messages live in per-message buffers bounded by
+    /// `reassemblyBufferSize` in total; expired ones are dropped lazily on the
+    /// next fragment, so no timer is needed. Not thread-safe: used from the
+    /// link's receive path only.
+    class UdpReassembler
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit UdpReassembler(const UdpFragmentOptions& options) noexcept;
+
+        /// Feed one Fragment datagram (tag included). Returns the complete
+        /// message once its last missing chunk arrives.
+        [[nodiscard]] std::optional<std::vector<std::byte>> Add(std::span<const std::byte> datagram,
+                                                                Clock::time_point now);
+
+        /// Bytes currently held by incomplete messages.
+        [[nodiscard]] std::size_t BufferedBytes() const noexcept { return _buffered; }
+
+        /// Incomplete messages dropped on timeout or to make room.
+        [[nodiscard]] std::uint64_t DroppedCount() const noexcept { return _dropped; }
+
+    private:
+        struct Partial
+        {
+            std::uint16_t messageId = 0;
+            std::uint8_t count = 0;
+            std::uint8_t remaining = 0;
+            Clock::time_point started;
+            std::vector<bool> received;
+            std::vector<std::byte> data;
+        };
+
+        void Expire(Clock::time_point now);
+        void Drop(std::size_t index);
+
+        std::size_t _maxMessageSize;
+        std::size_t _bufferLimit;
+        Clock::duration _timeout;
+        std::vector<Partial> _partials; // oldest first
+        std::size_t _buffered = 0;
+        std::uint64_t _dropped = 0;
+    };
+}
@@ -0,0 +1,146 @@
+#include "UdpHandshake.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <random>
+
+namespace Rtt::Udp
+{
+    // -----------------------------------------------------------------------
+    // Messages
+    // -----------------------------------------------------------------------
+
+    namespace Handshake
+    {
+        std::optional<Message> Classify(std::span<const std::byte> data) noexcept
+        {
+            if (data.size() < HeaderSize || data.size() > MaxMessageSize ||
+                !std::equal(Magic.begin(), Magic.end(), data.begin())) {
+                return std::nullopt;
+            }
+            const auto message = static_cast<Message>(data[Magic.size()]);
+            if (SizeOf(message) != data.size()) {
+                return std::nullopt; // unknown type or wrong size
+            }
+            return message;
+        }
+
+        std::size_t Write(std::span<std::byte> out, Message message, const Cookie& cookie) noexcept
+        {
+            const auto size = SizeOf(message);
+            std::ranges::fill(out.first(size), std::byte{0}); // Hello padding
+            std::ranges::copy(Magic, out.begin());
+            out[Magic.size()] = static_cast<std::byte>(message);
+            if (message == Message::Challenge || message == Message::Response) {
+                std::ranges::copy(cookie, out.begin() + HeaderSize);
+            }
+            return size;
+        }
+
+        Cookie ReadCookie(std::span<const std::byte> data) noexcept
+        {
+            Cookie cookie;
+            std::copy_n(data.begin() + HeaderSize, CookieSize, cookie.begin());
+            return cookie;
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    // UdpCookies
+    // -----------------------------------------------------------------------
+
+    namespace
+    {
+        /// SipHash-2-4 of two little-endian words (12 significant bytes).
+        std::uint64_t SipHash24(const UdpCookies::Secret& key, std::uint64_t m0, std::uint64_t m1) noexcept
+        {
+            std::uint64_t v0 = 0x736f6d6570736575ULL ^ key[0];
+            std::uint64_t v1 = 0x646f72616e646f6dULL ^ key[1];
+            std::uint64_t v2 = 0x6c7967656e657261ULL ^ key[0];
+            std::uint64_t v3 = 0x7465646279746573ULL ^ key[1];
+
+            const auto round = [&] {
+                v0 += v1; v1 = std::rotl(v1, 13); v1 ^= v0; v0 = std::rotl(v0, 32);
+                v2 += v3; v3 = std::rotl(v3, 16); v3 ^= v2;
+                v0 += v3; v3 = std::rotl(v3, 21); v3 ^= v0;
+                v2 += v1; v1 = std::rotl(v1, 17); v1 ^= v2; v2 = std::rotl(v2, 32);
+            };
+            const auto compress = [&](std::uint64_t m) {
+                v3 ^= m;
+                round();
+                round();
+                v0 ^= m;
+            };
+
+            constexpr std::uint64_t Length = 12;
+            compress(m0);
+            compress((m1 & 0xffffffffULL) | (Length << 56));
+            v2 ^= 0xff;
+            round();
+            round();
+            round();
+            round();
+            return v0 ^ v1 ^ v2 ^ v3;
+        }
+
+        void StoreBigEndian(std::span<std::byte> out, std::uint64_t value) noexcept
+        {
+            for (std::size_t i = 0; i < out.size(); ++i) {
+                out[i] = static_cast<std::byte>(value >> (8 * (out.size() - 1 - i)));
+            }
+        }
+
+        std::uint64_t LoadBigEndian(std::span<const std::byte> in) noexcept
+        {
+            std::uint64_t value = 0;
+            for (const auto b : in) {
+                value = (value << 8) | std::to_integer<std::uint64_t>(b);
+            }
+            return value;
+        }
+    }
+
+    UdpCookies::UdpCookies(std::chrono::seconds lifetime)
+        : UdpCookies([] {
+            std::random_device rd;
+            const auto word = [&] { return (std::uint64_t{rd()} << 32) | rd(); };
+            return Secret{word(), word()};
+        }(), lifetime)
+    {}
+
+    UdpCookies::UdpCookies(const Secret& secret, std::chrono::seconds lifetime)
+        : _secret(secret)
+        , _lifetime(lifetime)
+    {}
+
+    std::uint32_t UdpCookies::Seconds(Clock::time_point now) const noexcept
+    {
+        // Unix seconds: 32 bits last until 2106
+        return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count());
+    }
+
+    std::uint64_t UdpCookies::Mac(EndpointKey peer, std::uint32_t issued) const noexcept
+    {
+        return SipHash24(_secret, peer, issued);
+    }
+
+    Handshake::Cookie UdpCookies::Make(EndpointKey peer, Clock::time_point now) const noexcept
+    {
+        const auto issued = Seconds(now);
+        Handshake::Cookie cookie;
+        StoreBigEndian(std::span{cookie}.first(4), issued);
+        StoreBigEndian(std::span{cookie}.subspan(4), Mac(peer, issued));
+        return cookie;
+    }
+
+    bool UdpCookies::Verify(EndpointKey peer, const Handshake::Cookie& cookie, Clock::time_point now) const noexcept
+    {
+        const auto issued = static_cast<std::uint32_t>(LoadBigEndian(std::span{cookie}.first(4)));
+        const auto current = Seconds(now);
+        if (issued > current || std::chrono::seconds(current - issued) > _lifetime) {
+            return false;
+        }
+        return LoadBigEndian(std::span{cookie}.subspan(4)) == Mac(peer, issued);
+    }
+}
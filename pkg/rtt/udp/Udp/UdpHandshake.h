@@ -0,0 +1,100 @@
+#pragma once
+#include "UdpDispatchTable.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace Rtt::Udp
+{
+    /// Stateless cookie handshake gating link creation in UdpServer, modelled on
+    /// DTLS HelloVerifyRequest:
+    ///
+    ///     client                         server
+    ///     Hello            ------------>  (no state) cookie = MAC(secret, addr:port, time)
+    ///                      <------------  Challenge(cookie)
+    ///     Response(cookie) ------------>  verify, create link
+    ///                      <------------  Accept
+    ///
+    /// A spoofed source never sees the Challenge, so it cannot produce a Response;
+    /// the server keeps no per-sender state until one verifies. The Hello is padded
+    /// to the Challenge size so the server never answers with more bytes than it got.
+    ///
+    /// Every message starts with a 4-byte magic and a type byte and has a fixed size.
+    namespace Handshake
+    {
+        enum class Message : std::uint8_t
+        {
+            Hello = 1,
+            Challenge = 2,
+            Response = 3,
+            Accept = 4,
+        };
+
+        inline constexpr std::array<std::byte, 4> Magic{std::byte{'R'}, std::byte{'T'}, std::byte{'H'}, std::byte{'S'}};
+        inline constexpr std::size_t HeaderSize = Magic.size() + 1;
+        inline constexpr std::size_t CookieSize = 12; // [issued:32][mac:64]
+        inline constexpr std::size_t CookieMessageSize = HeaderSize + CookieSize;
+        inline constexpr std::size_t HelloSize = CookieMessageSize;
+        inline constexpr std::size_t AcceptSize = HeaderSize;
+        inline constexpr std::size_t MaxMessageSize = CookieMessageSize;
+
+        using Cookie = std::array<std::byte, CookieSize>;
+
+        /// Size of a message of the given type.
+        constexpr std::size_t SizeOf(Message message) noexcept
+        {
+            switch (message) {
+            case Message::Hello: return HelloSize;
+            case Message::Challenge:
+            case Message::Response: return CookieMessageSize;
+            case Message::Accept: return AcceptSize;
+            }
+            return 0;
+        }
+
+        /// Type of a handshake datagram, or nullopt for anything else.
+        std::optional<Message> Classify(std::span<const std::byte> data) noexcept;
+
+        /// Write a message into `out` (at least SizeOf(message) bytes). The cookie
+        /// is used by Challenge and Response only. Returns the message size.
+        std::size_t Write(std::span<std::byte> out, Message message, const Cookie& cookie = {}) noexcept;
+
+        /// Requires Classify(data) to be Challenge or Response.
+        Cookie ReadCookie(std::span<const std::byte> data) noexcept;
+    }
+
+    /// Issues and checks handshake cookies.
+    ///
+    /// A cookie binds the sender's packed IPv4 endpoint and the issue time (whole
+    /// seconds of the system clock) with a keyed MAC (SipHash-2-4 under a random
+    /// 128-bit secret), and is valid for `lifetime`. Const and thread-safe.
+    ///
+    /// The wall clock is what lets instances with the same secret accept each
+    /// other's cookies; their clocks must agree to well within `lifetime`.
+    class UdpCookies
+    {
+    public:
+        using Clock = std::chrono::system_clock;
+        using Secret = std::array<std::uint64_t, 2>;
+
+        /// Random secret from std::random_device.
+        explicit UdpCookies(std::chrono::seconds lifetime = std::chrono::seconds(10));
+
+        /// Fixed secret, e.g. shared by several servers behind one address.
+        UdpCookies(const Secret& secret, std::chrono::seconds lifetime);
+
+        [[nodiscard]] Handshake::Cookie Make(EndpointKey peer, Clock::time_point now) const noexcept;
+        [[nodiscard]] bool Verify(EndpointKey peer, const Handshake::Cookie& cookie, Clock::time_point now) const noexcept;
+
+    private:
+        [[nodiscard]] std::uint32_t Seconds(Clock::time_point now) const noexcept;
+        [[nodiscard]] std::uint64_t Mac(EndpointKey peer, std::uint32_t issued) const noexcept;
+
+        Secret _secret;
+        std::chrono::seconds _lifetime;
+    };
+}
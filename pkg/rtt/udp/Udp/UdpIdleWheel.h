@@ -0,0 +1,81 @@
+#pragma once
+#include "UdpDispatchTable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Rtt::Udp
+{
+    /// Timing wheel of endpoint keys driving the server's idle sweep.
+    ///
+    /// Time advances in ticks (Advance() is called once per tick period). A key
+    /// scheduled `n` ticks ahead lands in the slot that comes due after `n`
+    /// Advance() calls, at most Span() ticks out. Receiving a datagram does not
+    /// touch the wheel: the caller stamps the peer with Now() and re-schedules it
+    /// lazily when its slot comes due, so the hot path is a single store.
+    ///
+    /// Keys are not removed on disconnect; the caller recognises stale entries
+    /// (see Slot index returned by Schedule()) and skips them.
+    ///
+    /// Not thread-safe: owned by one listening socket's executor.
+    class UdpIdleWheel
+    {
+    public:
+        /// @param span Ticks in one idle timeout (> 0).
+        explicit UdpIdleWheel(std::size_t span)
+            : _slots(span + 1)
+        {}
+
+        /// Ticks in one idle timeout; the furthest a key may be scheduled.
+        [[nodiscard]] std::uint64_t Span() const noexcept { return _slots.size() - 1; }
+
+        /// Ticks elapsed since construction.
+        [[nodiscard]] std::uint64_t Now() const noexcept { return _now; }
+
+        /// Schedule `key` `ticks` (1..Span()) ticks ahead. Returns its slot index.
+        std::uint32_t Schedule(EndpointKey key, std::uint64_t ticks)
+        {
+            const auto slot = static_cast<std::uint32_t>((_now + ticks) % _slots.size());
+            _slots[slot].push_back(key);
+            return slot;
+        }
+
+        /// Advance one tick and hand every key of the slot that came due to
+        /// `f(key, slot)`. `f` may Schedule() again: 1..Span() ticks ahead is
+        /// never the slot being walked.
+        template <class F>
+        void Advance(F&& f)
+        {
+            ++_now;
+            const auto slot = static_cast<std::uint32_t>(_now % _slots.size());
+            // Swap out so re-scheduling cannot touch the list being walked;
+            // the buffer goes back afterwards to keep its capacity
+            std::swap(_due, _slots[slot]);
+            for (const auto key : _due) {
+                f(key, slot);
+            }
+            _due.clear();
+            std::swap(_due, _slots[slot]);
+        }
+
+        /// Visit slots in due order as `f(keys, slot)` until `f` returns true.
+        template <class F>
+        void VisitInDueOrder(F&& f) const
+        {
+            for (std::uint64_t ahead = 1; ahead < _slots.size(); ++ahead) {
+                const auto slot = static_cast<std::uint32_t>((_now + ahead) % _slots.size());
+                if (!_slots[slot].empty() && f(std::span<const EndpointKey>{_slots[slot]}, slot)) {
+                    return;
+                }
+            }
+        }
+
+    private:
+        std::vector<std::vector<EndpointKey>> _slots;
+        std::vector<EndpointKey> _due;
+        std::uint64_t _now = 0;
+    };
+}
@@ -1,8 +1,15 @@
 #include "UdpLink.h"
 
 #include "Log/Log.h"
+#include "Rtt/SendScratch.h"
+#include <algorithm>
+#include <array>
 #include <boost/asio/buffer.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/error.hpp>
+#include <chrono>
 #include <cstring>
+#include <span>
 #include <utility>
 
 namespace Rtt::Udp
@@ -14,13 +21,20 @@ namespace Rtt::Udp
     UdpLink::UdpLink(boost::asio::ip::udp::socket socket,
                      PeerId localId,
                      PeerId remoteId,
-                     std::size_t maxDatagramSize)
+                     std::size_t maxDatagramSize,
+                     std::shared_ptr<UdpSendPool> sendPool,
+                     UdpFragmentOptions fragment,
+                     std::shared_ptr<LinkCounters> counters)
         : _ownedSocket(std::move(socket))
         , _localId(std::move(localId))
         , _remoteId(std::move(remoteId))
         , _maxDatagramSize(maxDatagramSize)
-        , _recvBuf(maxDatagramSize)
-    {}
+        , _sendPool(std::move(sendPool))
+        , _fragment(fragment)
+        , _counters(std::move(counters))
+    {
+        Init();
+    }
 
     // -----------------------------------------------------------------------
     // Shared mode constructor
@@ -31,15 +45,38 @@ namespace Rtt::Udp
                      PeerId localId,
                      PeerId remoteId,
                      std::size_t maxDatagramSize,
-                     RemoveFromDispatch removeFromDispatch)
+                     std::shared_ptr<UdpSendPool> sendPool,
+                     std::shared_ptr<UdpSendBatch> sendBatch,
+                     RemoveFromDispatch removeFromDispatch,
+                     UdpFragmentOptions fragment,
+                     std::shared_ptr<LinkCounters> counters)
         : _sharedSocket(std::move(sharedSocket))
         , _remoteEndpoint(std::move(remoteEndpoint))
+        , _sendBatch(std::move(sendBatch))
         , _localId(std::move(localId))
         , _remoteId(std::move(remoteId))
         , _maxDatagramSize(maxDatagramSize)
+        , _sendPool(std::move(sendPool))
         , _removeFromDispatch(std::move(removeFromDispatch))
-        , _recvBuf(maxDatagramSize)
-    {}
+        , _fragment(fragment)
+        , _counters(std::move(counters))
+    {
+        Init();
+    }
+
+    void UdpLink::Init()
+    {
+        if (!_counters) {
+            _counters = std::make_shared<LinkCounters>();
+        }
+        if (_fragment.pingInterval.count() > 0 && !_fragment.Enabled()) {
+            // Pings need the frame tag: frame every datagram, messages still fit one
+            _fragment.maxMessageSize = _maxDatagramSize - Fragment::WholeHeaderSize;
+        }
+        if (_fragment.Enabled()) {
+            _reassembler.emplace(_fragment);
+        }
+    }
 
     // -----------------------------------------------------------------------
     // ILink
@@ -47,50 +84,338 @@ namespace Rtt::Udp
 
     const PeerId& UdpLink::LocalId() const { return _localId; }
     const PeerId& UdpLink::RemoteId() const { return _remoteId; }
+    LinkStats UdpLink::GetStats() const { return _counters->Snapshot(); }
 
     void UdpLink::Send(WriteCallback writer)
     {
+        if (OffShard()) {
+            // The writer's captures live on the caller's stack: run it now into
+            // this thread's scratch and hand the shard a copy of the message
+            SendScratch scratch{_fragment.Enabled() ? _fragment.maxMessageSize : _maxDatagramSize};
+            const auto message = scratch.Span();
+            const auto bytesWritten = writer(message);
+            if (bytesWritten > 0) {
+                DispatchToShard({message.begin(), message.begin() + static_cast<std::ptrdiff_t>(bytesWritten)});
+            }
+            return;
+        }
         if (_closed) { 
             return;
         }
+        if (!Writable()) {
+            _counters->OnSendDrop();
+            return;
+        }
 
-        std::vector<std::byte> buf(_maxDatagramSize);
-        auto bytesWritten = writer(std::span<std::byte>{buf});
-        if (bytesWritten == 0) { 
+        if (_fragment.Enabled()) {
+            // Fragmentation: the writer may fill up to maxMessageSize. Framing
+            // sends or copies it before returning, so the thread's scratch will do
+            SendScratch scratch{_fragment.maxMessageSize};
+            const auto message = scratch.Span();
+            const auto bytesWritten = writer(message);
+            if (bytesWritten == 0) {
+                return;
+            }
+            const std::span<const std::byte> parts[] = {message.first(bytesWritten)};
+            SendFramed(parts);
             return;
         }
 
-        buf.resize(bytesWritten);
+        auto buf = _sendPool->Acquire();
+        auto bytesWritten = writer(buf.Span());
+        if (bytesWritten == 0) { 
+            return;
+        }
 
         Log::Trace("send {} bytes {} -> {}", bytesWritten, _localId.value, _remoteId.value);
+        SendPooled(std::move(buf), bytesWritten);
+    }
 
+    void UdpLink::SendPooled(UdpSendPool::Buffer buf, std::size_t bytesWritten)
+    {
+        if (_sendBatch) {
+            // Shared mode, batched: queued until the server flushes the frame's sends
+            if (_sendBatch->Enqueue(std::move(buf), bytesWritten, _remoteEndpoint)) {
+                _counters->OnSent(bytesWritten);
+            } else {
+                _counters->OnSendDrop();
+            }
+            return;
+        }
+        _counters->OnSent(bytesWritten);
+
+        // Build the asio buffer before moving `buf` into the completion handler:
+        // argument evaluation order is unspecified.
+        auto payload = boost::asio::buffer(buf.Data(), bytesWritten);
+        auto self = std::static_pointer_cast<UdpLink>(ILink::shared_from_this());
+        auto onSent = [self, bytesWritten, data = std::move(buf)](boost::system::error_code, std::size_t) {
+            // Fire-and-forget — slab kept alive by capture, recycled on handler destruction
+            self->OnSendCompleted(bytesWritten);
+        };
+
+        const auto outstanding = _outstanding.fetch_add(bytesWritten, std::memory_order_relaxed) + bytesWritten;
+        if (_maxOutstanding > 0 && outstanding >= _maxOutstanding) {
+            _blocked = true;
+        }
         if (_ownedSocket) {
             // Connected mode: async_send on dedicated socket
-            auto self = ILink::shared_from_this();
-            _ownedSocket->async_send(
-                boost::asio::buffer(buf.data(), buf.size()),
-                [self, data = std::move(buf)](boost::system::error_code, std::size_t) {
-                    // Fire-and-forget — data kept alive by capture
-                });
+            _ownedSocket->async_send(payload, std::move(onSent));
         } else if (_sharedSocket) {
             // Shared mode: async_send_to on shared socket
-            auto self = ILink::shared_from_this();
-            auto ep = _remoteEndpoint;
-            _sharedSocket->async_send_to(
-                boost::asio::buffer(buf.data(), buf.size()),
-                ep,
-                [self, data = std::move(buf)](boost::system::error_code, std::size_t) {
-                    // Fire-and-forget
-                });
+            _sharedSocket->async_send_to(payload, _remoteEndpoint, std::move(onSent));
+        }
+    }
+
+    void UdpLink::OnSendCompleted(std::size_t bytes)
+    {
+        const auto outstanding = _outstanding.fetch_sub(bytes, std::memory_order_relaxed) - bytes;
+        if (!_blocked || _closed || outstanding > _maxOutstanding / 2) {
+            return;
+        }
+
+        // Drained to the low watermark: deferred writers first, in order
+        _blocked = false;
+        while (!_deferred.empty() && Writable() && !_closed) {
+            auto writer = std::move(_deferred.front());
+            _deferred.pop_front();
+            Send(std::move(writer));
+        }
+        if (!_deferred.empty()) {
+            _blocked = true;
+            return;
+        }
+        if (_handler.onWritable && !_closed) {
+            _handler.onWritable();
+        }
+    }
+
+    bool UdpLink::Writable() const
+    {
+        return _maxOutstanding == 0 || _outstanding.load(std::memory_order_relaxed) < _maxOutstanding;
+    }
+
+    std::size_t UdpLink::OutstandingBytes() const
+    {
+        return _outstanding.load(std::memory_order_relaxed);
+    }
+
+    void UdpLink::SendWhenWritable(WriteCallback writer)
+    {
+        if (OffShard()) {
+            // Deferred writers outlive the call by contract: move it over as is
+            auto self = std::static_pointer_cast<UdpLink>(ILink::shared_from_this());
+            boost::asio::dispatch(*_shardExecutor, [self, writer = std::move(writer)]() mutable {
+                self->SendWhenWritable(std::move(writer));
+            });
+            return;
+        }
+        if (_closed) {
+            return;
+        }
+        if (_deferred.empty() && Writable()) {
+            Send(std::move(writer));
+            return;
+        }
+        _deferred.push_back(std::move(writer));
+        _blocked = true;
+    }
+
+    void UdpLink::SendV(ConstBufferSequence buffers)
+    {
+        if (OffShard()) {
+            std::vector<std::byte> message(BufferSize(buffers));
+            GatherInto(buffers, message);
+            DispatchToShard(std::move(message));
+            return;
+        }
+        if (_closed) {
+            return;
+        }
+        if (!Writable()) {
+            _counters->OnSendDrop();
+            return;
+        }
+        if (_fragment.Enabled()) {
+            SendFramed(buffers);
+            return;
+        }
+        SendDatagram(buffers);
+    }
+
+    void UdpLink::DispatchToShard(std::vector<std::byte> message)
+    {
+        auto self = std::static_pointer_cast<UdpLink>(ILink::shared_from_this());
+        boost::asio::dispatch(*_shardExecutor, [self, message = std::move(message)] {
+            const std::span<const std::byte> parts[] = {message};
+            self->SendV(parts);
+        });
+    }
+
+    void UdpLink::SendDatagram(ConstBufferSequence buffers)
+    {
+        const auto total = BufferSize(buffers);
+        if (total == 0 || total > _maxDatagramSize) {
+            _counters->OnSendDrop();
+            Log::Trace("sendv dropped: {} bytes (max {}) {} -> {}", total, _maxDatagramSize, _localId.value, _remoteId.value);
+            return;
+        }
+
+        // Batched sends own their data until the flush: gather into a pooled buffer
+        const auto sendPooledCopy = [&] {
+            auto buf = _sendPool->Acquire();
+            const auto bytes = GatherInto(buffers, buf.Span());
+            SendPooled(std::move(buf), bytes);
+        };
+        if (_sendBatch || buffers.size() > MaxGatherBuffers) {
+            sendPooledCopy();
+            return;
+        }
+
+        std::array<boost::asio::const_buffer, MaxGatherBuffers> sequence;
+        for (std::size_t i = 0; i < buffers.size(); ++i) {
+            sequence[i] = boost::asio::buffer(buffers[i].data(), buffers[i].size());
+        }
+        const std::span<const boost::asio::const_buffer> view{sequence.data(), buffers.size()};
+
+        // Sockets are non-blocking (see UdpClient / UdpServer), so this is one
+        // sendmsg() over the caller's buffers, or would_block
+        boost::system::error_code ec;
+        if (_ownedSocket) {
+            auto _ = _ownedSocket->send(view, 0, ec);
+        } else if (_sharedSocket) {
+            auto _ = _sharedSocket->send_to(view, _remoteEndpoint, 0, ec);
+        }
+
+        if (ec == boost::asio::error::would_block || ec == boost::asio::error::try_again) {
+            // Socket buffer full: copy once into a pooled slab and queue asynchronously
+            sendPooledCopy();
+            return;
         }
+        if (ec) {
+            _counters->OnSendDrop();
+            Log::Trace("sendv failed {} -> {} — {}", _localId.value, _remoteId.value, ec.message());
+            return;
+        }
+        _counters->OnSent(total);
+        Log::Trace("sendv {} bytes in {} buffer(s) {} -> {}", total, buffers.size(), _localId.value, _remoteId.value);
+    }
+
+    void UdpLink::SendFramed(ConstBufferSequence buffers)
+    {
+        using namespace Fragment;
+        static constexpr std::byte WholeTag{static_cast<std::uint8_t>(Tag::Whole)};
+
+        const auto total = BufferSize(buffers);
+        if (total == 0 || total > _fragment.maxMessageSize) {
+            _counters->OnSendDrop();
+            Log::Trace("send dropped: {} bytes (max message {}) {} -> {}", total, _fragment.maxMessageSize, _localId.value, _remoteId.value);
+            return;
+        }
+        MaybePing();
+
+        // Common case: one datagram, the tag goes in front of the caller's buffers
+        if (WholeHeaderSize + total <= _maxDatagramSize && buffers.size() < MaxGatherBuffers) {
+            std::array<std::span<const std::byte>, MaxGatherBuffers> parts;
+            parts[0] = {&WholeTag, 1};
+            std::ranges::copy(buffers, parts.begin() + 1);
+            SendDatagram(std::span{parts}.first(buffers.size() + 1));
+            return;
+        }
+
+        std::span<const std::byte> message = buffers.front();
+        std::optional<SendScratch> scratch;
+        if (buffers.size() > 1) {
+            scratch.emplace(total);
+            message = scratch->Span().first(GatherInto(buffers, scratch->Span()));
+        }
+        if (WholeHeaderSize + total <= _maxDatagramSize) {
+            const std::span<const std::byte> parts[] = {{&WholeTag, 1}, message};
+            SendDatagram(parts);
+            return;
+        }
+
+        const auto maxChunk = _maxDatagramSize - HeaderSize;
+        const auto count = (total + maxChunk - 1) / maxChunk;
+        if (count > MaxFragments) {
+            _counters->OnSendDrop();
+            Log::Trace("send dropped: {} bytes need {} fragments {} -> {}", total, count, _localId.value, _remoteId.value);
+            return;
+        }
+        const auto chunkSize = ChunkSize(total, count);
+        const auto messageId = _nextMessageId++;
+
+        Log::Trace("send {} bytes in {} fragments {} -> {}", total, count, _localId.value, _remoteId.value);
+        for (std::size_t i = 0; i < count && !_closed; ++i) {
+            std::array<std::byte, HeaderSize> header;
+            WriteHeader(header, {
+                .messageId = messageId,
+                .index = static_cast<std::uint8_t>(i),
+                .count = static_cast<std::uint8_t>(count),
+                .totalSize = static_cast<std::uint32_t>(total),
+            });
+            const auto offset = i * chunkSize;
+            const std::span<const std::byte> parts[] = {header, message.subspan(offset, std::min(chunkSize, total - offset))};
+            SendDatagram(parts);
+        }
+    }
+
+    void UdpLink::MaybePing()
+    {
+        if (_fragment.pingInterval.count() == 0) {
+            return;
+        }
+        // One Ping in flight; a lost one is given up after MaxPingWait
+        const auto now = std::chrono::steady_clock::now();
+        const auto since = now - _lastPing;
+        if (since < _fragment.pingInterval || (_pingOutstanding && since < MaxPingWait)) {
+            return;
+        }
+        _lastPing = now;
+        _pingOutstanding = true;
+
+        std::array<std::byte, Fragment::PingSize> ping;
+        Fragment::WritePing(ping, Fragment::Tag::Ping, static_cast<std::uint64_t>(now.time_since_epoch().count()));
+        const std::span<const std::byte> parts[] = {ping};
+        SendDatagram(parts);
+    }
+
+    void UdpLink::OnPing(Fragment::Tag tag, std::span<const std::byte> data)
+    {
+        if (data.size() != Fragment::PingSize) {
+            _counters->OnReceiveDrop();
+            return;
+        }
+        const auto stamp = Fragment::ReadStamp(data);
+        if (tag == Fragment::Tag::Ping) {
+            std::array<std::byte, Fragment::PingSize> pong;
+            Fragment::WritePing(pong, Fragment::Tag::Pong, stamp);
+            const std::span<const std::byte> parts[] = {pong};
+            SendDatagram(parts);
+            return;
+        }
+
+        // Only the echo of the Ping in flight counts: late, duplicate or forged
+        // Pongs would skew the estimate
+        if (!_pingOutstanding || stamp != static_cast<std::uint64_t>(_lastPing.time_since_epoch().count())) {
+            return;
+        }
+        _pingOutstanding = false;
+        _counters->OnRttSample(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - _lastPing));
     }
 
     void UdpLink::Disconnect()
     {
+        if (OffShard()) {
+            auto self = std::static_pointer_cast<UdpLink>(ILink::shared_from_this());
+            boost::asio::dispatch(*_shardExecutor, [self] { self->Disconnect(); });
+            return;
+        }
         if (_closed) { 
             return;
         }
         _closed = true;
+        _deferred.clear();
 
         Log::Trace("disconnect {} -> {}", _localId.value, _remoteId.value);
 
@@ -125,11 +450,56 @@ namespace Rtt::Udp
         _handler = std::move(handler);
     }
 
-    void UdpLink::DeliverReceived(std::span<const std::byte> data) const
+    void UdpLink::DeliverReceived(std::span<const std::byte> data, const Packet* packet)
+    {
+        if (!_closed) {
+            OnDatagram(data, packet);
+        }
+    }
+
+    void UdpLink::OnDatagram(std::span<const std::byte> data, const Packet* packet)
+    {
+        _counters->OnReceived(data.size());
+        if (!_reassembler) {
+            DeliverMessage(data, packet);
+            return;
+        }
+
+        if (data.empty()) {
+            _counters->OnReceiveDrop();
+            return;
+        }
+        const auto tag = static_cast<Fragment::Tag>(data[0]);
+        switch (tag) {
+        case Fragment::Tag::Whole:
+            DeliverMessage(data.subspan(Fragment::WholeHeaderSize), packet);
+            break;
+        case Fragment::Tag::Fragment:
+            if (!_handler.onReceived && !_handler.onPacket) {
+                break;
+            }
+            if (auto message = _reassembler->Add(data, std::chrono::steady_clock::now())) {
+                DeliverMessage(*message, nullptr); // reassembly buffer: copied for onPacket
+            }
+            break;
+        case Fragment::Tag::Ping:
+        case Fragment::Tag::Pong:
+            OnPing(tag, data);
+            break;
+        default:
+            _counters->OnReceiveDrop();
+            Log::Trace("unknown frame tag {} from {}", std::to_integer<int>(data[0]), _remoteId.value);
+            break;
+        }
+    }
+
+    void UdpLink::DeliverMessage(std::span<const std::byte> message, const Packet* packet)
     {
-        if (!_closed && _handler.onReceived) {
-            _handler.onReceived(data);
+        if (packet && _handler.onPacket) {
+            _handler.onPacket(packet->Slice(message));
+            return;
         }
+        Deliver(_handler, message);
     }
 
     void UdpLink::DoReceive()
@@ -139,22 +509,44 @@ namespace Rtt::Udp
         }
 
         auto self = std::static_pointer_cast<UdpLink>(ILink::shared_from_this());
+        if (_recvPool) {
+            // Pooled: every datagram gets its own slab, lent to onPacket
+            auto buf = _recvPool->Acquire();
+            const auto space = buf.Span();
+            _ownedSocket->async_receive(
+                boost::asio::buffer(space.data(), space.size()),
+                [self, buf = std::move(buf)](boost::system::error_code ec, std::size_t bytesReceived) mutable {
+                    if (ec) {
+                        self->OnReceiveError(ec);
+                        return;
+                    }
+                    const auto packet = std::move(buf).Publish(bytesReceived);
+                    self->OnDatagram(packet.Span(), &packet);
+                    self->DoReceive();
+                });
+            return;
+        }
+
+        if (_recvBuf.empty()) {
+            _recvBuf.resize(_maxDatagramSize);
+        }
         _ownedSocket->async_receive(
             boost::asio::buffer(_recvBuf.data(), _recvBuf.size()),
             [self](boost::system::error_code ec, std::size_t bytesReceived) {
                 if (ec) {
-                    Log::Trace("receive error {} -> {} — {}",
-                               self->_localId.value, self->_remoteId.value, ec.message());
-                    if (!self->_closed) {
-                        self->Disconnect();
-                    }
+                    self->OnReceiveError(ec);
                     return;
                 }
-                if (self->_handler.onReceived) {
-                    self->_handler.onReceived(
-                        std::span<const std::byte>{self->_recvBuf.data(), bytesReceived});
-                }
+                self->OnDatagram(std::span<const std::byte>{self->_recvBuf.data(), bytesReceived}, nullptr);
                 self->DoReceive();
             });
     }
+
+    void UdpLink::OnReceiveError(boost::system::error_code ec)
+    {
+        Log::Trace("receive error {} -> {} — {}", _localId.value, _remoteId.value, ec.message());
+        if (!_closed) {
+            Disconnect();
+        }
+    }
 }
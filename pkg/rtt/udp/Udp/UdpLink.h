@@ -1,11 +1,22 @@
 #pragma once
 #include "Rtt/Handler.h"
 #include "Rtt/Link.h"
+#include "Rtt/LinkStats.h"
+#include "Rtt/Packet.h"
+#include "UdpFragment.h"
+#include "UdpSendBatch.h"
+#include "UdpSendPool.h"
 
+#include <atomic>
+#include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/udp.hpp>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace Rtt::Udp
@@ -22,6 +33,37 @@ namespace Rtt::Udp
     /// - **Shared** (from Listen): uses a shared unconnected socket owned by
     ///   UdpTransport. Send uses async_send_to, receive is dispatched from
     ///   the transport's receive loop.
+    ///
+    /// Send buffers come from the transport's UdpSendPool in both modes.
+    /// In shared mode sends may go through the server's UdpSendBatch queue.
+    /// SendV() hands the caller's buffer sequence straight to a non-blocking
+    /// send and only gathers into a pooled buffer when that would block or
+    /// the server batches sends.
+    ///
+    /// With fragmentation enabled (UdpFragmentOptions::maxMessageSize > 0) every
+    /// datagram starts with a frame tag: messages that fit one datagram go out
+    /// whole behind a one-byte tag, larger ones are split into fragments and
+    /// reassembled by the receiving link (see UdpFragment.h). Messages are built
+    /// in the thread's SendScratch, not a buffer per link.
+    ///
+    /// Traffic is counted in a LinkCounters block, usually the transport's (see
+    /// TransportStats). With UdpFragmentOptions::pingInterval set, framed sends
+    /// are preceded by a Ping at most once per interval and the peer's Pong
+    /// feeds the RTT estimate; a link that sends nothing takes no samples.
+    ///
+    /// Links of a sharded UdpServer belong to their shard's thread, which owns
+    /// the send pool, the send batch and the dispatch table. Send(), SendV(),
+    /// SendWhenWritable() and Disconnect() called from any other thread are
+    /// moved onto the shard with asio::dispatch: Send() runs the writer first,
+    /// on the caller's thread, and SendV() copies the buffers, so the caller's
+    /// data need not outlive the call. Disconnect() then completes asynchronously.
+    /// When the server is destroyed its links are disconnected on their shard
+    /// and detached from it: calls on a link that outlives the server run
+    /// inline and do nothing.
+    ///
+    /// Backpressure (SetMaxOutstandingBytes): bytes of asynchronous sends still
+    /// waiting for socket buffer space count as outstanding. Synchronous sends
+    /// and the server's send batch (which is bounded by its own queue) do not.
     class UdpLink: public ILink
     {
     public:
@@ -29,7 +71,10 @@ namespace Rtt::Udp
         UdpLink(boost::asio::ip::udp::socket socket,
                 PeerId localId,
                 PeerId remoteId,
-                std::size_t maxDatagramSize);
+                std::size_t maxDatagramSize,
+                std::shared_ptr<UdpSendPool> sendPool,
+                UdpFragmentOptions fragment = {},
+                std::shared_ptr<LinkCounters> counters = {});
 
         /// Construct a shared-mode link (from Listen).
         UdpLink(std::shared_ptr<boost::asio::ip::udp::socket> sharedSocket,
@@ -37,26 +82,93 @@ namespace Rtt::Udp
                 PeerId localId,
                 PeerId remoteId,
                 std::size_t maxDatagramSize,
-                RemoveFromDispatch removeFromDispatch);
+                std::shared_ptr<UdpSendPool> sendPool,
+                std::shared_ptr<UdpSendBatch> sendBatch,
+                RemoveFromDispatch removeFromDispatch,
+                UdpFragmentOptions fragment = {},
+                std::shared_ptr<LinkCounters> counters = {});
 
         // ILink
         [[nodiscard]] const PeerId& LocalId() const override;
         [[nodiscard]] const PeerId& RemoteId() const override;
         void Send(WriteCallback writer) override;
+        void SendV(ConstBufferSequence buffers) override;
         void Disconnect() override;
+        [[nodiscard]] LinkStats GetStats() const override;
+        [[nodiscard]] bool Writable() const override;
+        [[nodiscard]] std::size_t OutstandingBytes() const override;
+        void SendWhenWritable(WriteCallback writer) override;
+
+        /// Outstanding-bytes limit. 0 = unlimited (default). Set by the
+        /// transport before the link is handed out.
+        void SetMaxOutstandingBytes(std::size_t limit) noexcept { _maxOutstanding = limit; }
+
+        /// Thread of a sharded server's io_context the link belongs to (see above).
+        /// Set by the transport before the link is handed out.
+        void SetShardExecutor(boost::asio::io_context::executor_type executor) noexcept { _shardExecutor = executor; }
+
+        /// The shard is shutting down and the link is disconnected: stop moving
+        /// calls onto it. Called on the shard's thread by the server.
+        void DetachShard() noexcept { _shardDetached.store(true, std::memory_order_release); }
+
+        /// Receive into slabs of `pool` instead of one reused buffer (connected
+        /// mode). Set by the transport before StartReceive().
+        void SetReceivePool(std::shared_ptr<PacketPool> pool) noexcept { _recvPool = std::move(pool); }
 
         /// Start the async receive loop (connected mode only).
         /// Must be called after the LinkHandler has been set.
         void StartReceive(LinkHandler handler);
 
         /// Deliver data from the transport's shared receive loop (shared mode).
-        void DeliverReceived(std::span<const std::byte> data) const;
+        /// `packet`, if given, owns `data` and is lent to LinkHandler::onPacket.
+        void DeliverReceived(std::span<const std::byte> data, const Packet* packet = nullptr);
 
         /// Set the handler for disconnect notifications (shared mode).
         void SetHandler(LinkHandler handler);
 
+        /// Longest buffer sequence SendV() passes to the socket as is.
+        static constexpr std::size_t MaxGatherBuffers = 16;
+
+        /// A Ping unanswered for this long is considered lost.
+        static constexpr std::chrono::seconds MaxPingWait{2};
+
     private:
+        /// Sharded and called from a thread other than the shard's, while the shard runs.
+        [[nodiscard]] bool OffShard() const noexcept
+        {
+            return _shardExecutor && !_shardExecutor->running_in_this_thread()
+                && !_shardDetached.load(std::memory_order_acquire);
+        }
+
+        /// Hand a message to the shard thread as one owned buffer.
+        void DispatchToShard(std::vector<std::byte> message);
+
         void DoReceive();
+        void OnDatagram(std::span<const std::byte> data, const Packet* packet);
+        void OnReceiveError(boost::system::error_code ec);
+
+        /// Hand one message to the handler; `packet` owns it unless null.
+        void DeliverMessage(std::span<const std::byte> message, const Packet* packet);
+
+        /// Send one datagram as is: synchronous scatter send, pooled copy on would_block.
+        void SendDatagram(ConstBufferSequence buffers);
+
+        /// Queue `bytes` of a pooled buffer (batched or async send).
+        void SendPooled(UdpSendPool::Buffer buf, std::size_t bytes);
+
+        /// Fragmentation enabled: frame one message, splitting it if needed.
+        void SendFramed(ConstBufferSequence buffers);
+
+        /// An asynchronous send finished: release its bytes, resume deferred writers.
+        void OnSendCompleted(std::size_t bytes);
+
+        /// Send a Ping if pingInterval has passed since the last one.
+        void MaybePing();
+
+        /// Answer a Ping, or take an RTT sample from a Pong.
+        void OnPing(Fragment::Tag tag, std::span<const std::byte> data);
+
+        void Init();
 
         // Connected mode: owns socket directly
         std::optional<boost::asio::ip::udp::socket> _ownedSocket;
@@ -64,14 +176,34 @@ namespace Rtt::Udp
         // Shared mode: borrows shared socket + knows target endpoint
         std::shared_ptr<boost::asio::ip::udp::socket> _sharedSocket;
         boost::asio::ip::udp::endpoint _remoteEndpoint;
+        std::shared_ptr<UdpSendBatch> _sendBatch; // null = per-datagram async_send_to
+        std::optional<boost::asio::io_context::executor_type> _shardExecutor; // sharded server only
+        std::atomic<bool> _shardDetached{false}; // server gone: _closed is set, calls run inline
 
         PeerId _localId;
         PeerId _remoteId;
         std::size_t _maxDatagramSize;
+        std::shared_ptr<UdpSendPool> _sendPool;
         RemoveFromDispatch _removeFromDispatch;
-        std::vector<std::byte> _recvBuf;
+        std::vector<std::byte> _recvBuf; // connected mode only: shared mode receives into the server's buffer
+        std::shared_ptr<PacketPool> _recvPool; // connected mode, pooled receive: replaces _recvBuf
         LinkHandler _handler;
 
+        // Fragmentation (only when enabled)
+        UdpFragmentOptions _fragment;
+        std::optional<UdpReassembler> _reassembler;
+        std::uint16_t _nextMessageId = 0;
+        std::chrono::steady_clock::time_point _lastPing{};
+        bool _pingOutstanding = false;
+
+        std::shared_ptr<LinkCounters> _counters;
+
+        // Backpressure
+        std::size_t _maxOutstanding = 0;
+        std::atomic<std::size_t> _outstanding{0}; // read by Writable() from any thread
+        std::deque<WriteCallback> _deferred;
+        bool _blocked = false; // reached the limit: fire onWritable when drained
+
         bool _closed = false;
     };
 
@@ -0,0 +1,80 @@
+#include "UdpRecvBatch.h"
+
+#include <boost/asio/error.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace Rtt::Udp
+{
+    namespace asio = boost::asio;
+
+#if defined(__linux__)
+    UdpRecvBatch::UdpRecvBatch(std::size_t capacity, std::size_t maxDatagramSize)
+        : _capacity(capacity)
+        , _slotSize(maxDatagramSize)
+        , _storage(capacity * maxDatagramSize)
+        , _headers(capacity)
+        , _iovecs(capacity)
+        , _addrs(capacity)
+    {
+        // Wire every header to its own slot and address once; recvmmsg only
+        // overwrites msg_len, msg_namelen and msg_flags on return.
+        for (std::size_t i = 0; i < capacity; ++i) {
+            _iovecs[i] = {.iov_base = _storage.data() + (i * _slotSize), .iov_len = _slotSize};
+            auto& hdr = _headers[i].msg_hdr;
+            hdr = {};
+            hdr.msg_name = &_addrs[i];
+            hdr.msg_iov = &_iovecs[i];
+            hdr.msg_iovlen = 1;
+        }
+    }
+
+    std::size_t UdpRecvBatch::Receive(asio::ip::udp::socket& socket, boost::system::error_code& ec)
+    {
+        ec.clear();
+        for (auto& h : _headers) {
+            h.msg_hdr.msg_namelen = sizeof(::sockaddr_storage);
+            h.msg_len = 0;
+        }
+
+        const int n = ::recvmmsg(socket.native_handle(), _headers.data(),
+                                 static_cast<unsigned int>(_capacity), MSG_DONTWAIT, nullptr);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                ec = asio::error::would_block;
+            } else {
+                ec.assign(errno, boost::system::system_category());
+            }
+            return 0;
+        }
+        return static_cast<std::size_t>(n);
+    }
+
+    auto UdpRecvBatch::At(std::size_t index) const noexcept -> Datagram
+    {
+        const auto& h = _headers[index];
+        Datagram dg;
+        std::memcpy(dg.sender.data(), &_addrs[index], h.msg_hdr.msg_namelen);
+        dg.sender.resize(h.msg_hdr.msg_namelen);
+        dg.data = {_storage.data() + (index * _slotSize), std::min<std::size_t>(h.msg_len, _slotSize)};
+        return dg;
+    }
+#else
+    UdpRecvBatch::UdpRecvBatch(std::size_t capacity, std::size_t maxDatagramSize)
+        : _capacity(capacity)
+        , _slotSize(maxDatagramSize)
+    {}
+
+    std::size_t UdpRecvBatch::Receive(asio::ip::udp::socket&, boost::system::error_code& ec)
+    {
+        ec = asio::error::operation_not_supported;
+        return 0;
+    }
+
+    auto UdpRecvBatch::At(std::size_t) const noexcept -> Datagram
+    {
+        return {};
+    }
+#endif
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <boost/asio/ip/udp.hpp>
+#include <boost/system/error_code.hpp>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#endif
+
+namespace Rtt::Udp
+{
+    /// Ring of preallocated datagram buffers filled by one recvmmsg() call.
+    ///
+    /// Linux-only batching helper for UdpServer: after the socket reports
+    /// readability, Receive() drains up to Capacity() datagrams in a single
+    /// syscall without blocking. On other platforms IsSupported() is false and
+    /// Receive() always fails with operation_not_supported.
+    class UdpRecvBatch
+    {
+    public:
+        struct Datagram
+        {
+            boost::asio::ip::udp::endpoint sender;
+            std::span<const std::byte> data;
+        };
+
+        /// @param capacity        Maximum datagrams per Receive() call.
+        /// @param maxDatagramSize Size of every slot in the ring.
+        UdpRecvBatch(std::size_t capacity, std::size_t maxDatagramSize);
+
+        UdpRecvBatch(const UdpRecvBatch&) = delete;
+        UdpRecvBatch& operator=(const UdpRecvBatch&) = delete;
+
+        [[nodiscard]] static constexpr bool IsSupported() noexcept
+        {
+#if defined(__linux__)
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        [[nodiscard]] std::size_t Capacity() const noexcept { return _capacity; }
+
+        /// Non-blocking drain of pending datagrams into the ring.
+        ///
+        /// Returns the number of datagrams received (0 with `ec` == would_block
+        /// when the socket has nothing queued). Results stay valid until the next call.
+        std::size_t Receive(boost::asio::ip::udp::socket& socket, boost::system::error_code& ec);
+
+        /// Access the i-th datagram of the last Receive() result.
+        [[nodiscard]] Datagram At(std::size_t index) const noexcept;
+
+    private:
+        std::size_t _capacity;
+        std::size_t _slotSize;
+        std::vector<std::byte> _storage;
+
+#if defined(__linux__)
+        std::vector<::mmsghdr> _headers;
+        std::vector<::iovec> _iovecs;
+        std::vector<::sockaddr_storage> _addrs;
+#endif
+    };
+}
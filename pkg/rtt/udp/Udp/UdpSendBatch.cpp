@@ -0,0 +1,203 @@
+#include "UdpSendBatch.h"
+
+#include "Log/Log.h"
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/post.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+#if defined(__linux__)
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103 // linux/udp.h, kernel 4.18+
+#endif
+#endif
+
+namespace Rtt::Udp
+{
+    namespace asio = boost::asio;
+    using udp = asio::ip::udp;
+
+    UdpSendBatch::UdpSendBatch(std::shared_ptr<udp::socket> socket, std::size_t capacity, std::size_t maxQueued)
+        : _socket(std::move(socket))
+        , _capacity(capacity)
+        , _maxQueued(std::max(maxQueued > 0 ? maxQueued : capacity * DefaultQueuedBatches, capacity))
+#if defined(__linux__)
+        , _headers(capacity)
+        , _iovecs(capacity)
+        , _cmsgs(capacity)
+        , _entriesPerHeader(capacity)
+#endif
+    {
+        _queue.reserve(capacity);
+#if defined(__linux__)
+        // Probe for GSO support: the option only exists on kernels that can segment.
+        int segment = 0;
+        ::socklen_t len = sizeof(segment);
+        _gso = ::getsockopt(_socket->native_handle(), IPPROTO_UDP, UDP_SEGMENT, &segment, &len) == 0;
+        Log::Trace("batched send: {} datagram(s) per flush, gso={}", capacity, _gso);
+#endif
+    }
+
+    bool UdpSendBatch::Enqueue(UdpSendPool::Buffer buf, std::size_t size, const udp::endpoint& to)
+    {
+        if constexpr (!IsSupported()) {
+            // Never constructed by UdpServer on such platforms; keep per-datagram semantics anyway.
+            auto payload = asio::buffer(buf.Data(), size);
+            _socket->async_send_to(payload, to, [data = std::move(buf)](boost::system::error_code, std::size_t) {});
+            return true;
+        }
+
+        if (_waitingWritable && _queue.size() >= _maxQueued) {
+            // The peers outrun the socket: drop rather than grow without bound
+            ++_dropped;
+            return false;
+        }
+        _queue.push_back({std::move(buf), size, to});
+        if (_waitingWritable) {
+            return true; // flushed once the socket becomes writable again
+        }
+        if (_queue.size() >= _capacity) {
+            Flush();
+            return true;
+        }
+        if (!_flushPosted) {
+            _flushPosted = true;
+            asio::post(_socket->get_executor(), [self = shared_from_this()] {
+                if (self->_flushPosted) {
+                    self->Flush();
+                }
+            });
+        }
+        return true;
+    }
+
+#if defined(__linux__)
+    namespace
+    {
+        constexpr std::size_t MaxGsoSegments = 64;   // UDP_MAX_SEGMENTS
+        constexpr std::size_t MaxGsoBytes = 65507;   // one UDP length field for the whole super-datagram
+    }
+
+    std::size_t UdpSendBatch::BuildHeaders(std::size_t first)
+    {
+        const auto end = std::min(_queue.size(), first + _capacity);
+        std::size_t header = 0;
+        std::size_t iov = 0;
+        for (auto entry = first; entry < end; ++header) {
+            auto& lead = _queue[entry];
+            const auto segmentSize = lead.size;
+
+            auto& msg = _headers[header].msg_hdr;
+            msg = {};
+            msg.msg_name = lead.to.data();
+            msg.msg_namelen = static_cast<::socklen_t>(lead.to.size());
+            msg.msg_iov = &_iovecs[iov];
+
+            // GSO run: same peer, equal-size segments, only the last one may be shorter.
+            std::size_t count = 0;
+            std::size_t bytes = 0;
+            do {
+                auto& p = _queue[entry + count];
+                _iovecs[iov + count] = {.iov_base = p.buf.Data(), .iov_len = p.size};
+                bytes += p.size;
+                ++count;
+            } while (_gso
+                     && entry + count < end
+                     && count < MaxGsoSegments
+                     && _queue[entry + count - 1].size == segmentSize
+                     && _queue[entry + count].to == lead.to
+                     && _queue[entry + count].size <= segmentSize
+                     && bytes + _queue[entry + count].size <= MaxGsoBytes);
+
+            msg.msg_iovlen = count;
+            if (count > 1) {
+                msg.msg_control = _cmsgs[header].data;
+                msg.msg_controllen = sizeof(_cmsgs[header].data);
+                auto* cm = CMSG_FIRSTHDR(&msg);
+                cm->cmsg_level = IPPROTO_UDP;
+                cm->cmsg_type = UDP_SEGMENT;
+                cm->cmsg_len = CMSG_LEN(sizeof(std::uint16_t));
+                const auto gsoSize = static_cast<std::uint16_t>(segmentSize);
+                std::memcpy(CMSG_DATA(cm), &gsoSize, sizeof(gsoSize));
+            }
+
+            _entriesPerHeader[header] = count;
+            iov += count;
+            entry += count;
+        }
+        return header;
+    }
+
+    void UdpSendBatch::Flush()
+    {
+        _flushPosted = false;
+        if (_waitingWritable || !_socket->is_open()) {
+            return;
+        }
+
+        std::size_t done = 0;
+        while (done < _queue.size()) {
+            const auto headers = BuildHeaders(done);
+            const int sent = ::sendmmsg(_socket->native_handle(), _headers.data(),
+                                        static_cast<unsigned int>(headers), MSG_DONTWAIT);
+            if (sent < 0) {
+                const auto err = errno;
+                if (err == EINTR) {
+                    continue; // interrupted before anything was sent
+                }
+                if (err == EAGAIN || err == EWOULDBLOCK) {
+                    _queue.erase(_queue.begin(), _queue.begin() + static_cast<std::ptrdiff_t>(done));
+                    WaitWritable();
+                    return;
+                }
+                if (err == EIO && _gso) {
+                    // Device cannot segment (e.g. no checksum offload): resend without GSO
+                    Log::Debug("gso send failed, disabling segmentation");
+                    _gso = false;
+                    continue;
+                }
+                // sendmmsg fails only for the first message: drop it and go on (fire-and-forget)
+                Log::Trace("sendmmsg failed — {}", std::system_category().message(err));
+                done += _entriesPerHeader[0];
+                continue;
+            }
+            for (int i = 0; i < sent; ++i) {
+                done += _entriesPerHeader[static_cast<std::size_t>(i)];
+            }
+        }
+        _queue.clear();
+    }
+
+    void UdpSendBatch::WaitWritable()
+    {
+        _waitingWritable = true;
+        _socket->async_wait(udp::socket::wait_write, [self = shared_from_this()](boost::system::error_code ec) {
+            self->_waitingWritable = false;
+            if (ec) {
+                self->_queue.clear();
+                return;
+            }
+            self->Flush();
+        });
+    }
+#else
+    std::size_t UdpSendBatch::BuildHeaders(std::size_t)
+    {
+        return 0;
+    }
+
+    void UdpSendBatch::Flush()
+    {
+        _flushPosted = false;
+    }
+
+    void UdpSendBatch::WaitWritable()
+    {}
+#endif
+}
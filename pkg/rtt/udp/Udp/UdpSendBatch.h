@@ -0,0 +1,99 @@
+#pragma once
+#include "UdpSendPool.h"
+
+#include <boost/asio/ip/udp.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#endif
+
+namespace Rtt::Udp
+{
+    /// Per-frame send queue for shared-socket links, flushed with sendmmsg().
+    ///
+    /// Linux-only batching helper for UdpServer. Enqueue() stores the datagram
+    /// and, for the first one of a batch, posts Flush() to the socket's executor —
+    /// with AsioPoller that flush runs inside the same AsioPoller::Update() poll
+    /// (or the next frame's poll for sends issued outside it), so one broadcast
+    /// tick turns into a single syscall. A full queue is flushed immediately.
+    ///
+    /// When the kernel supports UDP GSO (UDP_SEGMENT), consecutive datagrams to
+    /// the same peer are sent as one segmented message. If the socket buffer is
+    /// full the rest of the queue waits for writability instead of being dropped,
+    /// up to maxQueued datagrams: past that Enqueue() refuses and counts a drop.
+    ///
+    /// Not thread-safe: intended to be used from the socket's executor only.
+    class UdpSendBatch : public std::enable_shared_from_this<UdpSendBatch>
+    {
+    public:
+        /// @param socket   Shared unconnected socket of the server.
+        /// @param capacity  Maximum datagrams queued before a forced flush.
+        /// @param maxQueued Maximum datagrams held while waiting for writability.
+        ///                  0 = DefaultQueuedBatches batches of `capacity`.
+        UdpSendBatch(std::shared_ptr<boost::asio::ip::udp::socket> socket, std::size_t capacity, std::size_t maxQueued = 0);
+
+        static constexpr std::size_t DefaultQueuedBatches = 16;
+
+        UdpSendBatch(const UdpSendBatch&) = delete;
+        UdpSendBatch& operator=(const UdpSendBatch&) = delete;
+
+        [[nodiscard]] static constexpr bool IsSupported() noexcept
+        {
+#if defined(__linux__)
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /// Whether GSO segmentation was detected and is currently in use.
+        [[nodiscard]] bool GsoEnabled() const noexcept { return _gso; }
+
+        /// Queue `size` bytes of `buf` for `to`. The slab is recycled after the flush.
+        /// Returns false (and drops the datagram) if maxQueued datagrams are
+        /// already waiting for the socket to become writable.
+        bool Enqueue(UdpSendPool::Buffer buf, std::size_t size, const boost::asio::ip::udp::endpoint& to);
+
+        /// Datagrams refused by Enqueue() because the queue was full.
+        [[nodiscard]] std::uint64_t Dropped() const noexcept { return _dropped; }
+
+        /// Send everything queued so far (normally called from the posted flush).
+        void Flush();
+
+    private:
+        struct Pending
+        {
+            UdpSendPool::Buffer buf;
+            std::size_t size;
+            boost::asio::ip::udp::endpoint to;
+        };
+
+        std::size_t BuildHeaders(std::size_t first);
+        void WaitWritable();
+
+        std::shared_ptr<boost::asio::ip::udp::socket> _socket;
+        std::size_t _capacity;
+        std::size_t _maxQueued;
+        std::vector<Pending> _queue;
+        std::uint64_t _dropped = 0;
+        bool _flushPosted = false;
+        bool _waitingWritable = false;
+        bool _gso = false;
+
+#if defined(__linux__)
+        struct CmsgSpace
+        {
+            alignas(::cmsghdr) std::byte data[CMSG_SPACE(sizeof(std::uint16_t))];
+        };
+
+        std::vector<::mmsghdr> _headers;
+        std::vector<::iovec> _iovecs;
+        std::vector<CmsgSpace> _cmsgs;
+        std::vector<std::size_t> _entriesPerHeader; // queue entries covered by each header
+#endif
+    };
+}
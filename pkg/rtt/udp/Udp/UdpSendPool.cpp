@@ -0,0 +1,63 @@
+#include "UdpSendPool.h"
+
+#include <utility>
+
+namespace Rtt::Udp
+{
+    namespace
+    {
+        void Bump(std::atomic<std::uint64_t>& counter) noexcept
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    UdpSendPool::UdpSendPool(std::size_t slabSize, std::size_t maxIdle)
+        : _slabSize(slabSize)
+        , _maxIdle(maxIdle)
+    {
+        _idle.reserve(maxIdle);
+    }
+
+    auto UdpSendPool::Acquire() -> Buffer
+    {
+        std::unique_ptr<std::byte[]> slab;
+        if (!_idle.empty()) {
+            slab = std::move(_idle.back());
+            _idle.pop_back();
+            _idleCount.store(_idle.size(), std::memory_order_relaxed);
+            Bump(_hits);
+        } else {
+            // for_overwrite: no zeroing — the writer fills only what it sends
+            slab = std::make_unique_for_overwrite<std::byte[]>(_slabSize);
+            Bump(_misses);
+        }
+        return {shared_from_this(), std::move(slab), _slabSize};
+    }
+
+    auto UdpSendPool::GetStats() const noexcept -> Stats
+    {
+        return {
+            .hits = _hits.load(std::memory_order_relaxed),
+            .misses = _misses.load(std::memory_order_relaxed),
+            .idle = _idleCount.load(std::memory_order_relaxed),
+        };
+    }
+
+    void UdpSendPool::Recycle(std::unique_ptr<std::byte[]> slab) noexcept
+    {
+        if (_idle.size() < _maxIdle) {
+            _idle.push_back(std::move(slab)); // capacity reserved in constructor: no throw
+            _idleCount.store(_idle.size(), std::memory_order_relaxed);
+        }
+    }
+
+    void UdpSendPool::Buffer::Release() noexcept
+    {
+        if (_pool && _slab) {
+            _pool->Recycle(std::move(_slab));
+        }
+        _pool.reset();
+        _slab.reset();
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace Rtt::Udp
+{
+    /// Recycling pool of fixed-size send buffers (slabs) owned by one transport.
+    ///
+    /// Every slab is `slabSize` bytes (the transport's maxDatagramSize). Acquire()
+    /// hands out an idle slab if one is available (hit) or allocates a new one
+    /// (miss). The returned Buffer gives the slab back on destruction, so an async
+    /// send completion that drops its Buffer recycles the slab automatically.
+    /// At most `maxIdle` slabs are retained; extra ones are freed on release.
+    ///
+    /// Not thread-safe: intended to be used from the transport's executor only.
+    /// GetStats() alone may be called from any thread (counters are relaxed atomics).
+    class UdpSendPool : public std::enable_shared_from_this<UdpSendPool>
+    {
+    public:
+        struct Stats
+        {
+            /// Acquire() calls served from the idle list.
+            std::uint64_t hits = 0;
+
+            /// Acquire() calls that had to allocate a new slab.
+            std::uint64_t misses = 0;
+
+            /// Slabs currently held in the idle list.
+            std::size_t idle = 0;
+        };
+
+        /// Move-only handle to one slab. Returns the slab to the pool on destruction.
+        class Buffer
+        {
+        public:
+            Buffer() = default;
+            ~Buffer() { Release(); }
+
+            Buffer(Buffer&&) noexcept = default;
+            Buffer& operator=(Buffer&& other) noexcept
+            {
+                if (this != &other) {
+                    Release();
+                    _pool = std::move(other._pool);
+                    _slab = std::move(other._slab);
+                    _size = other._size;
+                }
+                return *this;
+            }
+            Buffer(const Buffer&) = delete;
+            Buffer& operator=(const Buffer&) = delete;
+
+            [[nodiscard]] std::byte* Data() const noexcept { return _slab.get(); }
+            [[nodiscard]] std::size_t Size() const noexcept { return _size; }
+            [[nodiscard]] std::span<std::byte> Span() const noexcept { return {_slab.get(), _size}; }
+
+        private:
+            friend class UdpSendPool;
+
+            Buffer(std::shared_ptr<UdpSendPool> pool, std::unique_ptr<std::byte[]> slab, std::size_t size) noexcept
+                : _pool(std::move(pool))
+                , _slab(std::move(slab))
+                , _size(size)
+            {}
+
+            void Release() noexcept;
+
+            std::shared_ptr<UdpSendPool> _pool;
+            std::unique_ptr<std::byte[]> _slab;
+            std::size_t _size = 0;
+        };
+
+        /// @param slabSize Size of every slab in bytes (maxDatagramSize).
+        /// @param maxIdle  Maximum number of idle slabs kept for reuse.
+        UdpSendPool(std::size_t slabSize, std::size_t maxIdle);
+
+        /// Take a slab from the idle list or allocate a new one.
+        /// The pool must be owned by a shared_ptr.
+        [[nodiscard]] Buffer Acquire();
+
+        [[nodiscard]] std::size_t SlabSize() const noexcept { return _slabSize; }
+        [[nodiscard]] Stats GetStats() const noexcept;
+
+    private:
+        void Recycle(std::unique_ptr<std::byte[]> slab) noexcept;
+
+        std::size_t _slabSize;
+        std::size_t _maxIdle;
+        std::vector<std::unique_ptr<std::byte[]>> _idle;
+        // Single writer (the executor thread): incremented with load+store, no RMW
+        std::atomic<std::uint64_t> _hits{0};
+        std::atomic<std::uint64_t> _misses{0};
+        std::atomic<std::size_t> _idleCount{0};
+    };
+}
@@ -1,11 +1,25 @@
 #include "UdpCommon.h"
+#include "UdpDispatchTable.h"
+#include "UdpHandshake.h"
+#include "UdpIdleWheel.h"
 #include "UdpLink.h"
+#include "UdpRecvBatch.h"
+#include "UdpSendBatch.h"
 #include "UdpServer.h"
 
 #include "Log/Log.h"
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/udp.hpp>
-#include <map>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <span>
+#include <thread>
 #include <utility>
 
 namespace Rtt::Udp
@@ -19,21 +33,71 @@ namespace Rtt::Udp
 
     struct UdpServer::ListenState
     {
+        /// Dispatch table entry: the link plus its idle-sweep bookkeeping.
+        struct Peer
+        {
+            std::shared_ptr<UdpLink> link;
+            std::uint64_t activeTick = 0; // idleWheel->Now() at the last datagram
+            std::uint32_t idleSlot = 0;   // wheel slot holding this peer's live entry
+        };
+
+        /// Idle-sweep resolution: ticks per idle timeout.
+        static constexpr std::size_t IdleWheelSpan = 16;
+
         std::shared_ptr<udp::socket> socket;
+        std::optional<asio::io_context::executor_type> shardExecutor; // sharded: the shard's io_context
         std::shared_ptr<ILinkAcceptor> acceptor;
         std::size_t maxDatagramSize{};
+        std::shared_ptr<UdpSendPool> sendPool;
+        std::shared_ptr<UdpSendBatch> sendBatch; // set when batched send is enabled
+        UdpFragmentOptions fragment;
+        std::shared_ptr<TransportStats> linkStats;
+        std::size_t maxOutstandingBytes = 0;
         udp::endpoint senderEndpoint;
         std::vector<std::byte> recvBuf;
-        std::map<udp::endpoint, std::shared_ptr<UdpLink>> links;
+        std::shared_ptr<PacketPool> recvPool; // set when pooled receive is enabled
+        std::unique_ptr<UdpRecvBatch> recvBatch; // set when batched receive is enabled
+        std::size_t recvBatchesPerWakeup = 1;
+        UdpDispatchTable<Peer> links;
         PeerId localId;
         bool stopped = false;
 
+        // Idle sweep and link cap
+        std::optional<UdpIdleWheel> idleWheel; // set when idleTimeout > 0
+        std::unique_ptr<asio::steady_timer> sweepTimer;
+        std::chrono::steady_clock::duration sweepPeriod{};
+        std::size_t maxLinks = 0;
+        LinkEviction eviction = LinkEviction::EvictIdlest;
+
+        std::shared_ptr<const UdpCookies> cookies; // set in handshake mode
+
+        void Stop()
+        {
+            stopped = true;
+            if (sweepTimer) {
+                sweepTimer->cancel();
+            }
+            if (socket && socket->is_open()) {
+                boost::system::error_code ec;
+                auto _ = socket->close(ec);
+            }
+        }
+
         void StartReceive()
         {
             if (stopped) {
                 return;
             }
 
+            if (recvBatch) {
+                StartReceiveBatch();
+                return;
+            }
+            if (recvPool) {
+                StartReceivePooled();
+                return;
+            }
+
             socket->async_receive_from(
                 asio::buffer(recvBuf.data(), recvBuf.size()),
                 senderEndpoint,
@@ -41,40 +105,293 @@ namespace Rtt::Udp
                     if (ec || stopped) {
                         return;
                     }
-                    OnReceived(bytesReceived);
+                    OnReceived(senderEndpoint, std::span<const std::byte>{recvBuf.data(), bytesReceived});
                     StartReceive();
                 });
         }
 
-        void OnReceived(std::size_t bytesReceived)
+        /// Pooled mode: every datagram gets its own slab, lent to the link's onPacket.
+        void StartReceivePooled()
         {
-            auto data = std::span<const std::byte>{recvBuf.data(), bytesReceived};
-            auto it = links.find(senderEndpoint);
+            auto buf = recvPool->Acquire();
+            const auto space = buf.Span();
+            socket->async_receive_from(
+                asio::buffer(space.data(), space.size()),
+                senderEndpoint,
+                [this, self = socket, buf = std::move(buf)](boost::system::error_code ec, std::size_t bytesReceived) mutable {
+                    if (ec || stopped) {
+                        return;
+                    }
+                    const auto packet = std::move(buf).Publish(bytesReceived);
+                    OnReceived(senderEndpoint, packet.Span(), &packet);
+                    StartReceive();
+                });
+        }
 
-            if (it != links.end()) {
-                it->second->DeliverReceived(data);
+        /// Batched mode: wait for readability, then drain the socket with up to
+        /// recvBatchesPerWakeup recvmmsg calls, dispatching every datagram. A socket
+        /// still full after that waits for the next wakeup, so sustained load
+        /// cannot keep the executor from its other handlers.
+        void StartReceiveBatch()
+        {
+            socket->async_wait(
+                udp::socket::wait_read,
+                [this, self = socket](boost::system::error_code ec) {
+                    if (ec || stopped) {
+                        return;
+                    }
+                    for (std::size_t batch = 0; batch < recvBatchesPerWakeup && !stopped; ++batch) {
+                        const auto count = recvBatch->Receive(*socket, ec);
+                        if (ec) {
+                            if (ec != asio::error::would_block) {
+                                Log::Trace("batch receive failed on {} — {}", localId.value, ec.message());
+                                return;
+                            }
+                            break;
+                        }
+                        for (std::size_t i = 0; i < count && !stopped; ++i) {
+                            const auto dg = recvBatch->At(i);
+                            OnReceived(dg.sender, dg.data);
+                        }
+                        if (count < recvBatch->Capacity()) {
+                            break; // drained: the next datagram needs a new wakeup
+                        }
+                    }
+                    StartReceive();
+                });
+        }
+
+        void OnReceived(const udp::endpoint& sender, std::span<const std::byte> data, const Packet* packet = nullptr)
+        {
+            const auto key = PackEndpoint(sender);
+            if (!key) {
+                return; // IPv4 socket: other address families cannot appear
+            }
+
+            if (auto* peer = links.Find(*key)) {
+                if (cookies && Handshake::Classify(data) == Handshake::Message::Response) {
+                    SendHandshake(sender, Handshake::Message::Accept); // our Accept was lost
+                    return;
+                }
+                if (idleWheel) {
+                    peer->activeTick = idleWheel->Now();
+                }
+                peer->link->DeliverReceived(data, packet);
+                return;
+            }
+
+            if (cookies && !VerifyHandshake(sender, *key, data)) {
+                return;
+            }
+
+            if (maxLinks > 0 && links.Size() >= maxLinks && !EvictIdlest()) {
+                Log::Trace("link limit {} reached on {}, dropping datagram from new peer", maxLinks, localId.value);
                 return;
             }
 
-            auto remoteId = EndpointToPeerId(senderEndpoint);
-            auto remoteEp = senderEndpoint;
+            auto remoteId = EndpointToPeerId(sender);
+            auto remoteEp = sender;
 
             Log::Trace("new peer {} on {}", remoteId.value, localId.value);
 
             auto link = std::make_shared<UdpLink>(
                 socket, remoteEp, localId, remoteId,
                 maxDatagramSize,
-                [this, remoteEp]() { links.erase(remoteEp); });
+                sendPool,
+                sendBatch,
+                [this, key = *key]() { links.Erase(key); },
+                fragment,
+                linkStats->Track());
+            link->SetMaxOutstandingBytes(maxOutstandingBytes);
+            if (shardExecutor) {
+                link->SetShardExecutor(*shardExecutor);
+            }
 
-            links[remoteEp] = link;
+            auto& peer = links.Insert(*key, Peer{.link = link});
+            if (idleWheel) {
+                peer.activeTick = idleWheel->Now();
+                peer.idleSlot = idleWheel->Schedule(*key, idleWheel->Span());
+            }
 
             auto handler = acceptor->OnLink(link);
             link->SetHandler(std::move(handler));
 
-            link->DeliverReceived(data);
+            if (cookies) {
+                SendHandshake(sender, Handshake::Message::Accept);
+                return; // the Response carries no data
+            }
+            link->DeliverReceived(data, packet);
+        }
+
+        // -------------------------------------------------------------------
+        // Handshake
+        // -------------------------------------------------------------------
+
+        /// Handshake mode, datagram from an unknown sender: answer a Hello with a
+        /// Challenge and return true only for a Response with a valid cookie.
+        /// Nothing is allocated or logged per datagram: this runs at flood rate.
+        bool VerifyHandshake(const udp::endpoint& sender, EndpointKey key, std::span<const std::byte> data)
+        {
+            const auto message = Handshake::Classify(data);
+            if (message == Handshake::Message::Hello) {
+                SendHandshake(sender, Handshake::Message::Challenge,
+                              cookies->Make(key, UdpCookies::Clock::now()));
+                return false;
+            }
+            return message == Handshake::Message::Response &&
+                   cookies->Verify(key, Handshake::ReadCookie(data), UdpCookies::Clock::now());
+        }
+
+        /// Best-effort synchronous reply (the socket is non-blocking); a lost
+        /// reply is recovered by the client's retry.
+        void SendHandshake(const udp::endpoint& to, Handshake::Message message, const Handshake::Cookie& cookie = {})
+        {
+            std::array<std::byte, Handshake::MaxMessageSize> buf;
+            const auto size = Handshake::Write(buf, message, cookie);
+            boost::system::error_code ec;
+            auto _ = socket->send_to(asio::buffer(buf.data(), size), to, 0, ec);
+        }
+
+        // -------------------------------------------------------------------
+        // Idle sweep
+        // -------------------------------------------------------------------
+
+        void StartSweep()
+        {
+            sweepTimer->expires_after(sweepPeriod);
+            sweepTimer->async_wait([this, self = socket](boost::system::error_code ec) {
+                if (ec || stopped) {
+                    return;
+                }
+                Sweep();
+                StartSweep();
+            });
+        }
+
+        /// Advance the wheel one tick: disconnect peers idle for a full span,
+        /// re-schedule the others by their last activity.
+        void Sweep()
+        {
+            idleWheel->Advance([this](EndpointKey key, std::uint32_t slot) {
+                auto* peer = links.Find(key);
+                if (!peer || peer->idleSlot != slot) {
+                    return; // gone, or a stale entry of a re-created peer
+                }
+                const auto idle = idleWheel->Now() - peer->activeTick;
+                if (idle < idleWheel->Span()) {
+                    peer->idleSlot = idleWheel->Schedule(key, idleWheel->Span() - idle);
+                    return;
+                }
+                Log::Trace("idle timeout for {} on {}", peer->link->RemoteId().value, localId.value);
+                Evict(key);
+            });
+        }
+
+        /// Make room for a new peer under LinkEviction::EvictIdlest.
+        /// Returns false if nothing was evicted.
+        bool EvictIdlest()
+        {
+            if (eviction != LinkEviction::EvictIdlest || !idleWheel) {
+                return false;
+            }
+            // The slot due next holds the peers closest to their idle timeout;
+            // within it, pick the one with the oldest activity stamp
+            std::optional<EndpointKey> victim;
+            std::uint64_t oldest = 0;
+            idleWheel->VisitInDueOrder([&](std::span<const EndpointKey> keys, std::uint32_t slot) {
+                for (const auto key : keys) {
+                    const auto* peer = links.Find(key);
+                    if (peer && peer->idleSlot == slot && (!victim || peer->activeTick < oldest)) {
+                        victim = key;
+                        oldest = peer->activeTick;
+                    }
+                }
+                return victim.has_value();
+            });
+            if (!victim) {
+                return false;
+            }
+            Log::Trace("link limit {} reached on {}, evicting idlest peer", maxLinks, localId.value);
+            Evict(*victim);
+            return true;
+        }
+
+        /// Sharded server shutting down, on the shard's thread: disconnect every
+        /// link and detach it from the shard, so links the user still holds
+        /// handle later calls inline instead of dispatching into a stopped io_context.
+        void CloseLinks()
+        {
+            std::vector<std::shared_ptr<UdpLink>> closing;
+            closing.reserve(links.Size());
+            links.ForEach([&](EndpointKey, Peer& peer) { closing.push_back(peer.link); });
+            for (const auto& link : closing) {
+                link->Disconnect(); // erases it from the table
+                link->DetachShard();
+            }
+        }
+
+        /// Disconnect a peer: removes it from the table and fires onDisconnected.
+        void Evict(EndpointKey key)
+        {
+            auto link = links.Find(key)->link; // keep alive through Disconnect()
+            link->Disconnect();
         }
     };
 
+    // -----------------------------------------------------------------------
+    // ShardThread — io_context + thread driving one SO_REUSEPORT socket
+    // -----------------------------------------------------------------------
+
+    struct UdpServer::ShardThread
+    {
+        // Shared with the shard's socket deleter: a link that outlives the server
+        // still needs the io_context to destroy its socket.
+        std::shared_ptr<asio::io_context> io = std::make_shared<asio::io_context>(1);
+        asio::executor_work_guard<asio::io_context::executor_type> workGuard = asio::make_work_guard(*io);
+        std::thread thread;
+    };
+
+    namespace
+    {
+#if defined(__linux__)
+        using ReusePort = asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+        constexpr bool ReusePortSupported = true;
+#else
+        constexpr bool ReusePortSupported = false;
+#endif
+
+        /// Open and bind an IPv4 UDP socket; `reusePort` sets SO_REUSEPORT before bind.
+        boost::system::error_code OpenSocket(udp::socket& socket, std::uint16_t port, [[maybe_unused]] bool reusePort)
+        {
+            boost::system::error_code ec;
+            auto _ = socket.open(udp::v4(), ec);
+            if (ec) {
+                Log::Trace("socket open failed — {}", ec.message());
+                return ec;
+            }
+
+            _ = socket.set_option(asio::socket_base::reuse_address(true), ec);
+#if defined(__linux__)
+            if (reusePort) {
+                _ = socket.set_option(ReusePort(true), ec);
+                if (ec) {
+                    Log::Trace("SO_REUSEPORT failed — {}", ec.message());
+                    return ec;
+                }
+            }
+#endif
+            _ = socket.bind(udp::endpoint(udp::v4(), port), ec);
+            if (ec) {
+                Log::Trace("bind failed on port {} — {}", port, ec.message());
+                return ec;
+            }
+            // Synchronous sends (UdpLink::SendV) must fail with would_block instead
+            // of stalling the executor; async operations are not affected
+            _ = socket.non_blocking(true, ec);
+            return ec;
+        }
+    }
+
     // -----------------------------------------------------------------------
     // UdpServer
     // -----------------------------------------------------------------------
@@ -85,51 +402,163 @@ namespace Rtt::Udp
 
     UdpServer::~UdpServer()
     {
-        if (_listenState) {
-            Log::Trace("closing on port {}", _localPort);
-            _listenState->stopped = true;
-            if (_listenState->socket && _listenState->socket->is_open()) {
-                boost::system::error_code ec;
-                auto _ = _listenState->socket->close(ec);
+        if (_listenStates.empty()) {
+            return;
+        }
+        Log::Trace("closing on port {}", _localPort);
+
+        if (_shardThreads.empty()) {
+            _listenStates.front()->Stop();
+            return;
+        }
+
+        // Close each socket and its links on their own thread, then let
+        // io_context::run() finish the aborted operations and return before the
+        // states are released.
+        for (const auto& state : _listenStates) {
+            asio::post(state->socket->get_executor(), [state] {
+                state->Stop();
+                state->CloseLinks();
+            });
+        }
+        for (auto& shard : _shardThreads) {
+            shard->workGuard.reset();
+        }
+        for (auto& shard : _shardThreads) {
+            if (shard->thread.joinable()) {
+                shard->thread.join();
             }
         }
+
+        // Calls dispatched by other threads while the shard was shutting down
+        // may have missed run(): run them here (on a closed link they do nothing),
+        // or their captured links would keep the io_context, and so themselves, alive.
+        for (auto& shard : _shardThreads) {
+            shard->io->restart();
+            shard->io->poll();
+        }
     }
 
-    void UdpServer::Open(std::shared_ptr<ILinkAcceptor> acceptor)
+    auto UdpServer::GetSendPoolStats() const noexcept -> UdpSendPool::Stats
     {
-        auto executor = _options.executor;
-        auto port = _options.localPort;
-        auto maxDgSize = _options.maxDatagramSize;
+        UdpSendPool::Stats total;
+        for (const auto& state : _listenStates) {
+            const auto stats = state->sendPool->GetStats();
+            total.hits += stats.hits;
+            total.misses += stats.misses;
+            total.idle += stats.idle;
+        }
+        return total;
+    }
 
-        boost::system::error_code ec;
-        auto socket = std::make_shared<udp::socket>(executor);
+    auto UdpServer::GetReceivePoolStats() const noexcept -> PacketPool::Stats
+    {
+        PacketPool::Stats total;
+        for (const auto& state : _listenStates) {
+            if (!state->recvPool) {
+                continue;
+            }
+            const auto stats = state->recvPool->GetStats();
+            total.hits += stats.hits;
+            total.misses += stats.misses;
+            total.idle += stats.idle;
+        }
+        return total;
+    }
 
-        auto _ = socket->open(udp::v4(), ec);
-        if (ec) {
-            Log::Trace("socket open failed — {}", ec.message());
-            acceptor->OnLink(std::unexpected(MapAsioError(ec)));
-            return;
+    void UdpServer::Open(std::shared_ptr<ILinkAcceptor> acceptor)
+    {
+        auto shardCount = std::max<std::size_t>(_options.shards, 1);
+        if (shardCount > 1 && !ReusePortSupported) {
+            Log::Debug("SO_REUSEPORT sharding not supported on this platform, using one socket");
+            shardCount = 1;
         }
+        const bool sharded = shardCount > 1;
 
-        _ = socket->set_option(asio::socket_base::reuse_address(true), ec);
-        _ = socket->bind(udp::endpoint(udp::v4(), port), ec);
-        if (ec) {
-            Log::Trace("bind failed on port {} — {}", port, ec.message());
-            acceptor->OnLink(std::unexpected(MapAsioError(ec)));
-            return;
+        std::vector<std::unique_ptr<ShardThread>> shardThreads;
+        std::vector<std::shared_ptr<udp::socket>> sockets;
+        auto port = _options.localPort;
+        for (std::size_t i = 0; i < shardCount; ++i) {
+            std::shared_ptr<udp::socket> socket;
+            if (sharded) {
+                auto& shard = shardThreads.emplace_back(std::make_unique<ShardThread>());
+                socket = std::shared_ptr<udp::socket>(
+                    new udp::socket(shard->io->get_executor()), // NOLINT(*-owning-memory)
+                    [io = shard->io](udp::socket* s) { delete s; }); // NOLINT(*-owning-memory)
+            } else {
+                socket = std::make_shared<udp::socket>(_options.executor);
+            }
+
+            if (auto ec = OpenSocket(*socket, port, sharded)) {
+                acceptor->OnLink(std::unexpected(MapAsioError(ec)));
+                return;
+            }
+            // The first socket may get an OS-assigned port; the others join it
+            port = socket->local_endpoint().port();
+            sockets.push_back(std::move(socket));
         }
 
-        _localPort = socket->local_endpoint().port();
+        _localPort = port;
 
-        Log::Trace("listening on port {}", _localPort);
+        Log::Trace("listening on port {} ({} socket(s))", _localPort, shardCount);
 
-        _listenState = std::make_shared<ListenState>();
-        _listenState->socket = std::move(socket);
-        _listenState->acceptor = std::move(acceptor);
-        _listenState->maxDatagramSize = maxDgSize;
-        _listenState->recvBuf.resize(maxDgSize);
-        _listenState->localId = EndpointToPeerId(_listenState->socket->local_endpoint());
+        const auto maxDgSize = _options.maxDatagramSize;
+        const auto cookies = _options.handshake ? std::make_shared<const UdpCookies>(_options.cookieLifetime) : nullptr;
+        for (std::size_t i = 0; i < sockets.size(); ++i) {
+            auto state = std::make_shared<ListenState>();
+            state->socket = std::move(sockets[i]);
+            if (sharded) {
+                state->shardExecutor = shardThreads[i]->io->get_executor();
+            }
+            state->acceptor = acceptor;
+            state->maxDatagramSize = maxDgSize;
+            state->fragment = FragmentOptions();
+            state->linkStats = _linkStats;
+            state->maxOutstandingBytes = _options.maxOutstandingBytes;
+            state->maxLinks = _options.maxLinks;
+            state->eviction = _options.eviction;
+            state->cookies = cookies;
+            if (_options.idleTimeout.count() > 0) {
+                state->idleWheel.emplace(ListenState::IdleWheelSpan);
+                state->sweepTimer = std::make_unique<asio::steady_timer>(state->socket->get_executor());
+                state->sweepPeriod = std::max<std::chrono::steady_clock::duration>(
+                    _options.idleTimeout / ListenState::IdleWheelSpan, std::chrono::milliseconds(1));
+            }
+            state->sendPool = std::make_shared<UdpSendPool>(maxDgSize, _options.sendPoolCapacity);
+            if (_options.pooledReceive) {
+                state->recvPool = std::make_shared<PacketPool>(maxDgSize, _options.receivePoolCapacity);
+            } else {
+                state->recvBuf.resize(maxDgSize);
+            }
+            state->localId = EndpointToPeerId(state->socket->local_endpoint());
+            if (_options.receiveBatchSize > 1) {
+                if constexpr (UdpRecvBatch::IsSupported()) {
+                    state->recvBatch = std::make_unique<UdpRecvBatch>(_options.receiveBatchSize, maxDgSize);
+                    state->recvBatchesPerWakeup = std::max<std::size_t>(_options.receiveBatchesPerWakeup, 1);
+                    Log::Trace("batched receive: {} datagram(s) per wakeup", _options.receiveBatchSize);
+                } else {
+                    Log::Debug("batched receive not supported on this platform, using per-datagram receive");
+                }
+            }
+            if (_options.sendBatchSize > 1) {
+                if constexpr (UdpSendBatch::IsSupported()) {
+                    state->sendBatch = std::make_shared<UdpSendBatch>(state->socket, _options.sendBatchSize);
+                } else {
+                    Log::Debug("batched send not supported on this platform, using per-datagram send");
+                }
+            }
 
-        _listenState->StartReceive();
+            // Shard threads are not running yet, so arming the receive here is race-free
+            state->StartReceive();
+            if (state->sweepTimer) {
+                state->StartSweep();
+            }
+            _listenStates.push_back(std::move(state));
+        }
+
+        _shardThreads = std::move(shardThreads);
+        for (auto& shard : _shardThreads) {
+            shard->thread = std::thread([io = shard->io] { io->run(); });
+        }
     }
 }
@@ -1,25 +1,45 @@
 #pragma once
+#include "Rtt/Packet.h"
 #include "Rtt/Transport.h"
+#include "Rtt/TransportStats.h"
+#include "UdpFragment.h"
+#include "UdpSendPool.h"
 
 #include <boost/asio/any_io_executor.hpp>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace Rtt::Udp
 {
+    /// What UdpServer does with a datagram from a new peer once maxLinks is reached.
+    enum class LinkEviction : std::uint8_t
+    {
+        /// Drop the datagram; existing links are kept.
+        RejectNew,
+
+        /// Disconnect the link idle the longest (approximately: the one the idle
+        /// sweep would check next) and accept the new peer. Needs idleTimeout,
+        /// otherwise behaves like RejectNew.
+        EvictIdlest,
+    };
+
     /// Server-side UDP transport.
     ///
     /// Binds a local port and creates a new virtual link for each unique
     /// remote endpoint that sends a datagram. Open() may fire the
     /// acceptor's OnLink() multiple times — once per incoming peer.
     ///
-    /// Requires an externally-managed executor (e.g., from AsioPoller).
+    /// Requires an externally-managed executor (e.g., from AsioPoller), unless
+    /// sharded: then each shard runs its own io_context on a dedicated thread.
     class UdpServer : public ITransport
     {
     public:
         struct Options
         {
+            /// Executor driving the listening socket (unused when sharded).
             boost::asio::any_io_executor executor;
 
             /// Local port to bind. 0 = OS-assigned.
@@ -27,6 +47,86 @@ namespace Rtt::Udp
 
             /// Maximum UDP datagram payload size.
             std::size_t maxDatagramSize = 1472;
+
+            /// Maximum number of idle send buffers kept for reuse by the send pool.
+            std::size_t sendPoolCapacity = 64;
+
+            /// Receive every datagram into its own refcounted slab, so handlers with
+            /// LinkHandler::onPacket keep packets past the callback without a copy.
+            /// Off = one reused receive buffer, onPacket gets copies (default).
+            /// Batched receive (receiveBatchSize) fills its own ring and copies.
+            bool pooledReceive = false;
+
+            /// Maximum number of idle receive slabs kept for reuse in pooled mode.
+            std::size_t receivePoolCapacity = 64;
+
+            /// Largest message Send() accepts. Messages over maxDatagramSize are sent
+            /// as fragments and reassembled by the peer, which must use the same
+            /// setting. 0 = no fragmentation, one message per datagram (default).
+            std::size_t maxMessageSize = 0;
+
+            /// Bytes of incomplete fragmented messages buffered per link.
+            std::size_t reassemblyBufferSize = 256 * 1024;
+
+            /// Incomplete fragmented messages are dropped after this long.
+            std::chrono::milliseconds reassemblyTimeout{1000};
+
+            /// Minimum time between in-band pings measuring each link's RTT, sent
+            /// ahead of outgoing messages. Frames every datagram, so the peer must
+            /// use the same setting. 0 = no pings (default).
+            std::chrono::milliseconds pingInterval{0};
+
+            /// Bytes a link may have in flight in asynchronous sends before it
+            /// stops being Writable() (see ILink backpressure). Send() drops while
+            /// over it; SendWhenWritable() defers. 0 = unlimited (default).
+            std::size_t maxOutstandingBytes = 0;
+
+            /// Datagrams received per recvmmsg call in batched receive (Linux only).
+            /// 0 or 1 = one async_receive_from per datagram (default). Ignored where
+            /// batching is unsupported.
+            std::size_t receiveBatchSize = 0;
+
+            /// recvmmsg calls per readability wakeup in batched receive. Datagrams
+            /// left over wait for the next wakeup, after the executor's other
+            /// handlers (the frame's poll, the shard's timers and sends) have run.
+            std::size_t receiveBatchesPerWakeup = 1;
+
+            /// Datagrams queued per sendmmsg flush for shared-socket links (Linux only).
+            /// 0 or 1 = one async_send_to per datagram (default). Queued sends are
+            /// flushed from a handler posted to the executor, so with AsioPoller they
+            /// leave within the frame's poll. Uses UDP GSO when the kernel supports it.
+            /// While the socket is full, up to 16 batches wait; later sends are
+            /// dropped and counted in the link's sendDrops.
+            std::size_t sendBatchSize = 0;
+
+            /// Number of SO_REUSEPORT sockets bound to the same port, each with its
+            /// own io_context on a dedicated thread (Linux only). The kernel pins every
+            /// peer to one shard by flow hash; OnLink() and the link's handler run on
+            /// that shard's thread, so the acceptor must be thread-safe. Links may be
+            /// used from any thread: calls from other threads are moved onto the shard.
+            /// 0 or 1 = one socket on `executor` (default).
+            std::size_t shards = 0;
+
+            /// Links that receive nothing for this long are disconnected and their
+            /// onDisconnected fires. Checked by a timer wheel on the socket's executor
+            /// with idleTimeout / 16 resolution. 0 = links live until Disconnect() (default).
+            std::chrono::milliseconds idleTimeout{0};
+
+            /// Maximum links per listening socket (per shard when sharded).
+            /// 0 = unlimited (default).
+            std::size_t maxLinks = 0;
+
+            /// Policy once maxLinks is reached.
+            LinkEviction eviction = LinkEviction::EvictIdlest;
+
+            /// Create links only after the sender completes the stateless cookie
+            /// handshake (see UdpHandshake.h): other datagrams from unknown senders
+            /// are dropped without allocating anything. Clients must enable
+            /// UdpClient::Options::handshake. Default off.
+            bool handshake = false;
+
+            /// How long a handshake cookie stays valid.
+            std::chrono::seconds cookieLifetime{10};
         };
 
         explicit UdpServer(Options options);
@@ -38,12 +138,39 @@ namespace Rtt::Udp
         /// Returns the local port actually bound (useful when localPort=0).
         [[nodiscard]] std::uint16_t LocalPort() const noexcept { return _localPort; }
 
+        /// Number of listening sockets opened (1 unless sharded, 0 before Open()).
+        [[nodiscard]] std::size_t ShardCount() const noexcept { return _listenStates.size(); }
+
+        /// Hit/miss counters of the send buffer pools (one per shard), summed.
+        [[nodiscard]] UdpSendPool::Stats GetSendPoolStats() const noexcept;
+
+        /// Hit/miss counters of the receive slab pools (pooled receive only), summed.
+        [[nodiscard]] PacketPool::Stats GetReceivePoolStats() const noexcept;
+
+        /// Traffic of all links, over all shards. Call LogEvery() from the frame
+        /// loop to dump it periodically.
+        [[nodiscard]] TransportStats& GetLinkStats() const noexcept { return *_linkStats; }
+
     private:
+        /// Fragmentation settings handed to every link.
+        [[nodiscard]] UdpFragmentOptions FragmentOptions() const noexcept
+        {
+            return {
+                .maxMessageSize = _options.maxMessageSize,
+                .reassemblyBufferSize = _options.reassemblyBufferSize,
+                .reassemblyTimeout = _options.reassemblyTimeout,
+                .pingInterval = _options.pingInterval,
+            };
+        }
+
         Options _options;
         std::uint16_t _localPort = 0;
+        std::shared_ptr<TransportStats> _linkStats = std::make_shared<TransportStats>();
 
         struct ListenState;
-        std::shared_ptr<ListenState> _listenState;
+        struct ShardThread;
+        std::vector<std::shared_ptr<ListenState>> _listenStates;
+        std::vector<std::unique_ptr<ShardThread>> _shardThreads;
     };
 
     static_assert(TransportLike<UdpServer>);
@@ -0,0 +1,88 @@
+#include "Udp/UdpDispatchTable.h"
+#include <benchmark/benchmark.h>
+#include <boost/asio/ip/udp.hpp>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+// ReSharper disable CppDFAUnreadVariable
+
+// Per-datagram sender lookup cost in Rtt::Udp::UdpServer:
+// std::map<udp::endpoint, ...> (previous dispatch) vs UdpDispatchTable keyed
+// on packed (address, port), for 10 / 1k / 50k peers. "Uniform" draws a random
+// sender per datagram; "Bursty" repeats each sender 8 times (last-sender cache).
+
+namespace
+{
+    namespace asio = boost::asio;
+    using udp = asio::ip::udp;
+
+    struct Peer {};
+
+    std::vector<udp::endpoint> MakeEndpoints(std::size_t count)
+    {
+        std::vector<udp::endpoint> eps;
+        eps.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto addr = asio::ip::address_v4{static_cast<asio::ip::address_v4::uint_type>(0x0a000000 + (i / 16))};
+            eps.emplace_back(addr, static_cast<unsigned short>(40000 + (i % 16)));
+        }
+        return eps;
+    }
+
+    std::vector<std::size_t> MakeSequence(std::size_t peers, std::size_t burst)
+    {
+        std::mt19937 rng{42};
+        std::uniform_int_distribution<std::size_t> pick{0, peers - 1};
+        std::vector<std::size_t> seq;
+        for (std::size_t i = 0; i < 4096; i += burst) {
+            const auto p = pick(rng);
+            for (std::size_t b = 0; b < burst; ++b) {
+                seq.push_back(p);
+            }
+        }
+        return seq;
+    }
+
+    template <bool Flat>
+    void Dispatch(benchmark::State& state, std::size_t burst)
+    {
+        const auto peers = static_cast<std::size_t>(state.range(0));
+        const auto eps = MakeEndpoints(peers);
+        const auto seq = MakeSequence(peers, burst);
+
+        std::map<udp::endpoint, std::shared_ptr<Peer>> map;
+        Rtt::Udp::UdpDispatchTable<std::shared_ptr<Peer>> table;
+        for (const auto& ep : eps) {
+            if constexpr (Flat) {
+                table.Insert(*Rtt::Udp::PackEndpoint(ep), std::make_shared<Peer>());
+            } else {
+                map.emplace(ep, std::make_shared<Peer>());
+            }
+        }
+
+        std::size_t i = 0;
+        for (auto _ : state) { // NOLINT(*-deadcode.DeadStores)
+            const auto& sender = eps[seq[i++ % seq.size()]];
+            if constexpr (Flat) {
+                benchmark::DoNotOptimize(table.Find(*Rtt::Udp::PackEndpoint(sender)));
+            } else {
+                benchmark::DoNotOptimize(map.find(sender));
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+static void BM_DispatchMapUniform(benchmark::State& state) { Dispatch<false>(state, 1); }
+static void BM_DispatchFlatUniform(benchmark::State& state) { Dispatch<true>(state, 1); }
+static void BM_DispatchMapBursty(benchmark::State& state) { Dispatch<false>(state, 8); }
+static void BM_DispatchFlatBursty(benchmark::State& state) { Dispatch<true>(state, 8); }
+
+BENCHMARK(BM_DispatchMapUniform)->ArgName("peers")->Arg(10)->Arg(1000)->Arg(50000);
+BENCHMARK(BM_DispatchFlatUniform)->ArgName("peers")->Arg(10)->Arg(1000)->Arg(50000);
+BENCHMARK(BM_DispatchMapBursty)->ArgName("peers")->Arg(10)->Arg(1000)->Arg(50000);
+BENCHMARK(BM_DispatchFlatBursty)->ArgName("peers")->Arg(10)->Arg(1000)->Arg(50000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,177 @@
+#include "Cross/Defines.h"
+#include "Rtt/Handler.h"
+#include "Rtt/Link.h"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+// Per-packet receive dispatch cost: how a transport hands one datagram to the
+// user's handler. Compares std::function (the former LinkHandler member),
+// Rtt::Delegate (the current LinkHandler member, here via Bind()) and a
+// virtual interface. The "transport" side is CROSS_NOINLINE so the handler
+// cannot be inlined into the benchmark loop through constant propagation.
+
+namespace
+{
+    constexpr std::size_t PacketSize = 64;
+    constexpr std::size_t Packets = 256;
+
+    using Packet = std::array<std::byte, PacketSize>;
+    using Packets256 = std::array<Packet, Packets>;
+
+    struct CountingHandler
+    {
+        std::size_t bytes = 0;
+        std::size_t received = 0;
+
+        void OnReceived(std::span<const std::byte> data)
+        {
+            benchmark::DoNotOptimize(data.data()); // keep the per-packet loop from being folded
+            bytes += data.size();
+            ++received;
+        }
+        void OnDisconnected() {}
+    };
+    static_assert(Rtt::LinkHandlerLike<CountingHandler>);
+
+    class IReceiveHandler
+    {
+    public:
+        virtual ~IReceiveHandler() = default;
+        virtual void OnReceived(std::span<const std::byte> data) = 0;
+    };
+
+    class VirtualHandler : public IReceiveHandler
+    {
+    public:
+        explicit VirtualHandler(CountingHandler& counter)
+            : _counter(counter)
+        {}
+        void OnReceived(std::span<const std::byte> data) override { _counter.OnReceived(data); }
+
+    private:
+        CountingHandler& _counter;
+    };
+
+    CROSS_NOINLINE void DeliverAll(const Packets256& packets, const std::function<void(std::span<const std::byte>)>& onReceived)
+    {
+        for (const auto& p : packets) {
+            onReceived(p);
+        }
+    }
+
+    CROSS_NOINLINE void DeliverAll(const Packets256& packets, const Rtt::LinkHandler& handler)
+    {
+        for (const auto& p : packets) {
+            handler.onReceived(p);
+        }
+    }
+
+    CROSS_NOINLINE void DeliverAll(const Packets256& packets, IReceiveHandler& handler)
+    {
+        for (const auto& p : packets) {
+            handler.OnReceived(p);
+        }
+    }
+
+    Packets256 MakePackets()
+    {
+        Packets256 packets{};
+        for (std::size_t i = 0; i < Packets; ++i) {
+            packets[i].fill(static_cast<std::byte>(i));
+        }
+        return packets;
+    }
+
+    void Report(benchmark::State& state, const CountingHandler& counter)
+    {
+        benchmark::DoNotOptimize(counter.bytes);
+        state.SetItemsProcessed(static_cast<std::int64_t>(counter.received));
+    }
+}
+
+static void BM_DispatchStdFunction(benchmark::State& state)
+{
+    const auto packets = MakePackets();
+    CountingHandler counter;
+    const std::function<void(std::span<const std::byte>)> onReceived =
+        [&counter](std::span<const std::byte> data) { counter.OnReceived(data); };
+
+    for (auto _ : state) { // NOLINT(*-deadcode.DeadStores)
+        DeliverAll(packets, onReceived);
+    }
+    Report(state, counter);
+}
+BENCHMARK(BM_DispatchStdFunction);
+
+static void BM_DispatchDelegate(benchmark::State& state)
+{
+    const auto packets = MakePackets();
+    CountingHandler counter;
+    const auto handler = Rtt::Bind(counter);
+
+    for (auto _ : state) { // NOLINT(*-deadcode.DeadStores)
+        DeliverAll(packets, handler);
+    }
+    Report(state, counter);
+}
+BENCHMARK(BM_DispatchDelegate);
+
+static void BM_DispatchVirtual(benchmark::State& state)
+{
+    const auto packets = MakePackets();
+    CountingHandler counter;
+    VirtualHandler handler{counter};
+
+    for (auto _ : state) { // NOLINT(*-deadcode.DeadStores)
+        DeliverAll(packets, handler);
+    }
+    Report(state, counter);
+}
+BENCHMARK(BM_DispatchVirtual);
+
+// Send-side writer: constructing and invoking a WriteCallback per packet,
+// std::function vs Delegate. A capture of three references exceeds
+// std::function's small buffer on common implementations.
+static void BM_WriterStdFunction(benchmark::State& state)
+{
+    Packet out{};
+    const Packet payload{};
+    std::size_t total = 0;
+
+    for (auto _ : state) { // NOLINT(*-deadcode.DeadStores)
+        const std::function<std::size_t(std::span<std::byte>)> writer =
+            [&payload, &total, &out](std::span<std::byte> buf) {
+                total += buf.size();
+                out[0] = payload[0];
+                return payload.size();
+            };
+        benchmark::DoNotOptimize(writer(out));
+    }
+    benchmark::DoNotOptimize(total);
+}
+BENCHMARK(BM_WriterStdFunction);
+
+static void BM_WriterDelegate(benchmark::State& state)
+{
+    Packet out{};
+    const Packet payload{};
+    std::size_t total = 0;
+
+    for (auto _ : state) { // NOLINT(*-deadcode.DeadStores)
+        const Rtt::WriteCallback writer =
+            [&payload, &total, &out](std::span<std::byte> buf) {
+                total += buf.size();
+                out[0] = payload[0];
+                return payload.size();
+            };
+        benchmark::DoNotOptimize(writer(out));
+    }
+    benchmark::DoNotOptimize(total);
+}
+BENCHMARK(BM_WriterDelegate);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,79 @@
+#include "Udp/UdpServer.h"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <boost/asio.hpp>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Loopback receive throughput of Rtt::Udp::UdpServer: per-datagram
+// async_receive_from (batch 1) vs recvmmsg batching (8, 64 datagrams per wakeup).
+// Each iteration queues `batch` datagrams from a few senders, then polls the
+// io_context until the server has dispatched all of them.
+
+namespace
+{
+    namespace asio = boost::asio;
+
+    class CountingAcceptor : public Rtt::ILinkAcceptor
+    {
+    public:
+        Rtt::LinkHandler OnLink(Rtt::LinkResult result) override
+        {
+            if (!result) {
+                return {};
+            }
+            links.push_back(*result);
+            return {
+                .onReceived = [this](std::span<const std::byte> data) { bytes += data.size(); ++received; },
+                .onDisconnected = {},
+            };
+        }
+
+        std::vector<std::shared_ptr<Rtt::ILink>> links;
+        std::size_t received = 0;
+        std::size_t bytes = 0;
+    };
+
+    constexpr std::size_t Senders = 4;
+    constexpr std::size_t PayloadSize = 64;
+}
+
+static void BM_UdpServerReceive(benchmark::State& state)
+{
+    const auto batch = static_cast<std::size_t>(state.range(0));
+
+    asio::io_context io;
+    auto acceptor = std::make_shared<CountingAcceptor>();
+    Rtt::Udp::UdpServer server{{
+        .executor = io.get_executor(),
+        .localPort = 0,
+        .receiveBatchSize = batch,
+    }};
+    server.Open(acceptor);
+
+    const asio::ip::udp::endpoint target{asio::ip::make_address("127.0.0.1"), server.LocalPort()};
+    std::vector<asio::ip::udp::socket> senders;
+    for (std::size_t i = 0; i < Senders; ++i) {
+        senders.emplace_back(io, asio::ip::udp::v4());
+    }
+    const std::array<std::byte, PayloadSize> payload{};
+
+    std::size_t expected = 0;
+    for (auto _ : state) { // NOLINT(*-deadcode.DeadStores)
+        for (std::size_t i = 0; i < batch; ++i) {
+            senders[i % Senders].send_to(asio::buffer(payload), target);
+        }
+        expected += batch;
+        while (acceptor->received < expected) {
+            io.poll();
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(acceptor->received));
+    state.SetBytesProcessed(static_cast<std::int64_t>(acceptor->bytes));
+}
+BENCHMARK(BM_UdpServerReceive)->ArgName("batch")->Arg(1)->Arg(8)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,74 @@
+#include "Udp/UdpSendPool.h"
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// ReSharper disable CppDFAUnreadVariable
+
+// Compares the per-datagram send buffer strategies of Rtt::Udp::UdpLink::Send:
+// a fresh std::vector per datagram vs a slab recycled through UdpSendPool.
+// Each iteration mimics a send: acquire, let the writer fill a small payload,
+// then release (as the async completion handler does).
+
+namespace
+{
+    constexpr std::size_t PayloadSize = 64;
+}
+
+static void BM_SendBufferVector(benchmark::State& state)
+{
+    const auto maxDatagramSize = static_cast<std::size_t>(state.range(0));
+    const std::vector<std::byte> payload(PayloadSize, std::byte{0x5a});
+
+    for (auto _ : state) { // NOLINT(*-deadcode.DeadStores)
+        std::vector<std::byte> buf(maxDatagramSize);
+        std::memcpy(buf.data(), payload.data(), payload.size());
+        buf.resize(payload.size());
+        benchmark::DoNotOptimize(buf.data());
+    }
+}
+BENCHMARK(BM_SendBufferVector)->Arg(1472)->Arg(65507);
+
+static void BM_SendBufferPooled(benchmark::State& state)
+{
+    const auto maxDatagramSize = static_cast<std::size_t>(state.range(0));
+    const std::vector<std::byte> payload(PayloadSize, std::byte{0x5a});
+    auto pool = std::make_shared<Rtt::Udp::UdpSendPool>(maxDatagramSize, 64);
+
+    for (auto _ : state) { // NOLINT(*-deadcode.DeadStores)
+        auto buf = pool->Acquire();
+        std::memcpy(buf.Data(), payload.data(), payload.size());
+        benchmark::DoNotOptimize(buf.Data());
+    }
+
+    const auto stats = pool->GetStats();
+    state.counters["hits"] = static_cast<double>(stats.hits);
+    state.counters["misses"] = static_cast<double>(stats.misses);
+}
+BENCHMARK(BM_SendBufferPooled)->Arg(1472)->Arg(65507);
+
+// Several sends in flight at once (e.g. a broadcast tick before completions run)
+static void BM_SendBufferPooledInFlight(benchmark::State& state)
+{
+    const auto inFlight = static_cast<std::size_t>(state.range(0));
+    const std::vector<std::byte> payload(PayloadSize, std::byte{0x5a});
+    auto pool = std::make_shared<Rtt::Udp::UdpSendPool>(1472, 64);
+    std::vector<Rtt::Udp::UdpSendPool::Buffer> pending;
+    pending.reserve(inFlight);
+
+    for (auto _ : state) { // NOLINT(*-deadcode.DeadStores)
+        for (std::size_t i = 0; i < inFlight; ++i) {
+            auto& buf = pending.emplace_back(pool->Acquire());
+            std::memcpy(buf.Data(), payload.data(), payload.size());
+        }
+        pending.clear();
+    }
+
+    const auto stats = pool->GetStats();
+    state.counters["hits"] = static_cast<double>(stats.hits);
+    state.counters["misses"] = static_cast<double>(stats.misses);
+}
+BENCHMARK(BM_SendBufferPooledInFlight)->Arg(8)->Arg(64)->Arg(256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,115 @@
+#include "Udp/UdpDispatchTable.h"
+#include "Udp/UdpHandshake.h"
+#include "Udp/UdpLink.h"
+#include "Udp/UdpSendPool.h"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// ReSharper disable CppDFAUnreadVariable
+
+// Per-datagram cost of a flood from spoofed sources in Rtt::Udp::UdpServer.
+// Without the handshake every datagram from a new address builds a UdpLink,
+// inserts it into the dispatch table and asks the acceptor for a handler
+// (the table is reset every 64k peers, as eviction would). With the handshake
+// a Hello costs one cookie MAC plus the Challenge encoding and anything else is
+// dropped after the magic check. Socket sends are left out of both sides.
+
+namespace
+{
+    namespace asio = boost::asio;
+    using udp = asio::ip::udp;
+    using namespace Rtt::Udp;
+
+    constexpr std::size_t PeersBeforeReset = 64 * 1024;
+
+    udp::endpoint SpoofedSender(std::uint32_t i)
+    {
+        return {asio::ip::address_v4{0x0a000000 + (i >> 4)}, static_cast<unsigned short>(40000 + (i & 15))};
+    }
+}
+
+static void BM_JunkCreatesLink(benchmark::State& state)
+{
+    asio::io_context io;
+    const auto socket = std::make_shared<udp::socket>(io);
+    const auto pool = std::make_shared<UdpSendPool>(1472, 64);
+    const Rtt::PeerId localId = Rtt::PeerId::FromIpv4(0x7f000001, 9000);
+    const std::array<std::byte, 32> junk{};
+
+    UdpDispatchTable<std::shared_ptr<UdpLink>> links;
+    std::uint32_t i = 0;
+    for (auto _ : state) { // NOLINT(*-deadcode.DeadStores)
+        const auto sender = SpoofedSender(i++);
+        const auto key = *PackEndpoint(sender);
+        if (links.Find(key) == nullptr) {
+            auto link = std::make_shared<UdpLink>(
+                socket, sender, localId, Rtt::PeerId::FromIpv4(sender.address().to_v4().to_uint(), sender.port()),
+                1472, pool, nullptr, [&links, key] { links.Erase(key); });
+            links.Insert(key, link);
+            link->SetHandler(Rtt::LinkHandler{
+                .onReceived = [](std::span<const std::byte> data) { benchmark::DoNotOptimize(data.data()); },
+            });
+            link->DeliverReceived(junk);
+        }
+        if (links.Size() >= PeersBeforeReset) {
+            links.Clear();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_JunkHandshakeHello(benchmark::State& state)
+{
+    const UdpCookies cookies;
+    std::array<std::byte, Handshake::MaxMessageSize> hello{};
+    Handshake::Write(hello, Handshake::Message::Hello);
+    std::array<std::byte, Handshake::MaxMessageSize> challenge{};
+
+    std::uint32_t i = 0;
+    for (auto _ : state) { // NOLINT(*-deadcode.DeadStores)
+        const auto key = *PackEndpoint(SpoofedSender(i++));
+        if (Handshake::Classify(hello) == Handshake::Message::Hello) {
+            const auto cookie = cookies.Make(key, UdpCookies::Clock::now());
+            benchmark::DoNotOptimize(Handshake::Write(challenge, Handshake::Message::Challenge, cookie));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_JunkHandshakeGarbage(benchmark::State& state)
+{
+    std::array<std::byte, 32> junk{};
+    for (auto _ : state) { // NOLINT(*-deadcode.DeadStores)
+        benchmark::DoNotOptimize(junk.data());
+        benchmark::DoNotOptimize(Handshake::Classify(junk));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_JunkHandshakeForgedResponse(benchmark::State& state)
+{
+    const UdpCookies cookies;
+    std::array<std::byte, Handshake::MaxMessageSize> response{};
+    Handshake::Write(response, Handshake::Message::Response, Handshake::Cookie{std::byte{1}});
+
+    std::uint32_t i = 0;
+    for (auto _ : state) { // NOLINT(*-deadcode.DeadStores)
+        const auto key = *PackEndpoint(SpoofedSender(i++));
+        const bool valid = Handshake::Classify(response) == Handshake::Message::Response &&
+                           cookies.Verify(key, Handshake::ReadCookie(response), UdpCookies::Clock::now());
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_JunkCreatesLink);
+BENCHMARK(BM_JunkHandshakeHello);
+BENCHMARK(BM_JunkHandshakeGarbage);
+BENCHMARK(BM_JunkHandshakeForgedResponse);
+
+BENCHMARK_MAIN();
@@ -66,3 +66,23 @@ TEST(DomainTest, CoroutineSenderWithSchedulerAccess)
     // co_await schedule resume) complete in a single Update() frame.
     EXPECT_EQ(runner->Run(), 55);
 }
+
+// With a drain budget the same hops spread over several frames: each Update()
+// runs one task and reports the rest as carried over.
+TEST(DomainTest, DrainBudgetSpreadsHopsOverFrames)
+{
+    auto domain = std::make_shared<Exec::Domain>(TwoHopTask());
+    domain->SetDrainBudget({.maxTasks = 1});
+    TestRunner runner{domain};
+
+    runner.DriveStart();
+    runner.DriveUpdate(0);
+    EXPECT_FALSE(runner.exitCode);
+    EXPECT_GT(domain->CarryOver(), 0u);
+
+    for (uint64_t frame = 1; frame < 10 && !runner.exitCode; ++frame) {
+        runner.DriveUpdate(frame);
+    }
+    EXPECT_EQ(runner.exitCode, 55);
+    EXPECT_EQ(domain->CarryOver(), 0u);
+}
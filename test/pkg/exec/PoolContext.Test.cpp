@@ -0,0 +1,134 @@
+#include "Exec/Context/PoolContext.h"
+#include "App/Factory.h"
+#include "Exec/Delay/LoopTimerBackend.h"
+#include "Exec/Delay/ThreadTimerBackend.h"
+#include "Exec/Domain.h"
+#include "Exec/RunTask.h"
+#include "ExecTestReceivers.h"
+
+#include <gtest/gtest.h>
+#include <stdexec/execution.hpp>
+#include <exec/async_scope.hpp>
+#include <exec/timed_scheduler.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace {
+
+using namespace Exec;
+using namespace ExecTest;
+using namespace std::chrono_literals;
+
+// ---------------------------------------------------------------------------
+// schedule()
+// ---------------------------------------------------------------------------
+
+// Work scheduled on the pool runs on a worker, never inline on the caller.
+TEST(PoolContextTest, ScheduleRunsOnWorker)
+{
+    PoolContext pool{{.threads = 2}, nullptr};
+    const auto [worker] = stdexec::sync_wait(
+        stdexec::schedule(pool.GetScheduler())
+        | stdexec::then([] { return std::this_thread::get_id(); })).value();
+    EXPECT_NE(worker, std::this_thread::get_id());
+}
+
+// threads = 0 picks a size from the hardware, always at least one worker.
+TEST(PoolContextTest, DefaultThreadCount)
+{
+    PoolContext pool{{}, nullptr};
+    EXPECT_GE(pool.ThreadCount(), 1u);
+}
+
+// Every spawned operation completes, whichever worker takes it.
+TEST(PoolContextTest, ManyTasksComplete)
+{
+    constexpr int Count = 10'000;
+    std::atomic<int> done{0};
+
+    PoolContext pool{{.threads = 4}, nullptr};
+    exec::async_scope scope;
+    for (int i = 0; i < Count; ++i) {
+        scope.spawn(stdexec::schedule(pool.GetScheduler())
+            | stdexec::then([&done] { done.fetch_add(1, std::memory_order_relaxed); }));
+    }
+    stdexec::sync_wait(scope.on_empty());
+
+    EXPECT_EQ(done.load(), Count);
+}
+
+// Work scheduled from a worker (a continuation) also completes.
+TEST(PoolContextTest, ScheduleFromWorker)
+{
+    PoolContext pool{{.threads = 2}, nullptr};
+    const auto sched = pool.GetScheduler();
+    const auto [value] = stdexec::sync_wait(
+        stdexec::schedule(sched)
+        | stdexec::then([] { return 20; })
+        | stdexec::continues_on(sched)
+        | stdexec::then([](int v) { return v + 1; })).value();
+    EXPECT_EQ(value, 21);
+}
+
+// Stop requested before a worker runs the operation → set_stopped().
+TEST(PoolContextTest, StopRequested_SetStopped)
+{
+    Outcome outcome;
+    stdexec::inplace_stop_source source;
+    source.request_stop();
+
+    auto pool = std::make_unique<PoolContext>(PoolContext::Options{.threads = 1}, nullptr);
+    auto op = stdexec::connect(pool->GetScheduler().schedule(),
+                               StopReceiver{&outcome, source.get_token()});
+    stdexec::start(op);
+    pool.reset(); // drains the queue and joins the worker
+
+    EXPECT_TRUE(outcome.stopped);
+    EXPECT_FALSE(outcome.valued);
+}
+
+// ---------------------------------------------------------------------------
+// schedule_after() / schedule_at()
+// ---------------------------------------------------------------------------
+
+// The deadline is kept by the shared backend; the completion runs on a worker.
+TEST(PoolContextTest, ScheduleAfterCompletesOnWorker)
+{
+    ThreadTimerBackend backend;
+    PoolContext pool{{.threads = 2}, &backend};
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto [worker] = stdexec::sync_wait(
+        exec::schedule_after(pool.GetScheduler(), 5ms)
+        | stdexec::then([] { return std::this_thread::get_id(); })).value();
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 5ms);
+    EXPECT_NE(worker, std::this_thread::get_id());
+}
+
+// ---------------------------------------------------------------------------
+// RunTask hop
+// ---------------------------------------------------------------------------
+
+// A RunTask moves a step onto the pool and back onto the frame loop.
+TEST(PoolContextTest, RunTaskHopsToPoolAndBack)
+{
+    PoolContext pool{{.threads = 2}, nullptr};
+    auto domain = std::make_shared<Exec::Domain>(
+        [](PoolContext::Scheduler poolSched) -> Exec::RunTask<int> {
+            const auto loop = co_await stdexec::read_env(stdexec::get_scheduler);
+            const auto loopThread = std::this_thread::get_id();
+            const auto worker = co_await (stdexec::schedule(loop)
+                | stdexec::continues_on(poolSched)
+                | stdexec::then([] { return std::this_thread::get_id(); })
+                | stdexec::continues_on(loop));
+            co_return worker != loopThread && std::this_thread::get_id() == loopThread ? 7 : 1;
+        }(pool.GetScheduler()),
+        std::make_unique<Exec::LoopTimerBackend>());
+    EXPECT_EQ(App::CreateTestRunner(domain)->Run(), 7);
+}
+
+} // namespace
@@ -276,6 +276,94 @@ TEST(PureLoopContextTest, DrainIsGreedy)
     EXPECT_TRUE(second);
 }
 
+// ---------------------------------------------------------------------------
+// Budgeted drain
+// ---------------------------------------------------------------------------
+
+// maxTasks bounds one drain; the remainder runs on the next call.
+TEST(PureLoopContextTest, BudgetedDrainCarriesRemainderOver)
+{
+    PureLoopContext ctx;
+    bool a = false, b = false, c = false;
+
+    ManualNode na{a}, nb{b}, nc{c};
+    ctx.Enqueue(&na);
+    ctx.Enqueue(&nb);
+    ctx.Enqueue(&nc);
+
+    EXPECT_EQ(ctx.DrainQueue({.maxTasks = 2}), 2u);
+    EXPECT_TRUE(a);
+    EXPECT_TRUE(b);
+    EXPECT_FALSE(c);
+    EXPECT_EQ(ctx.PendingCount(), 1u);
+
+    EXPECT_EQ(ctx.DrainQueue({.maxTasks = 2}), 1u);
+    EXPECT_TRUE(c);
+    EXPECT_EQ(ctx.PendingCount(), 0u);
+}
+
+// An expired time budget still runs one task, so work always progresses.
+TEST(PureLoopContextTest, ZeroTimeBudgetRunsOneTask)
+{
+    PureLoopContext ctx;
+    bool a = false, b = false;
+
+    ManualNode na{a}, nb{b};
+    ctx.Enqueue(&na);
+    ctx.Enqueue(&nb);
+
+    EXPECT_EQ(ctx.DrainQueue({.maxTime = DrainBudget::Duration::zero()}), 1u);
+    EXPECT_TRUE(a);
+    EXPECT_FALSE(b);
+    EXPECT_EQ(ctx.DrainQueue({.maxTime = DrainBudget::Duration::zero()}), 1u);
+    EXPECT_TRUE(b);
+}
+
+// A node that re-enqueues itself would keep a greedy drain busy until it
+// stops; a budgeted drain returns after maxTasks runs.
+TEST(PureLoopContextTest, BudgetedDrainBoundsSelfRequeue)
+{
+    struct RequeueNode : OperationBase
+    {
+        PureLoopContext* ctx;
+        int remaining;
+
+        static void Run(OperationBase* base) noexcept
+        {
+            auto& self = *static_cast<RequeueNode*>(base);
+            if (--self.remaining > 0) {
+                self.ctx->Enqueue(&self);
+            }
+        }
+
+        RequeueNode(PureLoopContext* c, int n) : ctx(c), remaining(n) { this->execute = Run; }
+    };
+
+    PureLoopContext ctx;
+    RequeueNode node{&ctx, 10};
+    ctx.Enqueue(&node);
+
+    EXPECT_EQ(ctx.DrainQueue({.maxTasks = 4}), 4u);
+    EXPECT_EQ(node.remaining, 6);
+    EXPECT_EQ(ctx.DrainQueue({.maxTasks = 4}), 4u);
+    EXPECT_EQ(ctx.DrainQueue({.maxTasks = 4}), 2u);
+    EXPECT_EQ(node.remaining, 0);
+}
+
+// The default budget is unlimited: same as the greedy DrainQueue().
+TEST(PureLoopContextTest, DefaultBudgetIsGreedy)
+{
+    PureLoopContext ctx;
+    bool a = false, b = false;
+
+    ManualNode na{a}, nb{b};
+    ctx.Enqueue(&na);
+    ctx.Enqueue(&nb);
+
+    EXPECT_TRUE(DrainBudget{}.IsUnlimited());
+    EXPECT_EQ(ctx.DrainQueue(DrainBudget{}), 2u);
+}
+
 // ---------------------------------------------------------------------------
 // Scheduler equality
 // ---------------------------------------------------------------------------
@@ -0,0 +1,128 @@
+#include "Exec/Delay/ThreadTimerBackend.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace Exec;
+using namespace std::chrono_literals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+} // namespace
+
+// A callback fires once, never before its deadline.
+TEST(ThreadTimerBackendTest, FiresAtOrAfterDeadline)
+{
+    ThreadTimerBackend backend;
+    std::promise<Clock::time_point> fired;
+    const auto deadline = Clock::now() + 5ms;
+
+    const auto id = backend.ScheduleAt(deadline, [&] { fired.set_value(Clock::now()); });
+
+    auto future = fired.get_future();
+    ASSERT_EQ(future.wait_for(5s), std::future_status::ready);
+    EXPECT_GE(future.get(), deadline);
+    EXPECT_FALSE(backend.Cancel(id));
+}
+
+// Cancel() succeeds exactly once, and never for ids it did not issue.
+TEST(ThreadTimerBackendTest, CancelIsOneShot)
+{
+    ThreadTimerBackend backend;
+    std::atomic<bool> fired{false};
+
+    const auto id = backend.ScheduleAt(Clock::now() + 1h, [&] { fired = true; });
+
+    EXPECT_TRUE(backend.Cancel(id));
+    EXPECT_FALSE(backend.Cancel(id));
+    EXPECT_FALSE(backend.Cancel(ITimerBackend::InvalidTimerId));
+    EXPECT_FALSE(backend.Cancel(id + 1));
+    EXPECT_FALSE(fired);
+}
+
+// Cancel() of a running callback blocks until it returns, then reports false.
+TEST(ThreadTimerBackendTest, CancelWaitsForRunningCallback)
+{
+    ThreadTimerBackend backend;
+    std::promise<void> started;
+    std::atomic<bool> finished{false};
+
+    const auto id = backend.ScheduleAt(Clock::now(), [&] {
+        started.set_value();
+        std::this_thread::sleep_for(20ms);
+        finished = true;
+    });
+
+    ASSERT_EQ(started.get_future().wait_for(5s), std::future_status::ready);
+    EXPECT_FALSE(backend.Cancel(id));
+    EXPECT_TRUE(finished);
+}
+
+// Every timer either fires or is cancelled — never both, never neither —
+// while several threads schedule and cancel around their deadlines.
+TEST(ThreadTimerBackendTest, ConcurrentCancelRacesFiring)
+{
+    constexpr int Threads = 4;
+    constexpr int PerThread = 2000;
+
+    ThreadTimerBackend backend;
+    auto fired = std::make_unique<std::atomic<int>[]>(Threads * PerThread);
+    std::atomic<int> cancelled{0};
+
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < Threads; ++t) {
+        threads.emplace_back([&, t] {
+            std::minstd_rand rng(t + 1);
+            for (int i = 0; i < PerThread; ++i) {
+                auto& count = fired[t * PerThread + i];
+                const auto id = backend.ScheduleAt(Clock::now() + 1us * (rng() % 500), [&count] { ++count; });
+                if (rng() % 2 == 0) {
+                    std::this_thread::sleep_for(1us * (rng() % 300));
+                }
+                if (backend.Cancel(id)) {
+                    ++cancelled;
+                    EXPECT_EQ(count, 0);
+                } else {
+                    EXPECT_EQ(count, 1); // fired, and has returned
+                }
+            }
+        });
+    }
+    threads.clear();
+
+    int total = 0;
+    for (int i = 0; i < Threads * PerThread; ++i) {
+        total += fired[i];
+    }
+    EXPECT_EQ(total + cancelled, Threads * PerThread);
+}
+
+// Cancelled timers far in the future do not hold up later ones, and their
+// entries are recycled.
+TEST(ThreadTimerBackendTest, ManyCancelledTimersAreSwept)
+{
+    ThreadTimerBackend backend;
+    std::vector<ITimerBackend::TimerId> ids;
+    for (int i = 0; i < 10000; ++i) {
+        ids.push_back(backend.ScheduleAt(Clock::now() + 1h, [] {}));
+    }
+    for (const auto id : ids) {
+        EXPECT_TRUE(backend.Cancel(id));
+    }
+
+    std::promise<void> fired;
+    backend.ScheduleAt(Clock::now() + 1ms, [&] { fired.set_value(); });
+    EXPECT_EQ(fired.get_future().wait_for(5s), std::future_status::ready);
+    for (const auto id : ids) {
+        EXPECT_FALSE(backend.Cancel(id));
+    }
+}
@@ -1,12 +1,15 @@
 #include "Exec/Context/TimedLoopContext.h"
 #include "Exec/Delay/LoopTimerBackend.h"
+#include "Exec/Delay/ThreadTimerBackend.h"
 #include "ExecTestReceivers.h"
 
 #include <gtest/gtest.h>
 #include <stdexec/execution.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -306,14 +309,14 @@ TEST(DestructorTest, StopWins_TimerCancelledEagerly)
         ctx.DrainQueue();      // set_stopped delivered
         ASSERT_TRUE(outcome.stopped);
 
-        // op destructor: timerId already cleared by TryEnqueueStop → no second Cancel
+        // op destructor: the timer is already out of the backend → no second Cancel
     }
 
     EXPECT_TRUE(fake.WasCancelled(1)); // FakeTimerBackend assigns id 1 to first timer
 }
 
-// When the timer wins and set_value is delivered, the timer callback has already cleared
-// timerId — so the destructor skips Cancel. No redundant cancel for a timer that already fired.
+// When the timer wins and set_value is delivered, the backend is done with the node —
+// so the destructor skips Cancel. No redundant cancel for a timer that already fired.
 TEST(DestructorTest, TimerWins_NoCancelOnOpDestruction)
 {
     FakeTimerBackend fake;
@@ -325,16 +328,68 @@ TEST(DestructorTest, TimerWins_NoCancelOnOpDestruction)
                                    BasicReceiver{&outcome});
         stdexec::start(op);
 
-        fake.FireAll();    // timer fires, clears timerId, wins CAS, enqueues
+        fake.FireAll();    // timer fires, wins CAS, enqueues
         ctx.DrainQueue();  // set_value delivered
         ASSERT_TRUE(outcome.valued);
 
-        // op destructor: timerId == InvalidTimerId (cleared in lambda) → Cancel not called
+        // op destructor: timer already fired → Cancel not called
     }
 
     EXPECT_FALSE(fake.WasCancelled(1)); // timer already fired — no Cancel needed or issued
 }
 
+// Stop raced against start() from another thread must never leave the node in
+// the backend: a stop landing while start() is scheduling hands the cancel to
+// start(), so the timer cannot fire into a destroyed op state later.
+TEST(DestructorTest, StopRacingStart_LeavesNoTimerScheduled)
+{
+    struct NodeCountingBackend : ITimerBackend
+    {
+        ThreadTimerBackend inner;
+        std::atomic<int> scheduled{0};
+
+        TimerId ScheduleAt(TimePoint dl, Callback cb) override { return inner.ScheduleAt(dl, std::move(cb)); }
+        bool Cancel(TimerId id) noexcept override { return inner.Cancel(id); }
+
+        void ScheduleNode(TimerNode& node) override
+        {
+            ++scheduled;
+            inner.ScheduleNode(node);
+        }
+
+        bool CancelNode(TimerNode& node) noexcept override
+        {
+            const bool cancelled = inner.CancelNode(node);
+            scheduled -= cancelled ? 1 : 0;
+            return cancelled;
+        }
+    };
+
+    NodeCountingBackend backend;
+    TimedLoopContext ctx{&backend};
+
+    for (int i = 0; i < 2000; ++i) {
+        Outcome outcome;
+        stdexec::inplace_stop_source source;
+        std::atomic<bool> go{false};
+        {
+            auto op = stdexec::connect(ctx.GetScheduler().schedule_at(Future()),
+                                       StopReceiver{.outcome = &outcome, .token = source.get_token()});
+            std::thread stopper{[&] {
+                while (!go.load(std::memory_order_acquire)) {}
+                source.request_stop();
+            }};
+            go.store(true, std::memory_order_release);
+            stdexec::start(op);
+            stopper.join();
+
+            ctx.DrainQueue();
+            ASSERT_TRUE(outcome.stopped);
+        }
+        ASSERT_EQ(backend.scheduled, 0) << "iteration " << i;
+    }
+}
+
 // ---------------------------------------------------------------------------
 // DrainQueue wiring
 // ---------------------------------------------------------------------------
@@ -373,3 +428,23 @@ TEST(TickTest, DrainQueue_ProcessesTimersAndLoopWorkInSameCall)
     EXPECT_TRUE(outcome.valued);
     EXPECT_FALSE(outcome.stopped);
 }
+
+// A budgeted drain ticks the backend once too; timer completions then wait
+// their turn behind the budget like any other queued operation.
+TEST(TickTest, BudgetedDrain_TicksOnceAndCarriesOver)
+{
+    LoopTimerBackend loopBackend;
+    TimedLoopContext ctx{&loopBackend};
+    Outcome first, second;
+
+    auto op1 = stdexec::connect(ctx.GetScheduler().schedule_at(Past()), BasicReceiver{&first});
+    auto op2 = stdexec::connect(ctx.GetScheduler().schedule_at(Past()), BasicReceiver{&second});
+    stdexec::start(op1);
+    stdexec::start(op2);
+
+    EXPECT_EQ(ctx.DrainQueue({.maxTasks = 1}), 1u);
+    EXPECT_EQ(ctx.PendingCount(), 1u);
+    EXPECT_EQ(ctx.DrainQueue({.maxTasks = 1}), 1u);
+    EXPECT_TRUE(first.valued);
+    EXPECT_TRUE(second.valued);
+}
@@ -0,0 +1,158 @@
+#include "Exec/Delay/LoopTimerBackend.h"
+#include "Exec/Delay/ThreadTimerBackend.h"
+#include "Exec/Delay/WheelTimerBackend.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+
+using namespace Exec;
+using namespace std::chrono_literals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// A timer node completing a promise when it fires.
+struct PromiseNode : TimerNode
+{
+    std::promise<Clock::time_point> fired;
+
+    explicit PromiseNode(Clock::time_point at)
+        : TimerNode{.deadline = at, .fire = &Fire}
+    {}
+
+    static void Fire(TimerNode& node) noexcept
+    {
+        static_cast<PromiseNode&>(node).fired.set_value(Clock::now());
+    }
+};
+
+/// A timer node counting how often it fires.
+struct CountingNode : TimerNode
+{
+    std::atomic<int> count{0};
+
+    explicit CountingNode(Clock::time_point at)
+        : TimerNode{.deadline = at, .fire = &Fire}
+    {}
+
+    static void Fire(TimerNode& node) noexcept
+    {
+        ++static_cast<CountingNode&>(node).count;
+    }
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Thread-based backends with native node support
+// ---------------------------------------------------------------------------
+
+template <class Backend>
+class TimerNodeTest : public ::testing::Test
+{
+protected:
+    Backend backend;
+};
+
+using ThreadBackends = ::testing::Types<ThreadTimerBackend, WheelTimerBackend>;
+TYPED_TEST_SUITE(TimerNodeTest, ThreadBackends);
+
+// A scheduled node fires once, at or after its deadline.
+TYPED_TEST(TimerNodeTest, FiresAtOrAfterDeadline)
+{
+    PromiseNode node{Clock::now() + 5ms};
+    this->backend.ScheduleNode(node);
+
+    auto future = node.fired.get_future();
+    ASSERT_EQ(future.wait_for(5s), std::future_status::ready);
+    EXPECT_GE(future.get(), node.deadline);
+    EXPECT_FALSE(this->backend.CancelNode(node));
+}
+
+// CancelNode() before the deadline unlinks the node; it never fires.
+TYPED_TEST(TimerNodeTest, CancelPreventsFiring)
+{
+    CountingNode cancelled{Clock::now() + 10ms};
+    PromiseNode sentinel{Clock::now() + 20ms};
+    this->backend.ScheduleNode(cancelled);
+    this->backend.ScheduleNode(sentinel);
+
+    EXPECT_TRUE(this->backend.CancelNode(cancelled));
+    EXPECT_FALSE(this->backend.CancelNode(cancelled));
+
+    ASSERT_EQ(sentinel.fired.get_future().wait_for(5s), std::future_status::ready);
+    EXPECT_EQ(cancelled.count, 0);
+}
+
+// Cancelling one of many nodes leaves the others to fire in deadline order.
+TYPED_TEST(TimerNodeTest, CancelInTheMiddleKeepsOrder)
+{
+    const auto now = Clock::now();
+    std::vector<std::unique_ptr<PromiseNode>> nodes;
+    for (int i = 0; i < 16; ++i) {
+        nodes.push_back(std::make_unique<PromiseNode>(now + 1ms * (16 - i)));
+        this->backend.ScheduleNode(*nodes.back());
+    }
+    for (int i = 0; i < 16; i += 2) {
+        EXPECT_TRUE(this->backend.CancelNode(*nodes[i]));
+    }
+
+    Clock::time_point previous{};
+    for (int i = 15; i > 0; i -= 2) {
+        auto future = nodes[i]->fired.get_future();
+        ASSERT_EQ(future.wait_for(5s), std::future_status::ready);
+        const auto at = future.get();
+        EXPECT_GE(at, previous);
+        previous = at;
+    }
+}
+
+// Node and callback timers share one backend.
+TYPED_TEST(TimerNodeTest, MixesWithCallbacks)
+{
+    PromiseNode node{Clock::now() + 2ms};
+    std::promise<void> callback;
+
+    this->backend.ScheduleNode(node);
+    this->backend.ScheduleAt(Clock::now() + 1ms, [&] { callback.set_value(); });
+
+    EXPECT_EQ(callback.get_future().wait_for(5s), std::future_status::ready);
+    EXPECT_EQ(node.fired.get_future().wait_for(5s), std::future_status::ready);
+}
+
+// ---------------------------------------------------------------------------
+// Default implementation over ScheduleAt()
+// ---------------------------------------------------------------------------
+
+// LoopTimerBackend has no node support of its own: the node rides a callback.
+TEST(TimerNodeFallbackTest, LoopBackendFiresOnTick)
+{
+    LoopTimerBackend backend;
+    CountingNode node{Clock::now() - 1ms};
+
+    backend.ScheduleNode(node);
+    EXPECT_NE(node.link, ITimerBackend::InvalidTimerId);
+    backend.Tick();
+
+    EXPECT_EQ(node.count, 1);
+    EXPECT_FALSE(backend.CancelNode(node));
+}
+
+TEST(TimerNodeFallbackTest, LoopBackendCancel)
+{
+    LoopTimerBackend backend;
+    CountingNode node{Clock::now() - 1ms};
+
+    backend.ScheduleNode(node);
+    EXPECT_TRUE(backend.CancelNode(node));
+    backend.Tick();
+
+    EXPECT_EQ(node.count, 0);
+    EXPECT_FALSE(backend.CancelNode(node));
+}
@@ -0,0 +1,168 @@
+#include "Exec/Delay/WheelTimerBackend.h"
+#include "Exec/Domain.h"
+#include "App/Factory.h"
+#include "TestRunner.h"
+
+#include <gtest/gtest.h>
+#include <stdexec/execution.hpp>
+#include <exec/task.hpp>
+#include <exec/timed_scheduler.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <vector>
+
+using namespace Exec;
+using namespace std::chrono_literals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+WheelTimerBackend::Options FineTicks()
+{
+    return {.tick = 100us};
+}
+
+} // namespace
+
+// A callback fires once, never before its deadline.
+TEST(WheelTimerBackendTest, FiresAtOrAfterDeadline)
+{
+    WheelTimerBackend backend{FineTicks()};
+    std::promise<Clock::time_point> fired;
+    const auto deadline = Clock::now() + 5ms;
+
+    backend.ScheduleAt(deadline, [&] { fired.set_value(Clock::now()); });
+
+    auto future = fired.get_future();
+    ASSERT_EQ(future.wait_for(5s), std::future_status::ready);
+    EXPECT_GE(future.get(), deadline);
+}
+
+// Deadlines in the past fire on the next tick.
+TEST(WheelTimerBackendTest, PastDeadlineFiresPromptly)
+{
+    WheelTimerBackend backend{FineTicks()};
+    std::promise<void> fired;
+
+    backend.ScheduleAt(Clock::now() - 1s, [&] { fired.set_value(); });
+
+    EXPECT_EQ(fired.get_future().wait_for(5s), std::future_status::ready);
+}
+
+// Callbacks with different deadlines fire in deadline order.
+TEST(WheelTimerBackendTest, FiresInDeadlineOrder)
+{
+    WheelTimerBackend backend{FineTicks()};
+    std::vector<int> order;
+    std::promise<void> done;
+    const auto now = Clock::now();
+
+    backend.ScheduleAt(now + 30ms, [&] { order.push_back(3); done.set_value(); });
+    backend.ScheduleAt(now + 10ms, [&] { order.push_back(1); });
+    backend.ScheduleAt(now + 20ms, [&] { order.push_back(2); });
+
+    ASSERT_EQ(done.get_future().wait_for(5s), std::future_status::ready);
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+// Cancel() before the deadline suppresses the callback; a second Cancel() reports false.
+TEST(WheelTimerBackendTest, CancelPreventsFiring)
+{
+    WheelTimerBackend backend{FineTicks()};
+    std::atomic<bool> cancelledFired{false};
+    std::promise<void> sentinel;
+
+    const auto id = backend.ScheduleAt(Clock::now() + 10ms, [&] { cancelledFired = true; });
+    backend.ScheduleAt(Clock::now() + 20ms, [&] { sentinel.set_value(); });
+
+    EXPECT_TRUE(backend.Cancel(id));
+    EXPECT_FALSE(backend.Cancel(id));
+
+    ASSERT_EQ(sentinel.get_future().wait_for(5s), std::future_status::ready);
+    EXPECT_FALSE(cancelledFired);
+}
+
+// Ids of fired timers go stale: Cancel() returns false even once their entry is reused.
+TEST(WheelTimerBackendTest, CancelAfterFiringReturnsFalse)
+{
+    WheelTimerBackend backend{FineTicks()};
+    std::promise<void> fired;
+
+    const auto id = backend.ScheduleAt(Clock::now(), [&] { fired.set_value(); });
+    ASSERT_EQ(fired.get_future().wait_for(5s), std::future_status::ready);
+
+    const auto reused = backend.ScheduleAt(Clock::now() + 1h, [] {});
+    EXPECT_NE(reused, id);
+    EXPECT_FALSE(backend.Cancel(id));
+    EXPECT_FALSE(backend.Cancel(ITimerBackend::InvalidTimerId));
+    EXPECT_TRUE(backend.Cancel(reused));
+}
+
+// Deadlines beyond the wheel's span (2^32 ticks) are held and can be cancelled.
+TEST(WheelTimerBackendTest, FarDeadlineCanBeCancelled)
+{
+    WheelTimerBackend backend{FineTicks()};
+    std::atomic<bool> fired{false};
+
+    const auto id = backend.ScheduleAt(Clock::now() + 24h * 365, [&] { fired = true; });
+
+    EXPECT_TRUE(backend.Cancel(id));
+    EXPECT_FALSE(fired);
+}
+
+// Deadlines spread over several wheel levels all fire exactly once.
+TEST(WheelTimerBackendTest, CascadedTimersFireOnce)
+{
+    // 1µs ticks: 200ms spans the first three levels
+    WheelTimerBackend backend{{.tick = 1us}};
+    constexpr int Count = 200;
+    std::atomic<int> fired{0};
+    std::atomic<int> early{0};
+    std::promise<void> done;
+    const auto now = Clock::now();
+
+    for (int i = 0; i < Count; ++i) {
+        const auto deadline = now + 1ms * i;
+        backend.ScheduleAt(deadline, [&, deadline] {
+            if (Clock::now() < deadline) {
+                ++early;
+            }
+            if (++fired == Count) {
+                done.set_value();
+            }
+        });
+    }
+
+    ASSERT_EQ(done.get_future().wait_for(10s), std::future_status::ready);
+    EXPECT_EQ(early, 0);
+}
+
+// Callbacks may schedule and cancel on the backend they run on.
+TEST(WheelTimerBackendTest, CallbackCanReschedule)
+{
+    WheelTimerBackend backend{FineTicks()};
+    std::promise<void> second;
+
+    backend.ScheduleAt(Clock::now(), [&] {
+        const auto stale = backend.ScheduleAt(Clock::now() + 1h, [] {});
+        backend.Cancel(stale);
+        backend.ScheduleAt(Clock::now() + 1ms, [&] { second.set_value(); });
+    });
+
+    EXPECT_EQ(second.get_future().wait_for(5s), std::future_status::ready);
+}
+
+// Domain drives exec::schedule_after through the wheel like any other backend.
+TEST(WheelTimerBackendTest, DomainScheduleAfterCompletes)
+{
+    auto domain = std::make_shared<Exec::Domain>(
+        [](auto sched) -> exec::task<int> {
+            co_await exec::schedule_after(sched, 2ms);
+            co_return 21;
+        },
+        std::make_unique<WheelTimerBackend>(FineTicks()));
+    EXPECT_EQ(App::CreateTestRunner(domain)->Run(), 21);
+}
@@ -1,17 +1,28 @@
 #include "MockLink.h"
 #include "MockTransport.h"
+#include "Rtt/Delegate.h"
 #include "Rtt/Error.h"
 #include "Rtt/Handler.h"
 #include "Rtt/Link.h"
+#include "Rtt/LinkEventQueue.h"
+#include "Rtt/LinkStats.h"
+#include "Rtt/Packet.h"
 #include "Rtt/PeerId.h"
+#include "Rtt/SendScratch.h"
 #include "Rtt/Transport.h"
+#include "Rtt/TransportStats.h"
 #include "TestAcceptor.h"
 
+#include <chrono>
 #include <cstddef>
 #include <cstring>
 #include <gtest/gtest.h>
 #include <memory>
 #include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 using namespace Rtt;
@@ -63,6 +74,123 @@ TEST(PeerId, StringViewConversion)
     EXPECT_EQ(sv, "node-42");
 }
 
+TEST(PeerId, LongIdFallsBackToHeap)
+{
+    const std::string text(PeerIdValue::InlineCapacity + 10, 'x');
+    PeerId id{.value = text};
+    PeerId copy = id;
+    PeerId moved = std::move(copy);
+
+    EXPECT_EQ(std::string_view{moved}, text);
+    EXPECT_EQ(moved, id);
+    EXPECT_EQ(std::strlen(moved.value.c_str()), text.size());
+}
+
+TEST(PeerId, FromIpv4MatchesTextForm)
+{
+    auto id = PeerId::FromIpv4(0x7f000001, 5000); // 127.0.0.1
+    EXPECT_EQ(std::string_view{id}, "127.0.0.1:5000");
+    EXPECT_EQ(id.value.Ipv4Endpoint(), (0x7f000001ULL << 16) | 5000);
+
+    PeerId text{.value = "127.0.0.1:5000"};
+    EXPECT_FALSE(text.value.Ipv4Endpoint().has_value());
+    EXPECT_EQ(id, text);
+    EXPECT_EQ(std::hash<PeerId>{}(id), std::hash<PeerId>{}(text));
+
+    EXPECT_EQ(std::string_view{PeerId::FromIpv4(0xffffffff, 65535)}, "255.255.255.255:65535");
+    EXPECT_NE(id, PeerId::FromIpv4(0x7f000001, 5001));
+}
+
+TEST(PeerId, UnorderedMapKey)
+{
+    std::unordered_map<PeerId, int> peers;
+    peers[PeerId{.value = "alice"}] = 1;
+    peers[PeerId::FromIpv4(0x0a000001, 9000)] = 2;
+
+    EXPECT_EQ(peers.at(PeerId{.value = "alice"}), 1);
+    EXPECT_EQ(peers.at(PeerId{.value = "10.0.0.1:9000"}), 2);
+    EXPECT_FALSE(peers.contains(PeerId{.value = "bob"}));
+}
+
+// ---------------------------------------------------------------------------
+// Delegate
+// ---------------------------------------------------------------------------
+
+TEST(Delegate, EmptyAndNull)
+{
+    Delegate<int(int)> empty;
+    Delegate<int(int)> null = nullptr;
+    EXPECT_FALSE(empty);
+    EXPECT_FALSE(null);
+
+    Delegate<int(int)> inc = [](int x) { return x + 1; };
+    EXPECT_TRUE(inc);
+    inc = nullptr;
+    EXPECT_FALSE(inc);
+}
+
+TEST(Delegate, MoveOnlyCaptureIsMovedAndDestroyed)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        Delegate<int()> first = [owned = std::make_unique<int>(41), counter] { return ++*counter + *owned; };
+        EXPECT_EQ(counter.use_count(), 2);
+
+        Delegate<int()> second = std::move(first);
+        EXPECT_FALSE(first); // NOLINT(*-use-after-move)
+        EXPECT_EQ(second(), 42);
+        EXPECT_EQ(counter.use_count(), 2);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(Delegate, ConvertsReturnType)
+{
+    WriteCallback writer = [](std::span<std::byte> buf) { return static_cast<int>(buf.size()); };
+    std::byte buf[8];
+    EXPECT_EQ(writer(buf), 8u);
+}
+
+TEST(Delegate, BindLinkHandlerLike)
+{
+    struct Handler
+    {
+        std::size_t bytes = 0;
+        bool disconnected = false;
+        void OnReceived(std::span<const std::byte> data) { bytes += data.size(); }
+        void OnDisconnected() { disconnected = true; }
+    };
+    static_assert(LinkHandlerLike<Handler>);
+
+    Handler h;
+    auto handler = Bind(h);
+    auto data = ToBytes("abc");
+    handler.onReceived(data);
+    handler.onDisconnected();
+
+    EXPECT_EQ(h.bytes, 3u);
+    EXPECT_TRUE(h.disconnected);
+    EXPECT_FALSE(handler.onWritable);
+}
+
+TEST(Delegate, BindOptionalOnWritable)
+{
+    struct Handler
+    {
+        int writable = 0;
+        void OnReceived(std::span<const std::byte>) {}
+        void OnDisconnected() {}
+        void OnWritable() { ++writable; }
+    };
+
+    Handler h;
+    auto handler = Bind(h);
+    ASSERT_TRUE(handler.onWritable);
+    handler.onWritable();
+
+    EXPECT_EQ(h.writable, 1);
+}
+
 // ---------------------------------------------------------------------------
 // Error
 // ---------------------------------------------------------------------------
@@ -192,6 +320,56 @@ TEST(Link, SendMultiplePackets)
     EXPECT_EQ(link->SentPackets()[2][0], static_cast<std::byte>(2));
 }
 
+TEST(Link, SendVDefaultGathersThroughSend)
+{
+    auto link = std::make_shared<MockLink>(
+        PeerId{.value = "A"}, PeerId{.value = "B"});
+
+    const auto header = ToBytes("head");
+    const auto body = ToBytes("-body");
+    const std::span<const std::byte> parts[] = {header, body};
+    link->SendV(parts);
+
+    ASSERT_EQ(link->SentPackets().size(), 1u);
+    EXPECT_EQ(link->SentPackets()[0], ToBytes("head-body"));
+}
+
+TEST(Link, UnlimitedLinkIsAlwaysWritable)
+{
+    auto link = std::make_shared<MockLink>(
+        PeerId{.value = "A"}, PeerId{.value = "B"});
+
+    EXPECT_TRUE(link->Writable());
+    EXPECT_EQ(link->OutstandingBytes(), 0u);
+    EXPECT_EQ(link->TrySend([](std::span<std::byte> buf) -> std::size_t {
+        buf[0] = std::byte{1};
+        return 1;
+    }), SendStatus::Sent);
+    link->SendWhenWritable([](std::span<std::byte> buf) -> std::size_t {
+        buf[0] = std::byte{2};
+        return 1;
+    });
+
+    ASSERT_EQ(link->SentPackets().size(), 2u);
+    EXPECT_EQ(link->SentPackets()[1][0], std::byte{2});
+}
+
+TEST(Link, SingleChannelLinkSendsEveryChannel)
+{
+    auto mock = std::make_shared<MockLink>(
+        PeerId{.value = "A"}, PeerId{.value = "B"});
+    ILink& link = *mock;
+
+    EXPECT_EQ(link.ChannelCount(), 1u);
+    link.Send(3, [](std::span<std::byte> buf) -> std::size_t {
+        buf[0] = std::byte{3};
+        return 1;
+    });
+
+    ASSERT_EQ(mock->SentPackets().size(), 1u);
+    EXPECT_EQ(mock->SentPackets()[0][0], std::byte{3});
+}
+
 // ---------------------------------------------------------------------------
 // Receive — data delivery via LinkHandler
 // ---------------------------------------------------------------------------
@@ -258,3 +436,322 @@ TEST(Link, PeerIdIdentification)
     EXPECT_EQ(ilink.LocalId().value, "local-node");
     EXPECT_EQ(ilink.RemoteId().value, "remote-node");
 }
+
+// ---------------------------------------------------------------------------
+// Statistics
+// ---------------------------------------------------------------------------
+
+TEST(LinkStats, DefaultIsZero)
+{
+    auto link = std::make_shared<MockLink>(PeerId{"a"}, PeerId{"b"});
+    const ILink& ilink = *link;
+    const auto stats = ilink.GetStats();
+    EXPECT_EQ(stats.packetsSent, 0u);
+    EXPECT_EQ(stats.rttSamples, 0u);
+}
+
+TEST(LinkStats, CountersAndSmoothedRtt)
+{
+    using std::chrono::microseconds;
+    LinkCounters counters;
+    counters.OnSent(100);
+    counters.OnSent(50);
+    counters.OnReceived(10);
+    counters.OnSendDrop();
+
+    // First sample seeds srtt = r, variation = r / 2 (RFC 6298)
+    counters.OnRttSample(microseconds(8000));
+    auto stats = counters.Snapshot();
+    EXPECT_EQ(stats.packetsSent, 2u);
+    EXPECT_EQ(stats.bytesSent, 150u);
+    EXPECT_EQ(stats.packetsReceived, 1u);
+    EXPECT_EQ(stats.bytesReceived, 10u);
+    EXPECT_EQ(stats.sendDrops, 1u);
+    EXPECT_EQ(stats.rtt, microseconds(8000));
+    EXPECT_EQ(stats.rttVariation, microseconds(4000));
+
+    // Then srtt += (r - srtt) / 8, variation += (|srtt - r| - variation) / 4
+    counters.OnRttSample(microseconds(16000));
+    stats = counters.Snapshot();
+    EXPECT_EQ(stats.rtt, microseconds(9000));
+    EXPECT_EQ(stats.rttVariation, microseconds(5000));
+    EXPECT_EQ(stats.rttSamples, 2u);
+}
+
+TEST(TransportStats, SumsLiveAndRetiredLinks)
+{
+    using std::chrono::microseconds;
+    TransportStats stats;
+    auto a = stats.Track();
+    auto b = stats.Track();
+    a->OnSent(100);
+    a->OnRttSample(microseconds(2000));
+    b->OnSent(300);
+    b->OnRttSample(microseconds(6000));
+
+    auto summary = stats.Collect();
+    EXPECT_EQ(summary.links, 2u);
+    EXPECT_EQ(summary.total.packetsSent, 2u);
+    EXPECT_EQ(summary.total.bytesSent, 400u);
+    EXPECT_EQ(summary.total.rtt, microseconds(4000));
+    EXPECT_EQ(summary.maxRtt, microseconds(6000));
+
+    // A gone link keeps counting in the totals but not in the RTT average
+    b.reset();
+    a->OnSent(1);
+    summary = stats.Collect();
+    EXPECT_EQ(summary.links, 1u);
+    EXPECT_EQ(summary.total.packetsSent, 3u);
+    EXPECT_EQ(summary.total.bytesSent, 401u);
+    EXPECT_EQ(summary.total.rtt, microseconds(2000));
+}
+
+TEST(TransportStats, LogEveryRateLimits)
+{
+    using namespace std::chrono_literals;
+    TransportStats stats;
+    const auto t0 = TransportStats::Clock::now();
+    EXPECT_TRUE(stats.LogEvery("test", 1s, t0));
+    EXPECT_FALSE(stats.LogEvery("test", 1s, t0 + 500ms));
+    EXPECT_TRUE(stats.LogEvery("test", 1s, t0 + 1s));
+}
+
+// ---------------------------------------------------------------------------
+// Packets — refcounted receive buffers
+// ---------------------------------------------------------------------------
+
+TEST(Packet, CopiesShareStorageAndSlice)
+{
+    const auto bytes = ToBytes("header:body");
+    auto packet = Packet::Copy(bytes);
+    EXPECT_NE(packet.Data(), bytes.data());
+    EXPECT_EQ(packet.Size(), bytes.size());
+
+    const auto copy = packet;
+    const auto body = copy.Slice(copy.Span().subspan(7));
+    packet = {};
+    EXPECT_TRUE(packet.Empty());
+
+    EXPECT_EQ(copy.Data(), body.Data() - 7);
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(body.Data()), body.Size()), "body"); //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+TEST(PacketPool, LastReleaseRecyclesTheSlab)
+{
+    auto pool = std::make_shared<PacketPool>(64, 4);
+
+    auto buf = pool->Acquire();
+    ASSERT_EQ(buf.Span().size(), 64u);
+    std::memcpy(buf.Span().data(), "abc", 3);
+    auto packet = std::move(buf).Publish(3);
+    const auto* slab = packet.Data();
+
+    auto kept = packet;
+    packet = {};
+    EXPECT_EQ(pool->GetStats().idle, 0u); // still referenced
+    kept = {};
+    EXPECT_EQ(pool->GetStats().idle, 1u);
+
+    // Reused, and an unpublished buffer goes straight back
+    {
+        auto again = pool->Acquire();
+        EXPECT_EQ(again.Span().data(), slab);
+    }
+    const auto stats = pool->GetStats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.idle, 1u);
+}
+
+TEST(PacketPool, PacketsMayOutliveThePool)
+{
+    auto pool = std::make_shared<PacketPool>(16, 4);
+    auto buf = pool->Acquire();
+    buf.Span()[0] = std::byte{7};
+    const auto packet = std::move(buf).Publish(1);
+    pool.reset();
+
+    EXPECT_EQ(packet.Span()[0], std::byte{7});
+}
+
+TEST(Packet, DeliverCopiesForOnPacket)
+{
+    const auto bytes = ToBytes("xyz");
+
+    Packet kept;
+    LinkHandler packets{.onPacket = [&kept](const Packet& p) { kept = p; }};
+    Deliver(packets, bytes);
+    EXPECT_NE(kept.Data(), bytes.data());
+    EXPECT_EQ(kept.Size(), 3u);
+
+    std::size_t received = 0;
+    LinkHandler spans{.onReceived = [&received](std::span<const std::byte> data) { received = data.size(); }};
+    Deliver(spans, bytes);
+    EXPECT_EQ(received, 3u);
+
+    struct Handler
+    {
+        std::size_t packets = 0;
+        void OnReceived(std::span<const std::byte>) {}
+        void OnDisconnected() {}
+        void OnPacket(const Packet&) { ++packets; }
+    };
+    Handler h;
+    Deliver(Bind(h), bytes);
+    EXPECT_EQ(h.packets, 1u);
+}
+
+TEST(Packet, DeliverAdoptsOwnedBytes)
+{
+    auto bytes = ToBytes("owned");
+    const auto* storage = bytes.data();
+
+    Packet kept;
+    LinkHandler packets{.onPacket = [&kept](const Packet& p) { kept = p; }};
+    Deliver(packets, std::move(bytes));
+    EXPECT_EQ(kept.Data(), storage);
+    EXPECT_EQ(kept.Size(), 5u);
+
+    // onReceived borrows them
+    std::size_t received = 0;
+    LinkHandler spans{.onReceived = [&received](std::span<const std::byte> data) { received = data.size(); }};
+    Deliver(spans, ToBytes("owned"));
+    EXPECT_EQ(received, 5u);
+}
+
+// ---------------------------------------------------------------------------
+// LinkEventQueue — events delivered where the queue is drained
+// ---------------------------------------------------------------------------
+
+TEST(LinkEventQueue, EventsWaitForDrainInOrder)
+{
+    auto queue = std::make_shared<LinkEventQueue>();
+    auto user = std::make_shared<TestAcceptor>();
+    auto acceptor = queue->Wrap(user);
+
+    auto link = std::make_shared<MockLink>(PeerId{.value = "A"}, PeerId{.value = "B"});
+    const auto handler = acceptor->OnLink(link);
+    Deliver(handler, ToBytes("one"));
+    Deliver(handler, ToBytes("two"));
+    handler.onWritable();
+    handler.onDisconnected();
+
+    EXPECT_TRUE(user->links.empty());
+    EXPECT_FALSE(queue->Empty());
+
+    EXPECT_EQ(queue->Drain(), 5u);
+    ASSERT_EQ(user->links.size(), 1u);
+    ASSERT_EQ(user->receivedPackets.size(), 2u);
+    EXPECT_EQ(user->receivedPackets[0], ToBytes("one"));
+    EXPECT_EQ(user->receivedPackets[1], ToBytes("two"));
+    EXPECT_EQ(user->writableEvents, 1u);
+    EXPECT_TRUE(user->disconnected);
+    EXPECT_TRUE(queue->Empty());
+}
+
+TEST(LinkEventQueue, WakesOnlyWhenEmpty)
+{
+    std::size_t wakes = 0;
+    auto queue = std::make_shared<LinkEventQueue>([&wakes](LinkEventQueue&) { ++wakes; });
+    auto user = std::make_shared<TestAcceptor>();
+    auto acceptor = queue->Wrap(user);
+
+    const auto handler = acceptor->OnLink(std::make_shared<MockLink>(PeerId{.value = "A"}, PeerId{.value = "B"}));
+    Deliver(handler, ToBytes("x"));
+    Deliver(handler, ToBytes("y"));
+    EXPECT_EQ(wakes, 1u);
+
+    queue->Drain();
+    Deliver(handler, ToBytes("z"));
+    EXPECT_EQ(wakes, 2u);
+}
+
+TEST(LinkEventQueue, ErrorsReachTheAcceptor)
+{
+    auto queue = std::make_shared<LinkEventQueue>();
+    auto user = std::make_shared<TestAcceptor>();
+    (void)queue->Wrap(user)->OnLink(std::unexpected(Error::TransportClosed));
+
+    queue->Drain();
+    EXPECT_TRUE(user->links.empty());
+    EXPECT_EQ(user->lastError, Error::TransportClosed);
+}
+
+TEST(LinkEventQueue, ManyProducersOneConsumer)
+{
+    constexpr int Producers = 4;
+    constexpr int PerProducer = 2000;
+
+    auto queue = std::make_shared<LinkEventQueue>();
+    struct Counter : ILinkAcceptor
+    {
+        LinkHandler OnLink(LinkResult) override
+        {
+            return {.onReceived = [this](std::span<const std::byte> data) {
+                const auto producer = std::to_integer<int>(data[0]);
+                int seq = 0;
+                std::memcpy(&seq, data.data() + 1, sizeof(seq));
+                inOrder = inOrder && seq == next[producer];
+                next[producer] = seq + 1;
+                ++received;
+            }};
+        }
+        int next[Producers]{};
+        int received = 0;
+        bool inOrder = true;
+    };
+    auto user = std::make_shared<Counter>();
+    const auto handler = queue->Wrap(user)->OnLink(std::make_shared<MockLink>(PeerId{.value = "A"}, PeerId{.value = "B"}));
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < Producers; ++p) {
+        threads.emplace_back([&handler, p] {
+            std::byte message[1 + sizeof(int)];
+            message[0] = static_cast<std::byte>(p);
+            for (int seq = 0; seq < PerProducer; ++seq) {
+                std::memcpy(message + 1, &seq, sizeof(seq));
+                Deliver(handler, message);
+            }
+        });
+    }
+    while (user->received < Producers * PerProducer) {
+        queue->Drain();
+        std::this_thread::yield();
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(user->received, Producers * PerProducer);
+    EXPECT_TRUE(user->inOrder);
+}
+
+// ---------------------------------------------------------------------------
+// SendScratch
+// ---------------------------------------------------------------------------
+
+TEST(SendScratch, ReusedAcrossScopesOnOneThread)
+{
+    std::byte* first = nullptr;
+    {
+        SendScratch scratch{64};
+        first = scratch.Span().data();
+        EXPECT_EQ(scratch.Span().size(), 64u);
+    }
+    SendScratch again{32};
+    EXPECT_EQ(again.Span().data(), first);
+    EXPECT_EQ(again.Span().size(), 32u);
+}
+
+// A writer that sends again from inside itself must not overwrite the outer message.
+TEST(SendScratch, NestedScopeGetsItsOwnBuffer)
+{
+    SendScratch outer{8};
+    std::memset(outer.Span().data(), 0xAB, 8);
+    {
+        SendScratch inner{8};
+        EXPECT_NE(inner.Span().data(), outer.Span().data());
+        std::memset(inner.Span().data(), 0xCD, 8);
+    }
+    EXPECT_EQ(outer.Span()[7], std::byte{0xAB});
+}
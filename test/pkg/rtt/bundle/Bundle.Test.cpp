@@ -0,0 +1,195 @@
+#include "Bundle/BundleProtocol.h"
+#include "Bundle/BundleTransport.h"
+#include "MockTransport.h"
+#include "TestAcceptor.h"
+#include "TestHelpers.h"
+
+#include <cstddef>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace Rtt;
+using namespace Rtt::Bundle;
+using namespace Rtt::Testing;
+
+namespace
+{
+    /// A BundleTransport over a MockTransport with one simulated link. Loop()
+    /// feeds what the link sent back into its own receive path.
+    struct BundleFixture
+    {
+        explicit BundleFixture(BundleTransport::Options options = {})
+        {
+            bundle = std::make_shared<BundleTransport>(mock, options);
+            bundle->Open(acceptor);
+            auto simulated = mock->SimulateLink(0, PeerId{"local"}, PeerId{"remote"});
+            inner = simulated.link;
+            innerHandler = std::move(simulated.handler);
+        }
+
+        BundleLink& Link() { return LinkAt<BundleLink>(*acceptor); }
+
+        std::vector<std::string> Loop()
+        {
+            for (const auto& packet : inner->SentPackets()) {
+                innerHandler.onReceived(packet);
+            }
+            std::vector<std::string> messages;
+            for (const auto& message : acceptor->receivedPackets) {
+                messages.push_back(FromBytes(message));
+            }
+            return messages;
+        }
+
+        std::shared_ptr<MockTransport> mock = std::make_shared<MockTransport>();
+        std::shared_ptr<TestAcceptor> acceptor = std::make_shared<TestAcceptor>();
+        std::shared_ptr<BundleTransport> bundle;
+        std::shared_ptr<MockLink> inner;
+        LinkHandler innerHandler;
+    };
+}
+
+// ===========================================================================
+// Protocol
+// ===========================================================================
+
+TEST(BundleProtocol, UnpacksSingleAndBundle)
+{
+    std::vector<std::string> messages;
+    const auto collect = [&](std::span<const std::byte> m) { messages.push_back(FromBytes(m)); };
+
+    const auto single = ToBytes("\x01hello");
+    EXPECT_TRUE(Protocol::Unpack(single, collect));
+
+    const auto bundle = ToBytes(std::string_view{"\x02\x00\x02hi\x00\x00\x00\x03you", 12});
+    EXPECT_TRUE(Protocol::Unpack(bundle, collect));
+
+    EXPECT_EQ(messages, (std::vector<std::string>{"hello", "hi", "", "you"}));
+}
+
+TEST(BundleProtocol, RejectsDamagedDatagrams)
+{
+    int calls = 0;
+    const auto count = [&](std::span<const std::byte>) { ++calls; };
+
+    EXPECT_FALSE(Protocol::Unpack({}, count));
+    EXPECT_FALSE(Protocol::Unpack(ToBytes("\x07x"), count));
+    // Second length runs past the end: the first message is still delivered
+    EXPECT_FALSE(Protocol::Unpack(ToBytes(std::string_view{"\x02\x00\x01" "a\x00\x09" "b", 7}), count));
+    EXPECT_EQ(calls, 1);
+}
+
+// ===========================================================================
+// BundleTransport
+// ===========================================================================
+
+TEST(BundleTransport, CoalescesUntilFlush)
+{
+    BundleFixture f;
+    SendText(f.Link(), "one");
+    SendText(f.Link(), "two");
+    const auto three = ToBytes("three");
+    const std::span<const std::byte> parts[] = {three};
+    f.Link().SendV(parts);
+
+    EXPECT_TRUE(f.inner->SentPackets().empty());
+    EXPECT_EQ(f.Link().OutstandingBytes(), 1u + 3 * 2 + 3 + 3 + 5);
+
+    f.bundle->Flush();
+    ASSERT_EQ(f.inner->SentPackets().size(), 1u);
+    EXPECT_EQ(f.Link().OutstandingBytes(), 0u);
+    EXPECT_EQ(f.Loop(), (std::vector<std::string>{"one", "two", "three"}));
+
+    // Nothing pending: a second flush sends nothing
+    f.bundle->Flush();
+    EXPECT_EQ(f.inner->SentPackets().size(), 1u);
+}
+
+TEST(BundleTransport, LoneMessageGoesOutSingle)
+{
+    BundleFixture f;
+    SendText(f.Link(), "solo");
+    f.bundle->Flush();
+
+    ASSERT_EQ(f.inner->SentPackets().size(), 1u);
+    EXPECT_EQ(f.inner->SentPackets()[0].size(), 1u + 4);
+    EXPECT_EQ(f.Loop(), (std::vector<std::string>{"solo"}));
+}
+
+TEST(BundleTransport, FullBundleIsSentBeforeFlush)
+{
+    // 1 + 2 * (2 + 10) = 25 bytes fit, a third message does not
+    BundleFixture f{{.maxDatagramSize = 32}};
+    SendText(f.Link(), "aaaaaaaaaa");
+    SendText(f.Link(), "bbbbbbbbbb");
+    EXPECT_TRUE(f.inner->SentPackets().empty());
+    SendText(f.Link(), "cccccccccc");
+    ASSERT_EQ(f.inner->SentPackets().size(), 1u);
+    EXPECT_EQ(f.inner->SentPackets()[0].size(), 25u);
+
+    f.bundle->Flush();
+    EXPECT_EQ(f.Loop(), (std::vector<std::string>{"aaaaaaaaaa", "bbbbbbbbbb", "cccccccccc"}));
+}
+
+TEST(BundleTransport, OversizedMessageGoesAloneInOrder)
+{
+    BundleFixture f{{.maxDatagramSize = 32}};
+    SendText(f.Link(), "small");
+    const auto big = ToBytes(std::string(100, 'x'));
+    const std::span<const std::byte> parts[] = {big};
+    f.Link().SendV(parts);
+
+    ASSERT_EQ(f.inner->SentPackets().size(), 2u);
+    EXPECT_EQ(f.Loop(), (std::vector<std::string>{"small", std::string(100, 'x')}));
+}
+
+TEST(BundleTransport, BundlingCanBeTurnedOffPerLink)
+{
+    BundleFixture f;
+    SendText(f.Link(), "queued");
+    f.Link().SetBundling(false);
+    ASSERT_EQ(f.inner->SentPackets().size(), 1u);
+
+    SendText(f.Link(), "direct");
+    EXPECT_EQ(f.inner->SentPackets().size(), 2u);
+    EXPECT_EQ(f.Loop(), (std::vector<std::string>{"queued", "direct"}));
+}
+
+TEST(BundleTransport, DisconnectSendsPendingBundle)
+{
+    BundleFixture f;
+    SendText(f.Link(), "bye");
+    f.Link().Disconnect();
+
+    EXPECT_TRUE(f.inner->WasDisconnected());
+    EXPECT_EQ(f.Loop(), (std::vector<std::string>{"bye"}));
+
+    SendText(f.Link(), "late");
+    f.bundle->Flush();
+    EXPECT_EQ(f.inner->SentPackets().size(), 1u);
+}
+
+TEST(BundleTransport, SendWhenWritableWaitsForInnerLink)
+{
+    BundleFixture f;
+    f.inner->SetWritable(false);
+
+    f.Link().SendWhenWritable([](std::span<std::byte> out) -> std::size_t {
+        std::memcpy(out.data(), "late", 4);
+        return 4;
+    });
+    f.bundle->Flush();
+    EXPECT_TRUE(f.inner->SentPackets().empty());
+    EXPECT_EQ(f.inner->DroppedSends(), 0u);
+
+    f.inner->SetWritable(true);
+    f.innerHandler.onWritable();
+    f.bundle->Flush();
+    EXPECT_EQ(f.Loop(), (std::vector<std::string>{"late"}));
+    EXPECT_EQ(f.acceptor->writableEvents, 1u);
+}
@@ -0,0 +1,286 @@
+#include "Exec/Delay/LoopTimerBackend.h"
+#include "MockTransport.h"
+#include "Pace/PacedTransport.h"
+#include "Pace/TokenBucket.h"
+#include "TestAcceptor.h"
+#include "TestHelpers.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace Rtt;
+using namespace Rtt::Pace;
+using namespace Rtt::Testing;
+using namespace std::chrono_literals;
+
+// ===========================================================================
+// TokenBucket
+// ===========================================================================
+
+TEST(TokenBucket, BurstThenDebt)
+{
+    const auto t0 = TokenBucket::Clock::now();
+    TokenBucket bucket(1000, 500, t0);
+
+    EXPECT_TRUE(bucket.Ready(t0));
+    bucket.Consume(500, t0);
+    EXPECT_TRUE(bucket.Ready(t0)); // balance 0 is not debt
+    bucket.Consume(250, t0);
+    EXPECT_FALSE(bucket.Ready(t0));
+
+    // 250 bytes of debt at 1000 B/s
+    EXPECT_EQ(bucket.ReadyAt(t0), t0 + 250ms);
+    EXPECT_FALSE(bucket.Ready(t0 + 249ms));
+    EXPECT_TRUE(bucket.Ready(t0 + 250ms));
+}
+
+TEST(TokenBucket, RefillIsCappedAtBurst)
+{
+    const auto t0 = TokenBucket::Clock::now();
+    TokenBucket bucket(1000, 100, t0);
+
+    // An hour idle still only buys one burst
+    bucket.Consume(100, t0 + 1h);
+    EXPECT_TRUE(bucket.Ready(t0 + 1h));
+    bucket.Consume(1, t0 + 1h);
+    EXPECT_FALSE(bucket.Ready(t0 + 1h));
+}
+
+TEST(TokenBucket, ZeroRateIsUnlimited)
+{
+    const auto t0 = TokenBucket::Clock::now();
+    TokenBucket bucket(0, 0, t0);
+
+    EXPECT_TRUE(bucket.Unlimited());
+    bucket.Consume(1'000'000, t0);
+    EXPECT_TRUE(bucket.Ready(t0));
+    EXPECT_EQ(bucket.ReadyAt(t0), t0);
+}
+
+// ===========================================================================
+// PacedTransport
+// ===========================================================================
+
+namespace
+{
+    /// A PacedTransport over a MockTransport with `count` simulated links.
+    /// Timers run on a LoopTimerBackend ticked by Drive().
+    struct PaceFixture
+    {
+        explicit PaceFixture(PacedTransport::Options options, std::size_t count = 1)
+        {
+            options.timers = &timers;
+            paced = std::make_shared<PacedTransport>(mock, options);
+            paced->Open(acceptor);
+            for (std::size_t i = 0; i < count; ++i) {
+                auto simulated = mock->SimulateLink(0, PeerId{"local"}, PeerId{"remote" + std::to_string(i)});
+                inner.push_back(simulated.link);
+                innerHandlers.push_back(std::move(simulated.handler));
+            }
+        }
+
+        /// Tick timers until `pred` holds or `limit` passes.
+        bool Drive(auto pred, std::chrono::milliseconds limit = 2s)
+        {
+            return DriveUntil([this] { timers.Tick(); }, pred, limit);
+        }
+
+        PacedLink& Link(std::size_t i = 0) { return LinkAt<PacedLink>(*acceptor, i); }
+
+        Exec::LoopTimerBackend timers;
+        std::shared_ptr<MockTransport> mock = std::make_shared<MockTransport>();
+        std::shared_ptr<TestAcceptor> acceptor = std::make_shared<TestAcceptor>();
+        std::shared_ptr<PacedTransport> paced;
+        std::vector<std::shared_ptr<MockLink>> inner;
+        std::vector<LinkHandler> innerHandlers;
+    };
+
+    /// Send `size` bytes of `value`; counts writer calls in `calls` if given.
+    void SendFill(ILink& link, std::size_t size, std::byte value, int* calls = nullptr)
+    {
+        link.Send([size, value, calls](std::span<std::byte> out) {
+            if (calls) {
+                ++*calls;
+            }
+            const auto n = std::min(size, out.size());
+            std::fill_n(out.begin(), n, value);
+            return n;
+        });
+    }
+}
+
+TEST(PacedTransport, PassesThroughWithinBudget)
+{
+    PaceFixture f({.rate = 100'000, .burst = 4096});
+
+    SendFill(f.Link(), 1000, std::byte{1});
+    SendFill(f.Link(), 1000, std::byte{2});
+
+    ASSERT_EQ(f.inner[0]->SentPackets().size(), 2u);
+    EXPECT_EQ(f.inner[0]->SentPackets()[1].size(), 1000u);
+    EXPECT_EQ(f.inner[0]->SentPackets()[1][0], std::byte{2});
+
+    const auto stats = f.Link().GetPacingStats();
+    EXPECT_EQ(stats.sent, 2u);
+    EXPECT_EQ(stats.queued, 0u);
+    EXPECT_EQ(stats.dropped, 0u);
+}
+
+TEST(PacedTransport, QueuesOverBudgetAndDrainsInOrder)
+{
+    PaceFixture f({.rate = 20'000, .burst = 1000, .overLimit = OverLimit::Queue});
+
+    // 500 + 500 empty the bucket, the third goes into debt, the rest wait
+    for (int i = 0; i < 6; ++i) {
+        SendFill(f.Link(), 500, static_cast<std::byte>(i));
+    }
+    EXPECT_EQ(f.inner[0]->SentPackets().size(), 3u);
+    EXPECT_EQ(f.Link().GetPacingStats().queueDepth, 3u);
+
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(f.Drive([&] { return f.inner[0]->SentPackets().size() == 6; }));
+    // 1500 bytes of debt plus backlog at 20 KB/s cannot clear in under ~75 ms
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 70ms);
+
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_EQ(f.inner[0]->SentPackets()[i][0], static_cast<std::byte>(i));
+    }
+    const auto stats = f.Link().GetPacingStats();
+    EXPECT_EQ(stats.sent, 6u);
+    EXPECT_EQ(stats.queued, 3u);
+    EXPECT_EQ(stats.dropped, 0u);
+    EXPECT_EQ(stats.queueDepth, 0u);
+}
+
+TEST(PacedTransport, DropPolicySkipsTheWriter)
+{
+    PaceFixture f({.rate = 1000, .burst = 1000, .overLimit = OverLimit::Drop});
+
+    int calls = 0;
+    for (int i = 0; i < 5; ++i) {
+        SendFill(f.Link(), 600, std::byte{1}, &calls);
+    }
+
+    EXPECT_EQ(f.inner[0]->SentPackets().size(), 2u);
+    EXPECT_EQ(calls, 2);
+    const auto stats = f.Link().GetPacingStats();
+    EXPECT_EQ(stats.sent, 2u);
+    EXPECT_EQ(stats.dropped, 3u);
+    EXPECT_EQ(stats.queued, 0u);
+}
+
+TEST(PacedTransport, FullQueueDrops)
+{
+    PaceFixture f({.rate = 1000, .burst = 100, .maxQueued = 2});
+
+    for (int i = 0; i < 5; ++i) {
+        SendFill(f.Link(), 200, std::byte{1});
+    }
+
+    const auto stats = f.Link().GetPacingStats();
+    EXPECT_EQ(stats.sent, 1u);
+    EXPECT_EQ(stats.queued, 2u);
+    EXPECT_EQ(stats.dropped, 2u);
+    EXPECT_EQ(stats.queueDepth, 2u);
+}
+
+TEST(PacedTransport, TransportBucketIsShared)
+{
+    PaceFixture f({.transportRate = 20'000, .transportBurst = 1000}, 2);
+
+    // Link 0 spends the shared budget, so link 1 waits although its own bucket is unlimited
+    SendFill(f.Link(0), 1000, std::byte{1});
+    SendFill(f.Link(0), 500, std::byte{1});
+    SendFill(f.Link(1), 100, std::byte{2});
+    EXPECT_EQ(f.inner[0]->SentPackets().size(), 2u);
+    EXPECT_TRUE(f.inner[1]->SentPackets().empty());
+
+    ASSERT_TRUE(f.Drive([&] { return f.inner[1]->SentPackets().size() == 1; }));
+
+    const auto total = f.paced->GetPacingStats();
+    EXPECT_EQ(total.sent, 3u);
+    EXPECT_EQ(total.queued, 1u);
+    EXPECT_EQ(total.dropped, 0u);
+    EXPECT_EQ(total.queueDepth, 0u);
+}
+
+TEST(PacedTransport, DisconnectDiscardsQueue)
+{
+    PaceFixture f({.rate = 1000, .burst = 100});
+
+    SendFill(f.Link(), 200, std::byte{1});
+    SendFill(f.Link(), 200, std::byte{2});
+    EXPECT_EQ(f.paced->GetPacingStats().queueDepth, 1u);
+
+    f.Link().Disconnect();
+    EXPECT_TRUE(f.inner[0]->WasDisconnected());
+    EXPECT_EQ(f.paced->GetPacingStats().queueDepth, 0u);
+
+    // Sends after Disconnect go nowhere
+    SendFill(f.Link(), 10, std::byte{3});
+    EXPECT_EQ(f.inner[0]->SentPackets().size(), 1u);
+}
+
+TEST(PacedTransport, BlockedInnerLinkHoldsTheQueue)
+{
+    PaceFixture f({.rate = 100'000, .burst = 4096});
+    f.inner[0]->SetWritable(false);
+
+    // Within budget, but the inner link would drop them: they wait instead
+    for (int i = 0; i < 3; ++i) {
+        SendFill(f.Link(), 100, static_cast<std::byte>(i));
+    }
+    int calls = 0;
+    f.Link().SendWhenWritable([&calls](std::span<std::byte> out) {
+        ++calls;
+        out[0] = std::byte{3};
+        return std::size_t{1};
+    });
+    EXPECT_FALSE(f.Drive([&] { return !f.inner[0]->SentPackets().empty(); }, 20ms));
+    EXPECT_EQ(f.inner[0]->DroppedSends(), 0u);
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(f.Link().GetPacingStats().sent, 0u);
+    EXPECT_EQ(f.Link().GetPacingStats().queueDepth, 3u);
+
+    // The inner link's onWritable resumes the queue, then the deferred writer
+    f.inner[0]->SetWritable(true);
+    f.innerHandlers[0].onWritable();
+
+    ASSERT_EQ(f.inner[0]->SentPackets().size(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(f.inner[0]->SentPackets()[i][0], static_cast<std::byte>(i));
+    }
+    const auto stats = f.Link().GetPacingStats();
+    EXPECT_EQ(stats.sent, 4u);
+    EXPECT_EQ(stats.queueDepth, 0u);
+    EXPECT_EQ(f.acceptor->writableEvents, 1u);
+}
+
+TEST(PacedTransport, OversizedSendVIsDroppedUncharged)
+{
+    PaceFixture f({.rate = 1000, .burst = 100, .maxMessageSize = 100});
+
+    // Over maxMessageSize: dropped up front, neither queued nor charged
+    const std::vector<std::byte> big(200, std::byte{1});
+    const std::span<const std::byte> parts[] = {big};
+    f.Link().SendV(parts);
+    f.Link().SendV(parts);
+
+    auto stats = f.Link().GetPacingStats();
+    EXPECT_EQ(stats.dropped, 2u);
+    EXPECT_EQ(stats.queueDepth, 0u);
+    EXPECT_TRUE(f.inner[0]->SentPackets().empty());
+
+    // The burst is intact, so a message that fits goes straight out
+    SendFill(f.Link(), 100, std::byte{2});
+    ASSERT_EQ(f.inner[0]->SentPackets().size(), 1u);
+    stats = f.Link().GetPacingStats();
+    EXPECT_EQ(stats.sent, 1u);
+    EXPECT_EQ(stats.queued, 0u);
+}
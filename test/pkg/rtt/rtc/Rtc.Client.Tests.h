@@ -153,7 +153,8 @@ protected:
     /// ICE servers; override to add STUN when testing through NAT.
     virtual std::vector<std::string> iceServers() { return {}; }
 
-    void openClientServer()
+    void openClientServer(std::vector<RtcChannelOptions> channels = {RtcChannelOptions{}},
+                          std::size_t maxBufferedAmount = 0)
     {
         // Unique per-process token (from random_device) combined with a
         // per-process counter ensures peer IDs are globally unique across
@@ -172,12 +173,16 @@ protected:
             .sigClient = makeSigClient(),
             .localId = _serverId,
             .iceServers = iceServers(),
+            .maxBufferedAmount = maxBufferedAmount,
+            .channels = channels,
         });
         client = RtcClient::MakeDefault(RtcClient::Options{
             .sigClient = makeSigClient(),
             .localId = _clientId,
             .remoteId = _serverId,
             .iceServers = iceServers(),
+            .maxBufferedAmount = maxBufferedAmount,
+            .channels = channels,
         });
         server->Open(serverAcceptor);
         client->Open(clientAcceptor);
@@ -263,6 +268,59 @@ protected:
         EXPECT_EQ(fromBytes(clientAcceptor->lastPacket), "server->client");
     }
 
+    void runTest_Send_UnreliableChannel()
+    {
+        // Channel 0 reliable and ordered, channel 1 datagram-like
+        openClientServer({RtcChannelOptions{}, RtcChannelOptions{.unordered = true, .maxRetransmits = 0}});
+
+        ASSERT_TRUE(awaitFlag(clientAcceptor->linkReady));
+        ASSERT_TRUE(awaitFlag(serverAcceptor->linkReady));
+        EXPECT_EQ(clientAcceptor->link->ChannelCount(), 2u);
+        EXPECT_EQ(serverAcceptor->link->ChannelCount(), 2u);
+
+        const auto expected = toBytes("state");
+        serverAcceptor->link->Send(1, [&](std::span<std::byte> buf) {
+            std::memcpy(buf.data(), expected.data(), expected.size());
+            return expected.size();
+        });
+
+        // No loss on loopback
+        ASSERT_TRUE(awaitFlag(clientAcceptor->packetReceived));
+        EXPECT_EQ(fromBytes(clientAcceptor->lastPacket), "state");
+    }
+
+    void runTest_Backpressure_ManyChannels()
+    {
+        // With three channels sharing the limit, none may need to reach half
+        // of it for the link to become writable again
+        constexpr std::size_t Limit = 64 * 1024;
+        constexpr std::size_t MessageSize = 8 * 1024;
+        openClientServer({RtcChannelOptions{}, RtcChannelOptions{}, RtcChannelOptions{}}, Limit);
+
+        ASSERT_TRUE(awaitFlag(clientAcceptor->linkReady));
+        ASSERT_TRUE(awaitFlag(serverAcceptor->linkReady));
+        auto& link = *clientAcceptor->link;
+        ASSERT_EQ(link.ChannelCount(), 3u);
+
+        // Spread the load evenly so no single channel holds half of the limit
+        const auto fill = [](std::span<std::byte> buf) {
+            std::memset(buf.data(), 'x', MessageSize);
+            return MessageSize;
+        };
+        for (int i = 0; i < 10'000 && link.Writable(); ++i) {
+            link.Send(static_cast<ChannelId>(i % 3), fill);
+        }
+        ASSERT_FALSE(link.Writable());
+
+        std::atomic<bool> deferredRan{false};
+        link.SendWhenWritable([&deferredRan](std::span<std::byte> buf) {
+            deferredRan = true;
+            std::memcpy(buf.data(), "last", 4);
+            return std::size_t{4};
+        });
+        ASSERT_TRUE(awaitFlag(deferredRan));
+    }
+
     void runTest_Disconnect_ClientSide()
     {
         openClientServer();
@@ -63,3 +63,15 @@ TEST_F(RtcLocalSigTest, Disconnect_ClientSide)
 {
     runTest_Disconnect_ClientSide();
 }
+
+#if !defined(__EMSCRIPTEN__) // JsRtcTransport opens channel 0 only
+TEST_F(RtcLocalSigTest, Send_UnreliableChannel)
+{
+    runTest_Send_UnreliableChannel();
+}
+
+TEST_F(RtcLocalSigTest, Backpressure_ManyChannels)
+{
+    runTest_Backpressure_ManyChannels();
+}
+#endif
@@ -0,0 +1,120 @@
+#pragma once
+#include "Rtt/Transport.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <span>
+#include <utility>
+
+namespace Rtt::Testing
+{
+    /// Shared loss settings of a LossyTransport; may be changed while running.
+    struct LossConfig
+    {
+        /// Probability of dropping each outbound datagram, 0..1.
+        std::atomic<double> dropRate{0.0};
+
+        std::atomic<std::uint64_t> sent{0};
+        std::atomic<std::uint64_t> dropped{0};
+
+        std::mutex rngMutex;
+        std::minstd_rand rng{12345}; // fixed seed: reproducible loss patterns
+
+        bool ShouldDrop()
+        {
+            ++sent;
+            const double rate = dropRate.load();
+            if (rate <= 0.0) {
+                return false;
+            }
+            std::lock_guard lock{rngMutex};
+            if (std::uniform_real_distribution<double>{0.0, 1.0}(rng) < rate) {
+                ++dropped;
+                return true;
+            }
+            return false;
+        }
+    };
+
+    /// Link decorator that randomly drops outbound datagrams.
+    class LossyLink : public ILink
+    {
+    public:
+        LossyLink(std::shared_ptr<ILink> inner, std::shared_ptr<LossConfig> loss)
+            : _inner(std::move(inner))
+            , _loss(std::move(loss))
+        {}
+
+        const PeerId& LocalId() const override { return _inner->LocalId(); }
+        const PeerId& RemoteId() const override { return _inner->RemoteId(); }
+
+        void Send(WriteCallback writer) override
+        {
+            if (!_loss->ShouldDrop()) {
+                _inner->Send(std::move(writer));
+            }
+        }
+
+        void SendV(ConstBufferSequence buffers) override
+        {
+            if (!_loss->ShouldDrop()) {
+                _inner->SendV(buffers);
+            }
+        }
+
+        void Disconnect() override { _inner->Disconnect(); }
+
+        LinkStats GetStats() const override { return _inner->GetStats(); }
+        bool Writable() const override { return _inner->Writable(); }
+        std::size_t OutstandingBytes() const override { return _inner->OutstandingBytes(); }
+
+    private:
+        std::shared_ptr<ILink> _inner;
+        std::shared_ptr<LossConfig> _loss;
+    };
+
+    /// Transport decorator that wraps every link in a LossyLink: a loss-injection
+    /// harness for protocols layered over real (loopback) transports.
+    class LossyTransport : public ITransport
+    {
+    public:
+        LossyTransport(std::shared_ptr<ITransport> inner, std::shared_ptr<LossConfig> loss)
+            : _inner(std::move(inner))
+            , _loss(std::move(loss))
+        {}
+
+        void Open(std::shared_ptr<ILinkAcceptor> acceptor) override
+        {
+            _inner->Open(std::make_shared<Acceptor>(std::move(acceptor), _loss));
+        }
+
+    private:
+        class Acceptor : public ILinkAcceptor
+        {
+        public:
+            Acceptor(std::shared_ptr<ILinkAcceptor> user, std::shared_ptr<LossConfig> loss)
+                : _user(std::move(user))
+                , _loss(std::move(loss))
+            {}
+
+            LinkHandler OnLink(LinkResult result) override
+            {
+                if (!result) {
+                    return _user->OnLink(std::move(result));
+                }
+                return _user->OnLink(std::make_shared<LossyLink>(std::move(*result), _loss));
+            }
+
+        private:
+            std::shared_ptr<ILinkAcceptor> _user;
+            std::shared_ptr<LossConfig> _loss;
+        };
+
+        std::shared_ptr<ITransport> _inner;
+        std::shared_ptr<LossConfig> _loss;
+    };
+}
@@ -11,6 +11,8 @@ namespace Rtt::Testing
     ///
     /// Captures Send writers and tracks Disconnect calls so tests can
     /// verify the full send/disconnect flow without a real transport.
+    /// SetWritable(false) simulates backpressure: sends are dropped, without
+    /// calling the writer, until it is set back.
     class MockLink : public ILink
     {
     public:
@@ -24,6 +26,10 @@ namespace Rtt::Testing
 
         void Send(WriteCallback writer) override
         {
+            if (!_writable) {
+                ++_droppedSends;
+                return;
+            }
             // Provide a scratch buffer for the writer, mimicking a transport
             // handing out a packet buffer.
             std::vector<std::byte> buf(_sendBufferSize);
@@ -34,10 +40,15 @@ namespace Rtt::Testing
 
         void Disconnect() override { _disconnected = true; }
 
+        [[nodiscard]] bool Writable() const override { return _writable; }
+
         // --- Test accessors ---
 
         [[nodiscard]] const std::vector<std::vector<std::byte>>& SentPackets() const { return _sentPackets; }
         [[nodiscard]] bool WasDisconnected() const { return _disconnected; }
+        [[nodiscard]] std::size_t DroppedSends() const { return _droppedSends; }
+
+        void SetWritable(bool writable) { _writable = writable; }
 
         void SetSendBufferSize(std::size_t size) { _sendBufferSize = size; }
 
@@ -46,6 +57,8 @@ namespace Rtt::Testing
         PeerId _remote;
         std::vector<std::vector<std::byte>> _sentPackets;
         bool _disconnected = false;
+        bool _writable = true;
+        std::size_t _droppedSends = 0;
         std::size_t _sendBufferSize = 1024;
     };
 
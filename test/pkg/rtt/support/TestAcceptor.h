@@ -9,7 +9,7 @@
 namespace Rtt::Testing
 {
     /// Reusable test acceptor that records delivered links, errors, received
-    /// packets, and disconnect notifications.
+    /// packets, disconnect and writable notifications.
     class TestAcceptor : public ILinkAcceptor
     {
     public:
@@ -28,6 +28,9 @@ namespace Rtt::Testing
                 .onDisconnected = [this]() {
                     disconnected = true;
                 },
+                .onWritable = [this]() {
+                    ++writableEvents;
+                },
             };
         }
 
@@ -36,5 +39,6 @@ namespace Rtt::Testing
 
         std::vector<std::vector<std::byte>> receivedPackets;
         bool disconnected = false;
+        std::size_t writableEvents = 0;
     };
 }
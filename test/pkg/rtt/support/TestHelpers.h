@@ -0,0 +1,67 @@
+#pragma once
+#include "Rtt/Link.h"
+#include "TestAcceptor.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Rtt::Testing
+{
+    inline std::vector<std::byte> ToBytes(std::string_view sv)
+    {
+        std::vector<std::byte> buf(sv.size());
+        std::memcpy(buf.data(), sv.data(), sv.size());
+        return buf;
+    }
+
+    inline std::string FromBytes(std::span<const std::byte> data)
+    {
+        return {
+            reinterpret_cast<const char*>(data.data()), data.size() //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        };
+    }
+
+    /// Send `text` as one message on `channel`.
+    inline void SendText(ILink& link, ChannelId channel, std::string_view text)
+    {
+        link.Send(channel, [text](std::span<std::byte> out) -> std::size_t {
+            std::memcpy(out.data(), text.data(), text.size());
+            return text.size();
+        });
+    }
+
+    /// Send `text` as one message with Send(writer).
+    inline void SendText(ILink& link, std::string_view text)
+    {
+        link.Send([text](std::span<std::byte> out) -> std::size_t {
+            std::memcpy(out.data(), text.data(), text.size());
+            return text.size();
+        });
+    }
+
+    /// The i-th link handed to `acceptor`, as the link type the transport produces.
+    template <typename Link>
+    Link& LinkAt(const TestAcceptor& acceptor, std::size_t index = 0)
+    {
+        return static_cast<Link&>(*acceptor.links.at(index));
+    }
+
+    /// Call `tick` (polling an io_context, ticking a LoopTimerBackend, …) until
+    /// `predicate` holds or `limit` passes. Returns whether it holds.
+    template <typename Tick, typename Predicate>
+    bool DriveUntil(Tick&& tick, Predicate&& predicate, std::chrono::milliseconds limit)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + limit;
+        while (!predicate() && std::chrono::steady_clock::now() < deadline) {
+            tick();
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        return predicate();
+    }
+}
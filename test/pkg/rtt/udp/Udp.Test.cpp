@@ -1,14 +1,23 @@
 #include "TestAcceptor.h"
+#include "TestHelpers.h"
 #include "Udp/UdpClient.h"
+#include "Udp/UdpHandshake.h"
 #include "Udp/UdpServer.h"
 
+#include <array>
 #include <boost/asio.hpp>
+#include <chrono>
 #include <cstddef>
 #include <cstring>
 #include <gtest/gtest.h>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <span>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace asio = boost::asio;
@@ -23,20 +32,6 @@ using namespace Rtt::Udp;
 
 namespace
 {
-    std::vector<std::byte> ToBytes(std::string_view sv)
-    {
-        std::vector<std::byte> buf(sv.size());
-        std::memcpy(buf.data(), sv.data(), sv.size());
-        return buf;
-    }
-
-    std::string FromBytes(std::span<const std::byte> data)
-    {
-        return {
-            reinterpret_cast<const char*>(data.data()), data.size() //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
-        };
-    }
-
     /// Run io_context until a predicate is satisfied, with a safety timeout.
     void RunUntil(asio::io_context& io, auto predicate)
     {
@@ -54,6 +49,127 @@ namespace
         timeout.cancel();
         io.restart();
     }
+
+    /// Poll io_context until a predicate is satisfied by work running on other threads.
+    void PollUntil(asio::io_context& io, auto predicate)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!predicate() && std::chrono::steady_clock::now() < deadline) {
+            io.poll();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        io.restart();
+    }
+
+    /// Thread-safe acceptor for sharded servers: OnLink runs on shard threads.
+    class SharedAcceptor : public ILinkAcceptor
+    {
+    public:
+        LinkHandler OnLink(LinkResult result) override
+        {
+            std::lock_guard lock{mutex};
+            if (result.has_value()) {
+                links.push_back(*result);
+                threads.insert(std::this_thread::get_id());
+            }
+            return LinkHandler{
+                .onReceived = [this](std::span<const std::byte>) {
+                    std::lock_guard lock{mutex};
+                    ++received;
+                },
+                .onDisconnected = [this] {
+                    std::lock_guard lock{mutex};
+                    ++disconnected;
+                },
+            };
+        }
+
+        std::size_t Received()
+        {
+            std::lock_guard lock{mutex};
+            return received;
+        }
+
+        std::mutex mutex;
+        std::vector<std::shared_ptr<ILink>> links;
+        std::set<std::thread::id> threads;
+        std::size_t received = 0;
+        std::size_t disconnected = 0;
+    };
+
+    /// Sharded server acceptor that echoes every message back from the shard thread.
+    class EchoAcceptor : public ILinkAcceptor
+    {
+    public:
+        LinkHandler OnLink(LinkResult result) override
+        {
+            if (!result.has_value()) {
+                return {};
+            }
+            std::lock_guard lock{mutex};
+            links.push_back(*result);
+            return LinkHandler{
+                .onReceived = [link = result->get()](std::span<const std::byte> data) {
+                    const std::span<const std::byte> parts[] = {data};
+                    link->SendV(parts);
+                },
+                .onDisconnected = {},
+            };
+        }
+
+        std::shared_ptr<ILink> Link()
+        {
+            std::lock_guard lock{mutex};
+            return links.empty() ? nullptr : links.front();
+        }
+
+        std::mutex mutex;
+        std::vector<std::shared_ptr<ILink>> links;
+    };
+
+    /// Records which server links were disconnected, by remote id.
+    class EvictionAcceptor : public ILinkAcceptor
+    {
+    public:
+        LinkHandler OnLink(LinkResult result) override
+        {
+            if (!result.has_value()) {
+                return {};
+            }
+            links.push_back(*result);
+            return LinkHandler{
+                .onReceived = [this](std::span<const std::byte>) { ++received; },
+                .onDisconnected = [this, link = result->get()] { disconnected.insert(link->RemoteId()); },
+            };
+        }
+
+        std::vector<std::shared_ptr<ILink>> links;
+        std::set<PeerId> disconnected;
+        std::size_t received = 0;
+    };
+
+    /// Open a UdpClient to `port` and drive `io` until its link exists.
+    std::shared_ptr<ILink> ConnectClient(asio::io_context& io, std::uint16_t port,
+                                         std::vector<std::shared_ptr<TestAcceptor>>& keepAlive,
+                                         std::vector<std::unique_ptr<UdpClient>>& clients)
+    {
+        auto acceptor = keepAlive.emplace_back(std::make_shared<TestAcceptor>());
+        auto& client = clients.emplace_back(std::make_unique<UdpClient>(UdpClient::Options{
+            .executor = io.get_executor(),
+            .remoteHost = "127.0.0.1",
+            .remotePort = port,
+        }));
+        client->Open(acceptor);
+        RunUntil(io, [&] { return acceptor->links.size() == 1; });
+        return acceptor->links.at(0);
+    }
+
+    /// Keep the io_context running for `duration`.
+    void RunFor(asio::io_context& io, std::chrono::milliseconds duration)
+    {
+        io.run_for(duration);
+        io.restart();
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -269,3 +385,666 @@ TEST(UdpTransport, ClientDisconnect)
     // The client's disconnect callback should fire
     EXPECT_TRUE(clientAcceptor->disconnected);
 }
+
+TEST(UdpTransport, SendPoolRecyclesBuffers)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<TestAcceptor>();
+    UdpServer server{{.executor = io.get_executor(), .localPort = 0}};
+    server.Open(serverAcceptor);
+
+    auto clientAcceptor = std::make_shared<TestAcceptor>();
+    UdpClient client{{
+        .executor = io.get_executor(),
+        .remoteHost = "127.0.0.1",
+        .remotePort = server.LocalPort(),
+    }};
+    client.Open(clientAcceptor);
+
+    RunUntil(io, [&] { return clientAcceptor->links.size() == 1; });
+    auto& clientLink = clientAcceptor->links[0];
+
+    // Sequential sends: each completion returns its slab before the next send
+    constexpr auto sends = 4;
+    auto payload = ToBytes("pooled");
+    for (auto i = 0; i < sends; ++i) {
+        clientLink->Send([&](std::span<std::byte> buf) -> std::size_t {
+            std::memcpy(buf.data(), payload.data(), payload.size());
+            return payload.size();
+        });
+        RunUntil(io, [&] { return serverAcceptor->receivedPackets.size() == static_cast<std::size_t>(i + 1); });
+    }
+
+    ASSERT_EQ(serverAcceptor->receivedPackets.size(), sends);
+    EXPECT_EQ(FromBytes(serverAcceptor->receivedPackets.back()), "pooled");
+
+    auto stats = client.GetSendPoolStats();
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.hits, sends - 1);
+    EXPECT_EQ(stats.idle, 1);
+}
+
+TEST(UdpTransport, OutstandingBytesLimitDefersWriters)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<TestAcceptor>();
+    UdpServer server{{.executor = io.get_executor(), .localPort = 0}};
+    server.Open(serverAcceptor);
+
+    // Send() completes asynchronously: bytes stay outstanding until io runs
+    auto clientAcceptor = std::make_shared<TestAcceptor>();
+    UdpClient client{{
+        .executor = io.get_executor(),
+        .remoteHost = "127.0.0.1",
+        .remotePort = server.LocalPort(),
+        .maxOutstandingBytes = 200,
+    }};
+    client.Open(clientAcceptor);
+
+    RunUntil(io, [&] { return clientAcceptor->links.size() == 1; });
+    auto& clientLink = clientAcceptor->links[0];
+
+    const auto fill = [](std::span<std::byte> buf) -> std::size_t {
+        std::memset(buf.data(), 'x', 100);
+        return 100;
+    };
+    EXPECT_EQ(clientLink->TrySend(fill), SendStatus::Sent);
+    EXPECT_TRUE(clientLink->Writable());
+    clientLink->Send(fill);
+    EXPECT_FALSE(clientLink->Writable());
+    EXPECT_EQ(clientLink->OutstandingBytes(), 200u);
+
+    auto called = false;
+    EXPECT_EQ(clientLink->TrySend([&](std::span<std::byte>) -> std::size_t {
+        called = true;
+        return 1;
+    }), SendStatus::WouldBlock);
+    EXPECT_FALSE(called);
+
+    clientLink->Send(fill); // dropped
+    clientLink->SendWhenWritable([](std::span<std::byte> buf) -> std::size_t {
+        std::memcpy(buf.data(), "late", 4);
+        return 4;
+    });
+
+    RunUntil(io, [&] { return serverAcceptor->receivedPackets.size() == 3; });
+    RunUntil(io, [&] { return clientAcceptor->writableEvents == 1; });
+
+    ASSERT_EQ(serverAcceptor->receivedPackets.size(), 3u);
+    EXPECT_EQ(FromBytes(serverAcceptor->receivedPackets.back()), "late");
+    EXPECT_EQ(clientAcceptor->writableEvents, 1u);
+    EXPECT_TRUE(clientLink->Writable());
+    EXPECT_EQ(clientLink->OutstandingBytes(), 0u);
+    EXPECT_EQ(clientLink->GetStats().sendDrops, 1u);
+}
+
+TEST(UdpTransport, PooledReceiveLendsPackets)
+{
+    asio::io_context io;
+
+    // Keeps every packet past the callback
+    struct PacketAcceptor : ILinkAcceptor
+    {
+        LinkHandler OnLink(LinkResult result) override
+        {
+            links.push_back(*result);
+            return {.onPacket = [this](const Packet& packet) { packets.push_back(packet); }};
+        }
+
+        std::vector<std::shared_ptr<ILink>> links;
+        std::vector<Packet> packets;
+    };
+
+    auto serverAcceptor = std::make_shared<PacketAcceptor>();
+    UdpServer server{{.executor = io.get_executor(), .localPort = 0, .pooledReceive = true}};
+    server.Open(serverAcceptor);
+
+    auto clientAcceptor = std::make_shared<TestAcceptor>();
+    UdpClient client{{
+        .executor = io.get_executor(),
+        .remoteHost = "127.0.0.1",
+        .remotePort = server.LocalPort(),
+    }};
+    client.Open(clientAcceptor);
+
+    RunUntil(io, [&] { return clientAcceptor->links.size() == 1; });
+    for (const auto* text : {"first", "second", "third"}) {
+        const auto payload = ToBytes(text);
+        const std::span<const std::byte> parts[] = {payload};
+        clientAcceptor->links[0]->SendV(parts);
+    }
+    RunUntil(io, [&] { return serverAcceptor->packets.size() == 3; });
+
+    // Each packet has its own slab: later receives did not overwrite earlier ones
+    ASSERT_EQ(serverAcceptor->packets.size(), 3u);
+    EXPECT_EQ(FromBytes(serverAcceptor->packets[0].Span()), "first");
+    EXPECT_EQ(FromBytes(serverAcceptor->packets[1].Span()), "second");
+    EXPECT_EQ(FromBytes(serverAcceptor->packets[2].Span()), "third");
+    EXPECT_EQ(server.GetReceivePoolStats().idle, 0u);
+
+    serverAcceptor->packets.clear();
+    EXPECT_EQ(server.GetReceivePoolStats().idle, 3u);
+}
+
+TEST(UdpTransport, BatchedReceiveDispatchesAllPeers)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<TestAcceptor>();
+    UdpServer server{{.executor = io.get_executor(), .localPort = 0, .receiveBatchSize = 8}};
+    server.Open(serverAcceptor);
+
+    // Raw sockets: queue more datagrams than one batch holds before the server runs
+    constexpr auto perSender = 6;
+    const asio::ip::udp::endpoint target{asio::ip::make_address("127.0.0.1"), server.LocalPort()};
+    asio::ip::udp::socket senderA{io, asio::ip::udp::v4()};
+    asio::ip::udp::socket senderB{io, asio::ip::udp::v4()};
+    for (auto i = 0; i < perSender; ++i) {
+        senderA.send_to(asio::buffer(std::string_view{"A"}), target);
+        senderB.send_to(asio::buffer(std::string_view{"B"}), target);
+    }
+
+    RunUntil(io, [&] { return serverAcceptor->receivedPackets.size() == 2 * perSender; });
+    ASSERT_EQ(serverAcceptor->receivedPackets.size(), 2 * perSender);
+    EXPECT_EQ(serverAcceptor->links.size(), 2);
+}
+
+TEST(UdpTransport, BatchedReceiveYieldsBetweenWakeups)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<TestAcceptor>();
+    UdpServer server{{.executor = io.get_executor(), .localPort = 0, .receiveBatchSize = 8}};
+    server.Open(serverAcceptor);
+
+    // Three full batches queued: one wakeup must not drain them all
+    constexpr std::size_t total = 24;
+    const asio::ip::udp::endpoint target{asio::ip::make_address("127.0.0.1"), server.LocalPort()};
+    asio::ip::udp::socket sender{io, asio::ip::udp::v4()};
+    for (std::size_t i = 0; i < total; ++i) {
+        sender.send_to(asio::buffer(std::string_view{"x"}), target);
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (serverAcceptor->receivedPackets.size() < total && std::chrono::steady_clock::now() < deadline) {
+        const auto before = serverAcceptor->receivedPackets.size();
+        io.run_one();
+        EXPECT_LE(serverAcceptor->receivedPackets.size() - before, 8u);
+    }
+    EXPECT_EQ(serverAcceptor->receivedPackets.size(), total);
+}
+
+TEST(UdpTransport, BatchedSendDeliversAllDatagrams)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<TestAcceptor>();
+    UdpServer server{{.executor = io.get_executor(), .localPort = 0, .sendBatchSize = 4}};
+    server.Open(serverAcceptor);
+
+    auto clientAcceptor = std::make_shared<TestAcceptor>();
+    UdpClient client{{
+        .executor = io.get_executor(),
+        .remoteHost = "127.0.0.1",
+        .remotePort = server.LocalPort(),
+    }};
+    client.Open(clientAcceptor);
+
+    RunUntil(io, [&] { return clientAcceptor->links.size() == 1; });
+    auto hello = ToBytes("hello");
+    clientAcceptor->links[0]->Send([&](std::span<std::byte> buf) -> std::size_t {
+        std::memcpy(buf.data(), hello.data(), hello.size());
+        return hello.size();
+    });
+    RunUntil(io, [&] { return serverAcceptor->links.size() == 1; });
+
+    // More sends than one batch, equal sizes plus a shorter tail (GSO-eligible run)
+    std::vector<std::string> messages{"msg-0", "msg-1", "msg-2", "msg-3", "msg-4", "tail"};
+    for (const auto& m : messages) {
+        serverAcceptor->links[0]->Send([&](std::span<std::byte> buf) -> std::size_t {
+            std::memcpy(buf.data(), m.data(), m.size());
+            return m.size();
+        });
+    }
+
+    RunUntil(io, [&] { return clientAcceptor->receivedPackets.size() == messages.size(); });
+    ASSERT_EQ(clientAcceptor->receivedPackets.size(), messages.size());
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        EXPECT_EQ(FromBytes(clientAcceptor->receivedPackets[i]), messages[i]);
+    }
+}
+
+TEST(UdpTransport, SendVGathersHeaderAndBody)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<TestAcceptor>();
+    UdpServer server{{.executor = io.get_executor(), .localPort = 0}};
+    server.Open(serverAcceptor);
+
+    auto clientAcceptor = std::make_shared<TestAcceptor>();
+    UdpClient client{{
+        .executor = io.get_executor(),
+        .remoteHost = "127.0.0.1",
+        .remotePort = server.LocalPort(),
+    }};
+    client.Open(clientAcceptor);
+    RunUntil(io, [&] { return clientAcceptor->links.size() == 1; });
+
+    const auto header = ToBytes("hdr:");
+    const auto body = ToBytes("payload");
+    const std::span<const std::byte> request[] = {header, body};
+    clientAcceptor->links[0]->SendV(request); // connected socket
+    RunUntil(io, [&] { return serverAcceptor->receivedPackets.size() == 1; });
+    ASSERT_EQ(serverAcceptor->receivedPackets.size(), 1);
+    EXPECT_EQ(FromBytes(serverAcceptor->receivedPackets[0]), "hdr:payload");
+
+    const auto empty = std::vector<std::byte>{};
+    const std::span<const std::byte> response[] = {body, empty, header};
+    serverAcceptor->links[0]->SendV(response); // shared socket
+    RunUntil(io, [&] { return clientAcceptor->receivedPackets.size() == 1; });
+    ASSERT_EQ(clientAcceptor->receivedPackets.size(), 1);
+    EXPECT_EQ(FromBytes(clientAcceptor->receivedPackets[0]), "payloadhdr:");
+}
+
+TEST(UdpTransport, FragmentsLargeMessages)
+{
+    asio::io_context io;
+
+    constexpr std::size_t MaxMessage = 64 * 1024;
+    auto serverAcceptor = std::make_shared<TestAcceptor>();
+    UdpServer server{{.executor = io.get_executor(), .localPort = 0, .maxMessageSize = MaxMessage}};
+    server.Open(serverAcceptor);
+
+    auto clientAcceptor = std::make_shared<TestAcceptor>();
+    UdpClient client{{
+        .executor = io.get_executor(),
+        .remoteHost = "127.0.0.1",
+        .remotePort = server.LocalPort(),
+        .maxMessageSize = MaxMessage,
+    }};
+    client.Open(clientAcceptor);
+    RunUntil(io, [&] { return clientAcceptor->links.size() == 1; });
+
+    std::vector<std::byte> snapshot(60000);
+    for (std::size_t i = 0; i < snapshot.size(); ++i) {
+        snapshot[i] = static_cast<std::byte>(i * 7);
+    }
+    const auto small = ToBytes("small");
+
+    // Small messages still take one datagram; the snapshot is split and reassembled
+    clientAcceptor->links[0]->Send([&](std::span<std::byte> buf) -> std::size_t {
+        std::memcpy(buf.data(), small.data(), small.size());
+        return small.size();
+    });
+    clientAcceptor->links[0]->Send([&](std::span<std::byte> buf) -> std::size_t {
+        std::memcpy(buf.data(), snapshot.data(), snapshot.size());
+        return snapshot.size();
+    });
+    RunUntil(io, [&] { return serverAcceptor->receivedPackets.size() == 2; });
+    ASSERT_EQ(serverAcceptor->receivedPackets.size(), 2);
+    EXPECT_EQ(FromBytes(serverAcceptor->receivedPackets[0]), "small");
+    EXPECT_EQ(serverAcceptor->receivedPackets[1], snapshot);
+
+    // And back through SendV on the shared socket
+    const std::span<const std::byte> response[] = {small, snapshot};
+    serverAcceptor->links[0]->SendV(response);
+    RunUntil(io, [&] { return clientAcceptor->receivedPackets.size() == 1; });
+    ASSERT_EQ(clientAcceptor->receivedPackets.size(), 1);
+    ASSERT_EQ(clientAcceptor->receivedPackets[0].size(), small.size() + snapshot.size());
+    EXPECT_TRUE(std::equal(snapshot.begin(), snapshot.end(), clientAcceptor->receivedPackets[0].begin() + 5));
+}
+
+TEST(UdpTransport, CountsTrafficAndMeasuresRtt)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<TestAcceptor>();
+    UdpServer server{{.executor = io.get_executor(), .localPort = 0, .pingInterval = std::chrono::milliseconds(1)}};
+    server.Open(serverAcceptor);
+
+    auto clientAcceptor = std::make_shared<TestAcceptor>();
+    UdpClient client{{
+        .executor = io.get_executor(),
+        .remoteHost = "127.0.0.1",
+        .remotePort = server.LocalPort(),
+        .pingInterval = std::chrono::milliseconds(1),
+    }};
+    client.Open(clientAcceptor);
+    RunUntil(io, [&] { return clientAcceptor->links.size() == 1; });
+    auto& link = *clientAcceptor->links[0];
+
+    // Every send after pingInterval carries a Ping; the server's Pong is the sample
+    const auto message = ToBytes("tick");
+    const std::span<const std::byte> parts[] = {message};
+    for (int i = 0; i < 5; ++i) {
+        link.SendV(parts);
+        RunUntil(io, [&] { return serverAcceptor->receivedPackets.size() == static_cast<std::size_t>(i + 1); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    RunUntil(io, [&] { return link.GetStats().rttSamples >= 3; });
+    RunFor(io, std::chrono::milliseconds(20)); // let the last Pong land
+
+    const auto stats = link.GetStats();
+    EXPECT_GE(stats.rttSamples, 3u);
+    EXPECT_GT(stats.rtt.count(), 0);
+    EXPECT_LT(stats.rtt, std::chrono::milliseconds(100));
+    EXPECT_GE(stats.packetsSent, 5 + stats.rttSamples); // messages + pings
+    EXPECT_EQ(stats.sendDrops, 0u);
+
+    // Pings never reach the user's handler
+    ASSERT_EQ(serverAcceptor->receivedPackets.size(), 5u);
+    EXPECT_EQ(FromBytes(serverAcceptor->receivedPackets[4]), "tick");
+
+    // Every datagram either side sent arrived (loopback): the server's aggregate mirrors the link
+    const auto serverSide = server.GetLinkStats().Collect();
+    EXPECT_EQ(serverSide.links, 1u);
+    EXPECT_EQ(serverSide.total.packetsReceived, stats.packetsSent);
+    EXPECT_EQ(serverSide.total.packetsSent, stats.packetsReceived);
+}
+
+TEST(UdpTransport, IdleLinksAreEvicted)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<EvictionAcceptor>();
+    UdpServer server{{.executor = io.get_executor(), .localPort = 0, .idleTimeout = std::chrono::milliseconds(80)}};
+    server.Open(serverAcceptor);
+
+    std::vector<std::shared_ptr<TestAcceptor>> acceptors;
+    std::vector<std::unique_ptr<UdpClient>> clients;
+    auto active = ConnectClient(io, server.LocalPort(), acceptors, clients);
+    auto idle = ConnectClient(io, server.LocalPort(), acceptors, clients);
+    SendText(*active, "a");
+    SendText(*idle, "b");
+    RunUntil(io, [&] { return serverAcceptor->received == 2; });
+    ASSERT_EQ(serverAcceptor->links.size(), 2);
+
+    // `active` keeps talking, `idle` goes quiet
+    for (int i = 0; i < 20; ++i) {
+        SendText(*active, "ping");
+        RunFor(io, std::chrono::milliseconds(10));
+    }
+
+    EXPECT_EQ(serverAcceptor->disconnected.size(), 1);
+    EXPECT_TRUE(serverAcceptor->disconnected.contains(idle->LocalId()));
+
+    // The evicted peer comes back as a new link
+    SendText(*idle, "back");
+    RunUntil(io, [&] { return serverAcceptor->links.size() == 3; });
+    EXPECT_EQ(serverAcceptor->links.size(), 3);
+}
+
+TEST(UdpTransport, MaxLinksRejectsNewPeers)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<EvictionAcceptor>();
+    UdpServer server{{
+        .executor = io.get_executor(),
+        .localPort = 0,
+        .maxLinks = 1,
+        .eviction = LinkEviction::RejectNew,
+    }};
+    server.Open(serverAcceptor);
+
+    std::vector<std::shared_ptr<TestAcceptor>> acceptors;
+    std::vector<std::unique_ptr<UdpClient>> clients;
+    auto first = ConnectClient(io, server.LocalPort(), acceptors, clients);
+    auto second = ConnectClient(io, server.LocalPort(), acceptors, clients);
+    SendText(*first, "1");
+    RunUntil(io, [&] { return serverAcceptor->received == 1; });
+    SendText(*second, "2");
+    SendText(*first, "3");
+    RunUntil(io, [&] { return serverAcceptor->received == 2; });
+    RunFor(io, std::chrono::milliseconds(20));
+
+    EXPECT_EQ(serverAcceptor->links.size(), 1);
+    EXPECT_EQ(serverAcceptor->received, 2);
+    EXPECT_TRUE(serverAcceptor->disconnected.empty());
+}
+
+TEST(UdpTransport, MaxLinksEvictsIdlestPeer)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<EvictionAcceptor>();
+    UdpServer server{{
+        .executor = io.get_executor(),
+        .localPort = 0,
+        .idleTimeout = std::chrono::milliseconds(320),
+        .maxLinks = 2,
+    }};
+    server.Open(serverAcceptor);
+
+    std::vector<std::shared_ptr<TestAcceptor>> acceptors;
+    std::vector<std::unique_ptr<UdpClient>> clients;
+    auto a = ConnectClient(io, server.LocalPort(), acceptors, clients);
+    auto b = ConnectClient(io, server.LocalPort(), acceptors, clients);
+    auto c = ConnectClient(io, server.LocalPort(), acceptors, clients);
+
+    SendText(*a, "a");
+    SendText(*b, "b");
+    RunUntil(io, [&] { return serverAcceptor->received == 2; });
+
+    // Let a few sweep ticks pass, then refresh `a`: `b` is now the idlest
+    RunFor(io, std::chrono::milliseconds(60));
+    SendText(*a, "a");
+    RunUntil(io, [&] { return serverAcceptor->received == 3; });
+
+    SendText(*c, "c");
+    RunUntil(io, [&] { return serverAcceptor->received == 4; });
+    EXPECT_EQ(serverAcceptor->links.size(), 3);
+    EXPECT_EQ(serverAcceptor->disconnected.size(), 1);
+    EXPECT_TRUE(serverAcceptor->disconnected.contains(b->LocalId()));
+}
+
+TEST(UdpTransport, HandshakeCreatesLinkAfterCookie)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<TestAcceptor>();
+    UdpServer server{{.executor = io.get_executor(), .localPort = 0, .handshake = true}};
+    server.Open(serverAcceptor);
+
+    auto clientAcceptor = std::make_shared<TestAcceptor>();
+    UdpClient client{{
+        .executor = io.get_executor(),
+        .remoteHost = "127.0.0.1",
+        .remotePort = server.LocalPort(),
+        .handshake = true,
+    }};
+    client.Open(clientAcceptor);
+
+    // The server link exists before any data: the handshake created it
+    RunUntil(io, [&] { return clientAcceptor->links.size() == 1 && serverAcceptor->links.size() == 1; });
+    ASSERT_EQ(clientAcceptor->links.size(), 1);
+    ASSERT_EQ(serverAcceptor->links.size(), 1);
+    EXPECT_TRUE(serverAcceptor->receivedPackets.empty());
+
+    SendText(*clientAcceptor->links[0], "after-handshake");
+    RunUntil(io, [&] { return serverAcceptor->receivedPackets.size() == 1; });
+    ASSERT_EQ(serverAcceptor->receivedPackets.size(), 1);
+    EXPECT_EQ(FromBytes(serverAcceptor->receivedPackets[0]), "after-handshake");
+
+    SendText(*serverAcceptor->links[0], "reply");
+    RunUntil(io, [&] { return clientAcceptor->receivedPackets.size() == 1; });
+    ASSERT_EQ(clientAcceptor->receivedPackets.size(), 1);
+    EXPECT_EQ(FromBytes(clientAcceptor->receivedPackets[0]), "reply");
+}
+
+TEST(UdpTransport, HandshakeIgnoresUnverifiedSenders)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<TestAcceptor>();
+    UdpServer server{{.executor = io.get_executor(), .localPort = 0, .handshake = true}};
+    server.Open(serverAcceptor);
+    const asio::ip::udp::endpoint serverEp{asio::ip::make_address("127.0.0.1"), server.LocalPort()};
+
+    asio::ip::udp::socket raw{io, asio::ip::udp::endpoint{asio::ip::udp::v4(), 0}};
+    std::array<std::byte, Handshake::MaxMessageSize> buf{};
+
+    // Junk, then a Response with a made-up cookie: no link, no reply
+    raw.send_to(asio::buffer(ToBytes("junk")), serverEp);
+    const auto forged = Handshake::Write(buf, Handshake::Message::Response, Handshake::Cookie{std::byte{42}});
+    raw.send_to(asio::buffer(buf.data(), forged), serverEp);
+
+    // A Hello gets a Challenge no larger than itself
+    const auto hello = Handshake::Write(buf, Handshake::Message::Hello);
+    raw.send_to(asio::buffer(buf.data(), hello), serverEp);
+
+    std::array<std::byte, 64> reply{};
+    std::size_t replySize = 0;
+    raw.async_receive(asio::buffer(reply), [&](boost::system::error_code, std::size_t n) { replySize = n; });
+    RunUntil(io, [&] { return replySize > 0; });
+    ASSERT_LE(replySize, hello);
+    ASSERT_EQ(Handshake::Classify(std::span{reply}.first(replySize)), Handshake::Message::Challenge);
+    EXPECT_TRUE(serverAcceptor->links.empty());
+
+    // Echoing the cookie creates the link and is answered with Accept
+    const auto response = Handshake::Write(buf, Handshake::Message::Response, Handshake::ReadCookie(reply));
+    raw.send_to(asio::buffer(buf.data(), response), serverEp);
+    replySize = 0;
+    raw.async_receive(asio::buffer(reply), [&](boost::system::error_code, std::size_t n) { replySize = n; });
+    RunUntil(io, [&] { return replySize > 0; });
+    EXPECT_EQ(Handshake::Classify(std::span{reply}.first(replySize)), Handshake::Message::Accept);
+    EXPECT_EQ(serverAcceptor->links.size(), 1);
+    EXPECT_TRUE(serverAcceptor->receivedPackets.empty());
+}
+
+TEST(UdpTransport, HandshakeTimesOutWithoutServer)
+{
+    asio::io_context io;
+
+    // Bound but silent: nobody answers the Hello
+    asio::ip::udp::socket silent{io, asio::ip::udp::endpoint{asio::ip::udp::v4(), 0}};
+
+    auto clientAcceptor = std::make_shared<TestAcceptor>();
+    UdpClient client{{
+        .executor = io.get_executor(),
+        .remoteHost = "127.0.0.1",
+        .remotePort = silent.local_endpoint().port(),
+        .handshake = true,
+        .handshakeRetry = std::chrono::milliseconds(5),
+        .handshakeAttempts = 3,
+    }};
+    client.Open(clientAcceptor);
+
+    RunUntil(io, [&] { return clientAcceptor->lastError == Error::Timeout; });
+    EXPECT_EQ(clientAcceptor->lastError, Error::Timeout);
+    EXPECT_TRUE(clientAcceptor->links.empty());
+}
+
+TEST(UdpTransport, ShardedServerAcceptsOnShardThreads)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<SharedAcceptor>();
+    UdpServer server{{.executor = io.get_executor(), .localPort = 0, .shards = 4}};
+    server.Open(serverAcceptor);
+    ASSERT_NE(server.LocalPort(), 0);
+
+    // Many source ports so the kernel flow hash spreads peers across shards
+    constexpr std::size_t clients = 16;
+    const asio::ip::udp::endpoint target{asio::ip::make_address("127.0.0.1"), server.LocalPort()};
+    std::vector<asio::ip::udp::socket> senders;
+    for (std::size_t i = 0; i < clients; ++i) {
+        auto& sender = senders.emplace_back(io, asio::ip::udp::v4());
+        sender.send_to(asio::buffer(std::string_view{"shard"}), target);
+    }
+
+    PollUntil(io, [&] { return serverAcceptor->Received() == clients; });
+    EXPECT_EQ(serverAcceptor->Received(), clients);
+
+    std::lock_guard lock{serverAcceptor->mutex};
+    EXPECT_EQ(serverAcceptor->links.size(), clients);
+    EXPECT_FALSE(serverAcceptor->threads.contains(std::this_thread::get_id()));
+#if defined(__linux__)
+    EXPECT_EQ(server.ShardCount(), 4);
+#endif
+}
+
+// Destroying a sharded server disconnects its links on their shards; a link the
+// application still holds then ignores calls instead of queueing them on a
+// stopped io_context, where they would keep the link alive forever.
+TEST(UdpTransport, ShardedLinkOutlivesServer)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<SharedAcceptor>();
+    {
+        UdpServer server{{.executor = io.get_executor(), .localPort = 0, .shards = 2}};
+        server.Open(serverAcceptor);
+
+        asio::ip::udp::socket sender{io, asio::ip::udp::v4()};
+        sender.send_to(asio::buffer(std::string_view{"hello"}),
+                       asio::ip::udp::endpoint{asio::ip::make_address("127.0.0.1"), server.LocalPort()});
+        PollUntil(io, [&] { return serverAcceptor->Received() == 1; });
+        ASSERT_EQ(serverAcceptor->Received(), 1u);
+    }
+
+    std::shared_ptr<ILink> link;
+    {
+        std::lock_guard lock{serverAcceptor->mutex};
+        EXPECT_EQ(serverAcceptor->disconnected, 1u);
+        link = std::exchange(serverAcceptor->links, {}).front();
+    }
+    const std::weak_ptr<ILink> watch = link;
+
+    // From this thread, which never was the shard's: all run inline and do nothing
+    SendText(*link, "late");
+    const auto late = ToBytes("late");
+    const std::span<const std::byte> parts[] = {late};
+    link->SendV(parts);
+    link->SendWhenWritable([](std::span<std::byte>) -> std::size_t { return 0; });
+    link->Disconnect();
+    EXPECT_EQ(serverAcceptor->disconnected, 1u);
+
+    link.reset();
+    EXPECT_TRUE(watch.expired());
+}
+
+// The application sends on a shard's link from its own thread while the shard
+// thread echoes on the same link: both go through the shard's pool and batch.
+TEST(UdpTransport, ShardedLinkSendsFromOtherThread)
+{
+    asio::io_context io;
+
+    auto serverAcceptor = std::make_shared<EchoAcceptor>();
+    UdpServer server{{.executor = io.get_executor(), .localPort = 0, .sendBatchSize = 4, .shards = 2}};
+    server.Open(serverAcceptor);
+
+    std::vector<std::shared_ptr<TestAcceptor>> acceptors;
+    std::vector<std::unique_ptr<UdpClient>> clients;
+    auto client = ConnectClient(io, server.LocalPort(), acceptors, clients);
+    auto& clientAcceptor = *acceptors.front();
+
+    SendText(*client, "echo");
+    PollUntil(io, [&] { return clientAcceptor.receivedPackets.size() == 1; });
+    auto serverLink = serverAcceptor->Link();
+    ASSERT_TRUE(serverLink);
+
+    // Paced per round so the client's socket buffer never overflows
+    constexpr std::size_t rounds = 100;
+    for (std::size_t i = 1; i <= rounds; ++i) {
+        SendText(*client, "echo");
+        SendText(*serverLink, "direct"); // this thread is not the shard's
+        const auto direct = ToBytes("gather");
+        const std::span<const std::byte> parts[] = {direct};
+        serverLink->SendV(parts);
+        PollUntil(io, [&] { return clientAcceptor.receivedPackets.size() >= 1 + 3 * i; });
+    }
+
+    ASSERT_EQ(clientAcceptor.receivedPackets.size(), 1 + 3 * rounds);
+    std::size_t echoes = 0;
+    for (const auto& packet : clientAcceptor.receivedPackets) {
+        echoes += FromBytes(packet) == "echo";
+    }
+    EXPECT_EQ(echoes, 1 + rounds);
+
+    // Disconnect from this thread runs on the shard as well
+    serverLink->Disconnect();
+}
@@ -0,0 +1,86 @@
+#include "Udp/UdpDispatchTable.h"
+
+#include <boost/asio/ip/udp.hpp>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+
+namespace asio = boost::asio;
+
+using namespace Rtt::Udp;
+
+TEST(UdpDispatchTable, PackEndpoint)
+{
+    const asio::ip::udp::endpoint v4{asio::ip::make_address("10.0.0.1"), 4000};
+    const auto key = PackEndpoint(v4);
+    ASSERT_TRUE(key.has_value());
+    EXPECT_EQ(*key, (EndpointKey{0x0a000001} << 16) | 4000);
+
+    const asio::ip::udp::endpoint mapped{asio::ip::make_address("::ffff:10.0.0.1"), 4000};
+    EXPECT_EQ(PackEndpoint(mapped), key);
+
+    const asio::ip::udp::endpoint v6{asio::ip::make_address("::1"), 4000};
+    EXPECT_FALSE(PackEndpoint(v6).has_value());
+}
+
+TEST(UdpDispatchTable, InsertFindErase)
+{
+    UdpDispatchTable<int> table;
+    EXPECT_EQ(table.Find(42), nullptr);
+
+    table.Insert(42, 1);
+    table.Insert(43, 2);
+    ASSERT_NE(table.Find(42), nullptr);
+    EXPECT_EQ(*table.Find(42), 1);
+    EXPECT_EQ(*table.Find(42), 1); // served from the last-sender cache
+    EXPECT_EQ(*table.Find(43), 2);
+    EXPECT_EQ(table.Size(), 2);
+
+    table.Insert(42, 3); // replace
+    EXPECT_EQ(*table.Find(42), 3);
+    EXPECT_EQ(table.Size(), 2);
+
+    EXPECT_TRUE(table.Erase(42));
+    EXPECT_FALSE(table.Erase(42));
+    EXPECT_EQ(table.Find(42), nullptr);
+    EXPECT_EQ(*table.Find(43), 2);
+    EXPECT_EQ(table.Size(), 1);
+}
+
+TEST(UdpDispatchTable, MatchesReferenceMapUnderChurn)
+{
+    UdpDispatchTable<std::uint32_t> table{4};
+    std::map<EndpointKey, std::uint32_t> reference;
+
+    std::mt19937_64 rng{12345};
+    std::uniform_int_distribution<EndpointKey> keys{1, 2000}; // small range: many hits and erases
+    for (std::uint32_t i = 0; i < 20000; ++i) {
+        const auto key = keys(rng);
+        switch (rng() % 3) {
+            case 0:
+                table.Insert(key, i);
+                reference[key] = i;
+                break;
+            case 1:
+                EXPECT_EQ(table.Erase(key), reference.erase(key) > 0);
+                break;
+            default: {
+                const auto* found = table.Find(key);
+                const auto it = reference.find(key);
+                ASSERT_EQ(found != nullptr, it != reference.end());
+                if (found) {
+                    EXPECT_EQ(*found, it->second);
+                }
+            }
+        }
+    }
+
+    EXPECT_EQ(table.Size(), reference.size());
+    std::size_t visited = 0;
+    table.ForEach([&](EndpointKey key, std::uint32_t value) {
+        EXPECT_EQ(reference.at(key), value);
+        ++visited;
+    });
+    EXPECT_EQ(visited, reference.size());
+}
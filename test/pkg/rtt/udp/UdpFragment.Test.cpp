@@ -0,0 +1,130 @@
+#include "Udp/UdpFragment.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace Rtt::Udp;
+using namespace std::chrono_literals;
+
+namespace
+{
+    /// Split `message` the way UdpLink does, into `count` fragment datagrams.
+    std::vector<std::vector<std::byte>> MakeFragments(const std::vector<std::byte>& message,
+                                                      std::size_t count, std::uint16_t messageId = 7)
+    {
+        std::vector<std::vector<std::byte>> out;
+        const auto chunk = Fragment::ChunkSize(message.size(), count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto offset = i * chunk;
+            const auto size = std::min(chunk, message.size() - offset);
+            auto& dg = out.emplace_back(Fragment::HeaderSize + size);
+            Fragment::WriteHeader(std::span{dg}.first<Fragment::HeaderSize>(), {
+                .messageId = messageId,
+                .index = static_cast<std::uint8_t>(i),
+                .count = static_cast<std::uint8_t>(count),
+                .totalSize = static_cast<std::uint32_t>(message.size()),
+            });
+            std::copy_n(message.begin() + static_cast<std::ptrdiff_t>(offset), size,
+                        dg.begin() + Fragment::HeaderSize);
+        }
+        return out;
+    }
+
+    std::vector<std::byte> Pattern(std::size_t size)
+    {
+        std::vector<std::byte> data(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<std::byte>(i * 31);
+        }
+        return data;
+    }
+}
+
+TEST(UdpFragment, HeaderRoundTrip)
+{
+    std::byte buf[Fragment::HeaderSize];
+    Fragment::WriteHeader(buf, {.messageId = 0xABCD, .index = 3, .count = 45, .totalSize = 65536});
+    EXPECT_EQ(static_cast<Fragment::Tag>(buf[0]), Fragment::Tag::Fragment);
+
+    const auto h = Fragment::ReadHeader(buf);
+    EXPECT_EQ(h.messageId, 0xABCD);
+    EXPECT_EQ(h.index, 3);
+    EXPECT_EQ(h.count, 45);
+    EXPECT_EQ(h.totalSize, 65536u);
+}
+
+TEST(UdpFragment, ReassemblesOutOfOrderAndIgnoresDuplicates)
+{
+    UdpReassembler reassembler{{.maxMessageSize = 64 * 1024}};
+    const auto message = Pattern(10000);
+    auto fragments = MakeFragments(message, 7);
+    std::ranges::reverse(fragments);
+
+    const auto now = UdpReassembler::Clock::now();
+    for (std::size_t i = 0; i + 1 < fragments.size(); ++i) {
+        EXPECT_FALSE(reassembler.Add(fragments[i], now).has_value());
+        EXPECT_FALSE(reassembler.Add(fragments[i], now).has_value()); // duplicate
+    }
+    EXPECT_EQ(reassembler.BufferedBytes(), message.size());
+
+    const auto complete = reassembler.Add(fragments.back(), now);
+    ASSERT_TRUE(complete.has_value());
+    EXPECT_EQ(*complete, message);
+    EXPECT_EQ(reassembler.BufferedBytes(), 0u);
+}
+
+TEST(UdpFragment, RejectsMalformedFragments)
+{
+    UdpReassembler reassembler{{.maxMessageSize = 4096}};
+    const auto now = UdpReassembler::Clock::now();
+
+    auto tooLarge = MakeFragments(Pattern(5000), 4);
+    EXPECT_FALSE(reassembler.Add(tooLarge[0], now).has_value());
+
+    auto fragments = MakeFragments(Pattern(3000), 3);
+    fragments[1].pop_back(); // chunk shorter than the header implies
+    EXPECT_FALSE(reassembler.Add(fragments[1], now).has_value());
+    EXPECT_EQ(reassembler.BufferedBytes(), 0u);
+}
+
+TEST(UdpFragment, DropsExpiredMessages)
+{
+    UdpReassembler reassembler{{.maxMessageSize = 4096, .reassemblyTimeout = 100ms}};
+    const auto message = Pattern(3000);
+    const auto stale = MakeFragments(message, 3, 1);
+    const auto now = UdpReassembler::Clock::now();
+
+    EXPECT_FALSE(reassembler.Add(stale[0], now).has_value());
+    EXPECT_FALSE(reassembler.Add(stale[1], now).has_value());
+
+    // Another message arriving after the timeout evicts the stale one
+    const auto fresh = MakeFragments(message, 3, 2);
+    EXPECT_FALSE(reassembler.Add(fresh[0], now + 200ms).has_value());
+    EXPECT_EQ(reassembler.DroppedCount(), 1u);
+    EXPECT_FALSE(reassembler.Add(stale[2], now + 200ms).has_value());
+    EXPECT_EQ(reassembler.BufferedBytes(), message.size() * 2); // fresh + restarted stale
+}
+
+TEST(UdpFragment, BufferLimitEvictsOldestMessage)
+{
+    UdpReassembler reassembler{{.maxMessageSize = 4096, .reassemblyBufferSize = 8192}};
+    const auto message = Pattern(4000);
+    const auto now = UdpReassembler::Clock::now();
+
+    const auto first = MakeFragments(message, 3, 1);
+    const auto second = MakeFragments(message, 3, 2);
+    const auto third = MakeFragments(message, 3, 3);
+    EXPECT_FALSE(reassembler.Add(first[0], now).has_value());
+    EXPECT_FALSE(reassembler.Add(second[0], now).has_value());
+    EXPECT_FALSE(reassembler.Add(third[0], now).has_value()); // evicts `first`
+    EXPECT_EQ(reassembler.DroppedCount(), 1u);
+    EXPECT_LE(reassembler.BufferedBytes(), 8192u);
+
+    EXPECT_FALSE(reassembler.Add(second[1], now).has_value());
+    const auto complete = reassembler.Add(second[2], now);
+    ASSERT_TRUE(complete.has_value());
+    EXPECT_EQ(*complete, message);
+}
@@ -0,0 +1,65 @@
+#include "Udp/UdpHandshake.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <gtest/gtest.h>
+
+using namespace Rtt::Udp;
+using namespace std::chrono_literals;
+
+TEST(UdpHandshake, ClassifiesOnlyWellFormedMessages)
+{
+    std::array<std::byte, Handshake::MaxMessageSize> buf{};
+    const auto hello = Handshake::Write(buf, Handshake::Message::Hello);
+    EXPECT_EQ(Handshake::Classify(std::span{buf}.first(hello)), Handshake::Message::Hello);
+    EXPECT_FALSE(Handshake::Classify(std::span{buf}.first(hello - 1)).has_value());
+
+    const Handshake::Cookie cookie{std::byte{1}, std::byte{2}, std::byte{3}};
+    const auto response = Handshake::Write(buf, Handshake::Message::Response, cookie);
+    ASSERT_EQ(Handshake::Classify(std::span{buf}.first(response)), Handshake::Message::Response);
+    EXPECT_EQ(Handshake::ReadCookie(buf), cookie);
+
+    buf[0] = std::byte{'X'};
+    EXPECT_FALSE(Handshake::Classify(std::span{buf}.first(response)).has_value());
+}
+
+TEST(UdpHandshake, HelloIsNotSmallerThanChallenge)
+{
+    // No amplification: the server never answers with more bytes than it received
+    EXPECT_GE(Handshake::SizeOf(Handshake::Message::Hello), Handshake::SizeOf(Handshake::Message::Challenge));
+}
+
+TEST(UdpHandshake, CookieIsBoundToPeerAndExpires)
+{
+    const UdpCookies cookies{UdpCookies::Secret{1, 2}, 10s};
+    const auto now = UdpCookies::Clock::now();
+    const EndpointKey peer = (EndpointKey{0x7f000001} << 16) | 5000;
+
+    const auto cookie = cookies.Make(peer, now);
+    EXPECT_TRUE(cookies.Verify(peer, cookie, now));
+    EXPECT_TRUE(cookies.Verify(peer, cookie, now + 5s));
+    EXPECT_FALSE(cookies.Verify(peer + 1, cookie, now)); // another port
+    EXPECT_FALSE(cookies.Verify(peer, cookie, now + 12s));
+
+    auto forged = cookie;
+    forged.back() ^= std::byte{1};
+    EXPECT_FALSE(cookies.Verify(peer, forged, now));
+
+    const UdpCookies other{UdpCookies::Secret{3, 4}, 10s};
+    EXPECT_FALSE(other.Verify(peer, cookie, now));
+}
+
+// Servers sharing a secret accept each other's cookies, whenever each was created.
+TEST(UdpHandshake, CookieVerifiesAcrossInstancesWithSharedSecret)
+{
+    const EndpointKey peer = (EndpointKey{0x7f000001} << 16) | 5000;
+    const auto now = UdpCookies::Clock::now();
+
+    const UdpCookies first{UdpCookies::Secret{1, 2}, 10s};
+    const auto cookie = first.Make(peer, now);
+
+    const UdpCookies second{UdpCookies::Secret{1, 2}, 10s};
+    EXPECT_TRUE(second.Verify(peer, cookie, now));
+    EXPECT_TRUE(second.Verify(peer, cookie, now + 3s));
+}